@@ -0,0 +1,20 @@
+#ifndef BENCH_CLOCK_H
+#define BENCH_CLOCK_H
+
+#include <time.h>
+
+/*
+ * Clock shared by the benchmarks, which define _POSIX_C_SOURCE (or
+ * _XOPEN_SOURCE) before any include for clock_gettime
+ */
+
+/**
+ * Monotonic time in seconds
+ */
+static inline double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#endif	// !BENCH_CLOCK_H
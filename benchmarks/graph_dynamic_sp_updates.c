@@ -0,0 +1,70 @@
+#define _POSIX_C_SOURCE 199309L
+#include <assert.h>
+#include <graph/graph_dynamic_sp.h>
+#include <prng.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_clock.h"
+
+#define NODE_COUNT 100000
+#define EDGE_COUNT 500000
+#define UPDATE_COUNT 2000
+#define RECOMPUTE_COUNT 20
+
+static void random_update(prng_t* rng, unsigned* a, unsigned* b, BOOL* val) {
+	*a = prng_bounded(rng, NODE_COUNT);
+	*b = prng_bounded(rng, NODE_COUNT);
+	*val = prng_bounded(rng, 2);
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 42);
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (unsigned i = 0; i < EDGE_COUNT; i++) {
+		graph_list_set_edge(g, prng_bounded(&rng, NODE_COUNT),
+							prng_bounded(&rng, NODE_COUNT), TRUE,
+							1 + prng_bounded(&rng, 100), FALSE);
+	}
+	graph_dynamic_sp_t* dsp = create_graph_dynamic_sp(g, 0);
+	assert(dsp != NULL);
+
+	// Incremental repair
+	unsigned a, b;
+	BOOL val;
+	unsigned long long repaired = 0;
+	double start = now();
+	for (unsigned i = 0; i < UPDATE_COUNT; i++) {
+		random_update(&rng, &a, &b, &val);
+		int ret = graph_dynamic_sp_set_edge(dsp, a, b, val,
+											1 + prng_bounded(&rng, 100), FALSE);
+		assert(ret >= 0);
+		repaired += ret;
+	}
+	const double dynamic = (now() - start) / UPDATE_COUNT;
+
+	// Full recompute after each update
+	graph_weight_t* distance = malloc(NODE_COUNT * sizeof(graph_weight_t));
+	int* father = malloc(NODE_COUNT * sizeof(int));
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(NODE_COUNT);
+	start = now();
+	for (unsigned i = 0; i < RECOMPUTE_COUNT; i++) {
+		random_update(&rng, &a, &b, &val);
+		graph_list_set_edge(g, a, b, val, 1 + prng_bounded(&rng, 100), FALSE);
+		graph_list_dijkstra_ws(g, 0, distance, father, ws);
+	}
+	const double full = (now() - start) / RECOMPUTE_COUNT;
+
+	printf("vertices: %u, edges: %u\n", NODE_COUNT, EDGE_COUNT);
+	printf("dynamic update: %.3f us (%.1f vertices repaired on average)\n",
+		   dynamic * 1e6, (double)repaired / UPDATE_COUNT);
+	printf("full recompute: %.3f us\n", full * 1e6);
+	printf("speedup: %.1fx\n", full / dynamic);
+
+	free_graph_sp_workspace(ws);
+	free(distance);
+	free(father);
+	free_graph_dynamic_sp(dsp);
+	free_graph_list(g);
+	return 0;
+}
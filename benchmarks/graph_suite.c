@@ -0,0 +1,230 @@
+#define _XOPEN_SOURCE 600
+#include <assert.h>
+#include <config.h>
+#include <graph/graph_cast.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_list.h>
+#include <graph/graph_mat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "bench_clock.h"
+
+/*
+ * Runs the graph algorithms on random graphs of increasing size for both
+ * representations and prints the results as JSON on the standard output:
+ * wall time percentiles of REPEATS runs, edges processed per second (based on
+ * the median). The peak resident set size is given once for the whole run:
+ * it is the maximum of the process so far, which would attribute the memory
+ * of the previous cases to each case.
+ *
+ * The number of runs can be given as the first argument.
+ */
+
+#define REPEATS 10
+#define AVERAGE_DEGREE 8
+#define MAX_WEIGHT 100
+#define SEED 42
+
+static const unsigned sizes[] = {256, 1024, 2048};
+
+typedef enum graph_kind { GRAPH_GNP, GRAPH_DAG } graph_kind_t;
+
+typedef struct context {
+	graph_list_t* list;
+	graph_mat_t* mat;
+	graph_weight_t* distance;
+	int* father;
+	int* values;
+	unsigned* num;
+	unsigned* denum;
+	int* cycle;
+} context_t;
+
+typedef int (*bench_fn)(context_t* c);
+
+typedef struct bench {
+	const char* algorithm;
+	const char* representation;
+	graph_kind_t kind;
+	bench_fn run;
+} bench_t;
+
+#define BENCH(name, call) \
+	static int name(context_t* c) { return call; }
+
+BENCH(list_bfs, graph_list_bfs(c->list, 0, c->values, c->father))
+BENCH(mat_bfs, graph_mat_bfs(c->mat, 0, c->values, c->father))
+BENCH(list_dfs, graph_list_preorder_dfs(c->list, 0, c->values, c->father))
+BENCH(mat_dfs, graph_mat_preorder_dfs(c->mat, 0, c->values, c->father))
+BENCH(list_dijkstra, graph_list_dijkstra(c->list, 0, c->distance, c->father))
+BENCH(mat_dijkstra, graph_mat_dijkstra(c->mat, 0, c->distance, c->father))
+BENCH(list_bellman, graph_list_bellman(c->list, 0, c->distance, c->father))
+BENCH(mat_bellman, graph_mat_bellman(c->mat, 0, c->distance, c->father))
+BENCH(list_ford, graph_list_ford(c->list, 0, c->distance, c->father))
+BENCH(mat_ford, graph_mat_ford(c->mat, 0, c->distance, c->father))
+BENCH(list_ford_dantzig,
+	  graph_list_ford_dantzig(c->list, 0, c->distance, c->father, c->cycle))
+BENCH(mat_ford_dantzig,
+	  graph_mat_ford_dantzig(c->mat, 0, c->distance, c->father, c->cycle))
+BENCH(list_topological,
+	  graph_list_topological_ordering(c->list, c->num, c->denum))
+BENCH(mat_topological, graph_mat_topological_ordering(c->mat, c->num, c->denum))
+
+static int mat_to_list(context_t* c) {
+	graph_list_t* list = NULL;
+	if (graph_mat_to_graph_list(c->mat, &list) == NULL)
+		return -1;
+	free_graph_list(list);
+	return 0;
+}
+
+static int list_to_mat(context_t* c) {
+	graph_mat_t* mat = graph_list_to_graph_mat(c->list, 1);
+	if (mat == NULL)
+		return -1;
+	free_graph_mat(mat);
+	return 0;
+}
+
+static int mat_to_csr(context_t* c) {
+	graph_csr_t* csr = graph_mat_to_graph_csr(c->mat, 1);
+	if (csr == NULL)
+		return -1;
+	free_graph_csr(csr);
+	return 0;
+}
+
+static const bench_t benches[] = {
+	{"bfs", "list", GRAPH_GNP, list_bfs},
+	{"bfs", "mat", GRAPH_GNP, mat_bfs},
+	{"preorder_dfs", "list", GRAPH_GNP, list_dfs},
+	{"preorder_dfs", "mat", GRAPH_GNP, mat_dfs},
+	{"dijkstra", "list", GRAPH_GNP, list_dijkstra},
+	{"dijkstra", "mat", GRAPH_GNP, mat_dijkstra},
+	{"bellman", "list", GRAPH_DAG, list_bellman},
+	{"bellman", "mat", GRAPH_DAG, mat_bellman},
+	{"ford", "list", GRAPH_GNP, list_ford},
+	{"ford", "mat", GRAPH_GNP, mat_ford},
+	{"ford_dantzig", "list", GRAPH_GNP, list_ford_dantzig},
+	{"ford_dantzig", "mat", GRAPH_GNP, mat_ford_dantzig},
+	{"topological_ordering", "list", GRAPH_DAG, list_topological},
+	{"topological_ordering", "mat", GRAPH_DAG, mat_topological},
+	{"graph_mat_to_graph_list", "mat", GRAPH_GNP, mat_to_list},
+	{"graph_list_to_graph_mat", "list", GRAPH_GNP, list_to_mat},
+	{"graph_mat_to_graph_csr", "mat", GRAPH_GNP, mat_to_csr},
+};
+
+static long peak_rss_kb(void) {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return -1;
+	// ru_maxrss is already in kilobytes on Linux
+	return usage.ru_maxrss;
+}
+
+static int compare_double(const void* a, const void* b) {
+	const double x = *(const double*)a;
+	const double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of a sorted array
+ */
+static double percentile(const double* sorted, unsigned count, unsigned p) {
+	unsigned rank = (p * count + 99) / 100;
+	return sorted[rank ? rank - 1 : 0];
+}
+
+static void print_result(const bench_t* b,
+						 unsigned n,
+						 size_t nb_edges,
+						 double* times,
+						 unsigned repeats,
+						 BOOL first) {
+	qsort(times, repeats, sizeof(double), compare_double);
+	const double median = percentile(times, repeats, 50);
+	printf("%s\n    {\"algorithm\": \"%s\", \"representation\": \"%s\", "
+		   "\"graph\": \"%s\", \"vertices\": %u, \"edges\": %zu,\n",
+		   first ? "" : ",", b->algorithm, b->representation,
+		   b->kind == GRAPH_GNP ? "gnp" : "dag", n, nb_edges);
+	printf("     \"min_s\": %.9f, \"p50_s\": %.9f, \"p90_s\": %.9f, "
+		   "\"p99_s\": %.9f, \"max_s\": %.9f,\n",
+		   times[0], median, percentile(times, repeats, 90),
+		   percentile(times, repeats, 99), times[repeats - 1]);
+	printf("     \"edges_per_s\": %.1f}", median > 0 ? nb_edges / median : 0.0);
+}
+
+int main(int argc, char* argv[]) {
+	unsigned repeats = REPEATS;
+	if (argc > 1 && atoi(argv[1]) > 0)
+		repeats = atoi(argv[1]);
+	double* times = malloc(repeats * sizeof(double));
+	assert(times != NULL);
+
+	printf("{\n  \"version\": \"%d.%d\",\n", STRUCT_VERSION_MAJOR,
+		   STRUCT_VERSION_MINOR);
+#if !defined(DIJKSTRA_HEAP_IMPL)
+	printf("  \"dijkstra_impl\": \"array\",\n");
+#elif defined(DIJKSTRA_DARY_HEAP_ARITY)
+	printf("  \"dijkstra_impl\": \"dary%d\",\n", DIJKSTRA_DARY_HEAP_ARITY);
+#else
+	printf("  \"dijkstra_impl\": \"heap\",\n");
+#endif
+	printf("  \"weight_bytes\": %zu,\n  \"repeats\": %u,\n  \"results\": [",
+		   sizeof(graph_weight_t), repeats);
+
+	BOOL first = TRUE;
+	for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		const unsigned n = sizes[s];
+		const double p = (double)AVERAGE_DEGREE / (n - 1);
+		graph_edge_array_t* edges[2];
+		edges[GRAPH_GNP] = graph_generate_gnp(n, p, MAX_WEIGHT, SEED);
+		edges[GRAPH_DAG] = graph_generate_dag(n, 2 * p, MAX_WEIGHT, SEED);
+		assert(edges[GRAPH_GNP] != NULL && edges[GRAPH_DAG] != NULL);
+
+		context_t c[2];
+		for (unsigned k = 0; k < 2; k++) {
+			c[k].list = graph_edge_array_to_graph_list(edges[k]);
+			c[k].mat = graph_edge_array_to_graph_mat(edges[k]);
+			c[k].distance = malloc(n * sizeof(graph_weight_t));
+			c[k].father = malloc(n * sizeof(int));
+			c[k].values = malloc(n * sizeof(int));
+			c[k].num = malloc(n * sizeof(unsigned));
+			c[k].denum = malloc(n * sizeof(unsigned));
+			c[k].cycle = malloc(n * sizeof(int));
+			assert(c[k].list && c[k].mat && c[k].distance && c[k].father &&
+				   c[k].values && c[k].num && c[k].denum && c[k].cycle);
+		}
+
+		for (unsigned i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+			const bench_t* b = &benches[i];
+			for (unsigned r = 0; r < repeats; r++) {
+				const double start = now();
+				const int ret = b->run(&c[b->kind]);
+				times[r] = now() - start;
+				assert(ret >= 0);
+				(void)ret;
+			}
+			print_result(b, n, edges[b->kind]->nb_edges, times, repeats, first);
+			first = FALSE;
+		}
+
+		for (unsigned k = 0; k < 2; k++) {
+			free_graph_list(c[k].list);
+			free_graph_mat(c[k].mat);
+			free(c[k].distance);
+			free(c[k].father);
+			free(c[k].values);
+			free(c[k].num);
+			free(c[k].denum);
+			free(c[k].cycle);
+			free_graph_edge_array(edges[k]);
+		}
+	}
+
+	printf("\n  ],\n  \"peak_rss_kb\": %ld\n}\n", peak_rss_kb());
+	free(times);
+	return 0;
+}
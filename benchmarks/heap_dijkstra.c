@@ -0,0 +1,199 @@
+#define _POSIX_C_SOURCE 199309L
+#include <assert.h>
+#include <dary_heap.h>
+#include <errors.h>
+#include <graph/graph_csr.h>
+#include <graph/graph_workspace.h>
+#include <heap_view.h>
+#include <pairing_heap.h>
+#include <prng.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_clock.h"
+
+#define NODE_COUNT 200000
+#define DEGREE 8
+#define SOURCE_COUNT 10
+
+static graph_csr_t* random_graph(prng_t* rng) {
+	graph_csr_t* g =
+		create_graph_csr(NODE_COUNT, (size_t)NODE_COUNT * DEGREE, TRUE);
+	assert(g != NULL);
+	for (unsigned v = 0; v <= NODE_COUNT; v++)
+		g->offset[v] = (size_t)v * DEGREE;
+	for (size_t i = 0; i < g->nb_edges; i++) {
+		g->to[i] = prng_bounded(rng, NODE_COUNT);
+		g->weights[i] = 1 + prng_bounded(rng, 1000);
+	}
+	return g;
+}
+
+static void dijkstra_heap_view_generic(const graph_csr_t* g,
+									   unsigned r,
+									   graph_weight_t* distance,
+									   graph_sp_workspace_t* ws) {
+	for (unsigned v = 0; v < g->nb_vert; v++)
+		distance[v] = GRAPH_WEIGHT_INF;
+	distance[r] = 0;
+	graph_sp_workspace_reset(ws);
+	heap_view_t* heap = graph_sp_workspace_heap(ws, g->nb_vert, r, distance);
+	int v;
+	while ((v = heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (distance[v] == GRAPH_WEIGHT_INF)
+			break;
+		graph_sp_workspace_set_mark(ws, v, TRUE);
+		for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+			const unsigned to = g->to[i];
+			if (graph_sp_workspace_get_mark(ws, to))
+				continue;
+			graph_weight_t d = distance[v] + g->weights[i];
+			if (d < distance[to])
+				heap_update_up(heap, to, &d);
+		}
+	}
+}
+
+static void dijkstra_heap_view(const graph_csr_t* g,
+							   unsigned r,
+							   graph_weight_t* distance,
+							   graph_sp_workspace_t* ws) {
+	for (unsigned v = 0; v < g->nb_vert; v++)
+		distance[v] = GRAPH_WEIGHT_INF;
+	distance[r] = 0;
+	graph_sp_workspace_reset(ws);
+	heap_view_t* heap = graph_sp_workspace_heap(ws, g->nb_vert, r, distance);
+	int v;
+	while ((v = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (distance[v] == GRAPH_WEIGHT_INF)
+			break;
+		graph_sp_workspace_set_mark(ws, v, TRUE);
+		for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+			const unsigned to = g->to[i];
+			if (graph_sp_workspace_get_mark(ws, to))
+				continue;
+			graph_weight_t d = distance[v] + g->weights[i];
+			if (d < distance[to])
+				weight_heap_update_up(heap, to, d);
+		}
+	}
+}
+
+static void dijkstra_dary_heap(const graph_csr_t* g,
+							   unsigned r,
+							   graph_weight_t* distance,
+							   dary_heap_t* heap) {
+	for (unsigned v = 0; v < g->nb_vert; v++)
+		distance[v] = GRAPH_WEIGHT_INF;
+	distance[r] = 0;
+	dary_heap_clear(heap);
+	dary_heap_decrease_key(heap, r, 0);
+	graph_weight_t dv;
+	int v;
+	while ((v = dary_heap_pop(heap, &dv)) != -ERROR_IS_EMPTY) {
+		for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+			const unsigned to = g->to[i];
+			const graph_weight_t d = dv + g->weights[i];
+			if (d < distance[to]) {
+				distance[to] = d;
+				dary_heap_decrease_key(heap, to, d);
+			}
+		}
+	}
+}
+
+static void dijkstra_pairing_heap(const graph_csr_t* g,
+								  unsigned r,
+								  graph_weight_t* distance,
+								  pairing_node_t** node,
+								  pairing_heap_t* heap) {
+	for (unsigned v = 0; v < g->nb_vert; v++) {
+		distance[v] = GRAPH_WEIGHT_INF;
+		node[v] = NULL;
+	}
+	distance[r] = 0;
+	node[r] = pairing_heap_insert(heap, 0, r);
+	graph_weight_t dv;
+	int v;
+	while ((v = pairing_heap_pop(heap, &dv)) != -ERROR_IS_EMPTY) {
+		for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+			const unsigned to = g->to[i];
+			const graph_weight_t d = dv + g->weights[i];
+			if (d >= distance[to])
+				continue;
+			// A vertex whose distance is not infinite is popped or in the heap
+			if (distance[to] == GRAPH_WEIGHT_INF)
+				node[to] = pairing_heap_insert(heap, d, to);
+			else
+				pairing_heap_decrease_key(heap, node[to], d);
+			distance[to] = d;
+		}
+	}
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 42);
+	graph_csr_t* g = random_graph(&rng);
+	unsigned sources[SOURCE_COUNT];
+	for (unsigned s = 0; s < SOURCE_COUNT; s++)
+		sources[s] = prng_bounded(&rng, NODE_COUNT);
+	graph_weight_t* expected = malloc(NODE_COUNT * sizeof(graph_weight_t));
+	graph_weight_t* distance = malloc(NODE_COUNT * sizeof(graph_weight_t));
+	assert(expected != NULL && distance != NULL);
+
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(NODE_COUNT);
+	assert(ws != NULL);
+	double start = now();
+	for (unsigned s = 0; s < SOURCE_COUNT; s++)
+		dijkstra_heap_view_generic(g, sources[s], expected, ws);
+	const double generic = (now() - start) / SOURCE_COUNT;
+	start = now();
+	for (unsigned s = 0; s < SOURCE_COUNT; s++)
+		dijkstra_heap_view(g, sources[s], distance, ws);
+	const double binary = (now() - start) / SOURCE_COUNT;
+	assert(memcmp(expected, distance, NODE_COUNT * sizeof(graph_weight_t)) ==
+		   0);
+	free_graph_sp_workspace(ws);
+
+	printf("vertices: %u, edges: %zu\n", NODE_COUNT, g->nb_edges);
+	printf("heap_view_t (compare_fn_t): %.3f ms\n", generic * 1e3);
+	printf("heap_view_t (weight_heap): %.3f ms (%.2fx)\n", binary * 1e3,
+		   generic / binary);
+	const unsigned arities[] = {2, 4, 8};
+	for (unsigned a = 0; a < sizeof(arities) / sizeof(arities[0]); a++) {
+		dary_heap_t* heap = create_dary_heap(NODE_COUNT, arities[a]);
+		assert(heap != NULL);
+		start = now();
+		for (unsigned s = 0; s < SOURCE_COUNT; s++)
+			dijkstra_dary_heap(g, sources[s], distance, heap);
+		const double dary = (now() - start) / SOURCE_COUNT;
+		// Both searches end on the last source
+		assert(memcmp(expected, distance,
+					  NODE_COUNT * sizeof(graph_weight_t)) == 0);
+		printf("dary_heap_t (d = %u): %.3f ms (%.2fx)\n", arities[a],
+			   dary * 1e3, generic / dary);
+		free_dary_heap(heap);
+	}
+
+	pairing_pool_t* pool = create_pairing_pool(4096);
+	pairing_node_t** node = malloc(NODE_COUNT * sizeof(pairing_node_t*));
+	assert(pool != NULL && node != NULL);
+	pairing_heap_t pairing;
+	pairing_heap_init(&pairing, pool);
+	start = now();
+	for (unsigned s = 0; s < SOURCE_COUNT; s++)
+		dijkstra_pairing_heap(g, sources[s], distance, node, &pairing);
+	const double pairing_time = (now() - start) / SOURCE_COUNT;
+	assert(memcmp(expected, distance, NODE_COUNT * sizeof(graph_weight_t)) ==
+		   0);
+	printf("pairing_heap_t: %.3f ms (%.2fx)\n", pairing_time * 1e3,
+		   generic / pairing_time);
+	free(node);
+	free_pairing_pool(pool);
+
+	free(expected);
+	free(distance);
+	free_graph_csr(g);
+	return 0;
+}
@@ -0,0 +1,114 @@
+#define _POSIX_C_SOURCE 199309L
+#include <assert.h>
+#include <errors.h>
+#include <multiqueue.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_clock.h"
+
+#define C 2
+#define PREFILL 1000000
+#define OPERATION_COUNT 2000000
+#define RANK_COUNT 100000
+
+typedef struct worker {
+	multiqueue_t* mq;
+	unsigned id;
+	unsigned operations;
+} worker_t;
+
+/**
+ * Pops a key and pushes a greater one, as a parallel shortest path settling
+ * a vertex and relaxing an edge
+ */
+static void* worker(void* arg) {
+	worker_t* w = arg;
+	prng_t rng;
+	prng_seed(&rng, w->id + 1);
+	graph_weight_t key;
+	for (unsigned i = 0; i < w->operations; i++) {
+		const int v = multiqueue_pop(w->mq, &rng, &key);
+		if (v < 0)
+			continue;
+		if (multiqueue_push(w->mq, &rng, key + 1 + prng_bounded(&rng, 1000),
+							v) < 0)
+			abort();
+	}
+	return NULL;
+}
+
+static double throughput(unsigned nb_threads) {
+	multiqueue_t* mq = create_multiqueue(nb_threads, C);
+	assert(mq != NULL);
+	prng_t rng;
+	prng_seed(&rng, 0);
+	for (unsigned i = 0; i < PREFILL; i++)
+		multiqueue_push(mq, &rng, prng_bounded(&rng, 1000000), i);
+	pthread_t threads[64];
+	worker_t workers[64];
+	const double start = now();
+	for (unsigned t = 0; t < nb_threads; t++) {
+		workers[t] = (worker_t){mq, t, OPERATION_COUNT / nb_threads};
+		pthread_create(&threads[t], NULL, worker, &workers[t]);
+	}
+	for (unsigned t = 0; t < nb_threads; t++)
+		pthread_join(threads[t], NULL);
+	const double elapsed = now() - start;
+	free_multiqueue(mq);
+	// A pop and a push per operation
+	return 2.0 * OPERATION_COUNT / elapsed;
+}
+
+/**
+ * Mean rank of the keys popped among the keys in the MultiQueue, measured
+ * sequentially on the distinct keys 0 to RANK_COUNT - 1 with a Fenwick tree
+ * counting the keys left
+ */
+static double rank_error(unsigned nb_threads) {
+	multiqueue_t* mq = create_multiqueue(nb_threads, C);
+	unsigned* fenwick = calloc(RANK_COUNT + 1, sizeof(unsigned));
+	unsigned* order = malloc(RANK_COUNT * sizeof(unsigned));
+	assert(mq != NULL && fenwick != NULL && order != NULL);
+	prng_t rng;
+	prng_seed(&rng, 1);
+	for (unsigned i = 0; i < RANK_COUNT; i++)
+		order[i] = i;
+	for (unsigned i = RANK_COUNT - 1; i > 0; i--) {
+		const unsigned j = prng_bounded(&rng, i + 1);
+		const unsigned tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+	for (unsigned i = 0; i < RANK_COUNT; i++) {
+		multiqueue_push(mq, &rng, order[i], order[i]);
+		for (unsigned k = order[i] + 1; k <= RANK_COUNT; k += k & -k)
+			fenwick[k]++;
+	}
+	double total = 0;
+	int v;
+	while ((v = multiqueue_pop(mq, &rng, NULL)) >= 0) {
+		// Number of keys lower than v still in the MultiQueue
+		unsigned rank = 0;
+		for (unsigned k = v; k > 0; k -= k & -k)
+			rank += fenwick[k];
+		total += rank;
+		for (unsigned k = v + 1; k <= RANK_COUNT; k += k & -k)
+			fenwick[k]--;
+	}
+	free(order);
+	free(fenwick);
+	free_multiqueue(mq);
+	return total / RANK_COUNT;
+}
+
+int main(void) {
+	printf("heaps per thread: %u, operations: %u\n", C, OPERATION_COUNT);
+	const double base = throughput(1);
+	for (unsigned t = 1; t <= 16; t *= 2) {
+		const double ops = t == 1 ? base : throughput(t);
+		printf("threads: %2u, %.2f Mops/s (%.2fx), mean rank error: %.1f\n", t,
+			   ops * 1e-6, ops / base, rank_error(t));
+	}
+	return 0;
+}
@@ -0,0 +1,111 @@
+#define _POSIX_C_SOURCE 199309L
+#include <assert.h>
+#include <compare.h>
+#include <errors.h>
+#include <graph/graph_workspace.h>
+#include <heap_view.h>
+#include <pairing_heap.h>
+#include <prng.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_clock.h"
+
+#define SHARD_COUNT 64
+#define SHARD_SIZE 20000
+#define POP_COUNT (SHARD_COUNT * SHARD_SIZE / 10)
+#define ROUND_COUNT 5
+
+DEFINE_COMPARE_MIN_SCALAR(graph_weight_t)
+
+/**
+ * Each round, the shards fill their own queue, then the queues are merged and
+ * the POP_COUNT lowest keys are taken from the merged queue
+ */
+int main(void) {
+	const unsigned total = SHARD_COUNT * SHARD_SIZE;
+	graph_weight_t* keys = malloc(total * sizeof(graph_weight_t));
+	graph_weight_t* merged = malloc(total * sizeof(graph_weight_t));
+	assert(keys != NULL && merged != NULL);
+	prng_t rng;
+	prng_seed(&rng, 23);
+	for (unsigned i = 0; i < total; i++)
+		keys[i] = prng_bounded(&rng, 1000000);
+
+	// heap_view_t: each shard is a heap over its slice of keys, the merge
+	// copies the slices into one array and heapifies it
+	double fill = 0, merge = 0, pop = 0;
+	graph_weight_t checksum = 0;
+	for (unsigned round = 0; round < ROUND_COUNT; round++) {
+		double start = now();
+		heap_view_t* shards[SHARD_COUNT];
+		for (unsigned s = 0; s < SHARD_COUNT; s++) {
+			shards[s] = create_heap_heapify(
+				SHARD_SIZE, SHARD_SIZE, sizeof(graph_weight_t),
+				keys + s * SHARD_SIZE, compare_min_graph_weight_t);
+			assert(shards[s] != NULL);
+		}
+		fill += now() - start;
+		start = now();
+		for (unsigned s = 0; s < SHARD_COUNT; s++) {
+			memcpy(merged + s * SHARD_SIZE, keys + s * SHARD_SIZE,
+				   SHARD_SIZE * sizeof(graph_weight_t));
+			free_heap(shards[s]);
+		}
+		heap_view_t* heap =
+			create_heap_heapify(total, total, sizeof(graph_weight_t), merged,
+								compare_min_graph_weight_t);
+		assert(heap != NULL);
+		merge += now() - start;
+		start = now();
+		for (unsigned i = 0; i < POP_COUNT; i++)
+			checksum += merged[weight_heap_get_root(heap)];
+		pop += now() - start;
+		free_heap(heap);
+	}
+	printf("shards: %u x %u keys, %u pops\n", SHARD_COUNT, SHARD_SIZE,
+		   POP_COUNT);
+	printf("heap_view_t: fill %.3f ms, merge %.3f ms, pop %.3f ms\n",
+		   fill / ROUND_COUNT * 1e3, merge / ROUND_COUNT * 1e3,
+		   pop / ROUND_COUNT * 1e3);
+
+	// pairing_heap_t: the merge links the roots of the shards
+	pairing_pool_t* pool = create_pairing_pool(SHARD_SIZE);
+	assert(pool != NULL);
+	fill = merge = pop = 0;
+	graph_weight_t pairing_checksum = 0;
+	for (unsigned round = 0; round < ROUND_COUNT; round++) {
+		double start = now();
+		pairing_heap_t shards[SHARD_COUNT];
+		for (unsigned s = 0; s < SHARD_COUNT; s++) {
+			pairing_heap_init(&shards[s], pool);
+			for (unsigned i = 0; i < SHARD_SIZE; i++) {
+				if (pairing_heap_insert(&shards[s], keys[s * SHARD_SIZE + i],
+										i) == NULL)
+					abort();
+			}
+		}
+		fill += now() - start;
+		start = now();
+		for (unsigned s = 1; s < SHARD_COUNT; s++)
+			pairing_heap_meld(&shards[0], &shards[s]);
+		merge += now() - start;
+		start = now();
+		graph_weight_t k;
+		for (unsigned i = 0; i < POP_COUNT; i++) {
+			pairing_heap_pop(&shards[0], &k);
+			pairing_checksum += k;
+		}
+		pop += now() - start;
+		pairing_heap_clear(&shards[0]);
+	}
+	assert(checksum == pairing_checksum);
+	printf("pairing_heap_t: fill %.3f ms, merge %.3f ms, pop %.3f ms\n",
+		   fill / ROUND_COUNT * 1e3, merge / ROUND_COUNT * 1e3,
+		   pop / ROUND_COUNT * 1e3);
+
+	free_pairing_pool(pool);
+	free(keys);
+	free(merged);
+	return 0;
+}
@@ -0,0 +1,106 @@
+#define _POSIX_C_SOURCE 199309L
+#include <assert.h>
+#include <errors.h>
+#include <heap_view.h>
+#include <prng.h>
+#include <priority_queue.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_clock.h"
+
+#define STEP_COUNT 2000000
+#define SEED 17
+
+typedef struct event {
+	unsigned long long time;
+	unsigned payload;
+} event_t;
+
+static int compare_event(void* a, void* b) {
+	const unsigned long long x = ((event_t*)a)->time;
+	const unsigned long long y = ((event_t*)b)->time;
+	return (x < y) - (x > y);
+}
+
+/**
+ * Discrete event simulation: each event handled schedules 0 to 2 new events,
+ * so that the number of pending events is not known in advance
+ */
+static unsigned long long simulate_priority_queue(unsigned* peak) {
+	prng_t rng;
+	prng_seed(&rng, SEED);
+	priority_queue_t* pq =
+		create_priority_queue(sizeof(event_t), compare_event);
+	assert(pq != NULL);
+	event_t e = {0, 0};
+	priority_queue_push(pq, &e);
+	unsigned long long checksum = 0;
+	for (unsigned i = 0; i < STEP_COUNT && !priority_queue_empty(pq); i++) {
+		const event_t current = *(event_t*)priority_queue_peek(pq);
+		checksum += current.time;
+		const unsigned children = prng_bounded(&rng, 3) + (pq->size < 64);
+		if (children == 0) {
+			priority_queue_pop(pq, NULL);
+			continue;
+		}
+		e = (event_t){current.time + 1 + prng_bounded(&rng, 1000), i};
+		priority_queue_replace_top(pq, &e, NULL);
+		for (unsigned c = 1; c < children; c++) {
+			e = (event_t){current.time + 1 + prng_bounded(&rng, 1000), i};
+			if (priority_queue_push(pq, &e) < 0)
+				abort();
+		}
+		if (pq->size > *peak)
+			*peak = pq->size;
+	}
+	free_priority_queue(pq);
+	return checksum;
+}
+
+/**
+ * Same simulation on a heap_view_t, which has to be allocated for the worst
+ * case of STEP_COUNT + 1 pending events
+ */
+static unsigned long long simulate_heap_view(void) {
+	prng_t rng;
+	prng_seed(&rng, SEED);
+	event_t* data = malloc((STEP_COUNT + 1) * sizeof(event_t));
+	heap_view_t* heap =
+		create_heap(STEP_COUNT + 1, sizeof(event_t), data, compare_event);
+	assert(data != NULL && heap != NULL);
+	event_t e = {0, 0};
+	insert_heap(heap, &e);
+	unsigned long long checksum = 0;
+	int root;
+	for (unsigned i = 0;
+		 i < STEP_COUNT && (root = heap_get_root(heap)) != -ERROR_IS_EMPTY;
+		 i++) {
+		const event_t current = data[root];
+		checksum += current.time;
+		const unsigned children = prng_bounded(&rng, 3) + (heap->size < 63);
+		for (unsigned c = 0; c < children; c++) {
+			e = (event_t){current.time + 1 + prng_bounded(&rng, 1000), i};
+			insert_heap(heap, &e);
+		}
+	}
+	free_heap(heap);
+	free(data);
+	return checksum;
+}
+
+int main(void) {
+	unsigned peak = 0;
+	double start = now();
+	const unsigned long long pq_checksum = simulate_priority_queue(&peak);
+	const double pq_time = now() - start;
+	start = now();
+	const unsigned long long view_checksum = simulate_heap_view();
+	const double view_time = now() - start;
+	assert(pq_checksum == view_checksum);
+
+	printf("events: %u, peak pending: %u\n", STEP_COUNT, peak);
+	printf("priority_queue_t: %.3f ms\n", pq_time * 1e3);
+	printf("heap_view_t: %.3f ms\n", view_time * 1e3);
+	printf("speedup: %.2fx\n", view_time / pq_time);
+	return 0;
+}
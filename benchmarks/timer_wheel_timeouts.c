@@ -0,0 +1,162 @@
+#define _POSIX_C_SOURCE 199309L
+#include <assert.h>
+#include <errors.h>
+#include <heap_view.h>
+#include <prng.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <timer_wheel.h>
+#include "bench_clock.h"
+
+#define CONNECTION_COUNT 1000000
+#define CONNECTIONS_PER_TICK 32
+#define MAX_TIMEOUT 30000
+#define TICK_COUNT (CONNECTION_COUNT / CONNECTIONS_PER_TICK + MAX_TIMEOUT + 1)
+#define NO_CANCEL UINT32_MAX
+
+DEFINE_COMPARE_MIN_SCALAR(uint64_t)
+
+/**
+ * Connection c opens at tick c / CONNECTIONS_PER_TICK with a timeout and half
+ * of the connections are closed before their timeout, which cancels the timer
+ */
+typedef struct workload {
+	uint32_t* timeout;
+	uint32_t* cancel_offset;
+	/**< Connections cancelled at tick t: cancelled[cancel_offset[t]] to
+	 * cancelled[cancel_offset[t + 1] - 1] */
+	uint32_t* cancelled;
+} workload_t;
+
+typedef struct result {
+	unsigned long long expired;
+	unsigned long long checksum;
+} result_t;
+
+static void create_workload(workload_t* w) {
+	prng_t rng;
+	prng_seed(&rng, 23);
+	uint32_t* cancel_at = malloc(CONNECTION_COUNT * sizeof(uint32_t));
+	w->timeout = malloc(CONNECTION_COUNT * sizeof(uint32_t));
+	w->cancel_offset = calloc(TICK_COUNT + 1, sizeof(uint32_t));
+	w->cancelled = malloc(CONNECTION_COUNT * sizeof(uint32_t));
+	assert(cancel_at != NULL && w->timeout != NULL &&
+		   w->cancel_offset != NULL && w->cancelled != NULL);
+	for (uint32_t c = 0; c < CONNECTION_COUNT; c++) {
+		w->timeout[c] = 1 + prng_bounded(&rng, MAX_TIMEOUT);
+		cancel_at[c] = NO_CANCEL;
+		if (prng_bounded(&rng, 2) == 0) {
+			// Closed before the timeout, possibly at the opening tick
+			cancel_at[c] = c / CONNECTIONS_PER_TICK +
+						   prng_bounded(&rng, w->timeout[c]);
+			w->cancel_offset[cancel_at[c] + 1]++;
+		}
+	}
+	for (unsigned t = 0; t < TICK_COUNT; t++)
+		w->cancel_offset[t + 1] += w->cancel_offset[t];
+	// cancel_offset[t] is used as the insertion cursor then shifted back
+	for (uint32_t c = 0; c < CONNECTION_COUNT; c++) {
+		if (cancel_at[c] != NO_CANCEL)
+			w->cancelled[w->cancel_offset[cancel_at[c]]++] = c;
+	}
+	for (unsigned t = TICK_COUNT; t > 0; t--)
+		w->cancel_offset[t] = w->cancel_offset[t - 1];
+	w->cancel_offset[0] = 0;
+	free(cancel_at);
+}
+
+static void expire(const timer_wheel_expired_t* timers,
+				   unsigned count,
+				   void* ctx) {
+	result_t* result = ctx;
+	result->expired += count;
+	for (unsigned i = 0; i < count; i++)
+		result->checksum += (uintptr_t)timers[i].data;
+}
+
+static result_t run_timer_wheel(const workload_t* w) {
+	result_t result = {0, 0};
+	timer_wheel_t* wheel = create_timer_wheel(CONNECTION_COUNT, 0);
+	unsigned* id = malloc(CONNECTION_COUNT * sizeof(unsigned));
+	assert(wheel != NULL && id != NULL);
+	uint32_t c = 0;
+	for (unsigned t = 0; t < TICK_COUNT; t++) {
+		// Timers due at t expire before the connections of t open
+		timer_wheel_advance(wheel, t, expire, &result);
+		for (unsigned i = 0; i < CONNECTIONS_PER_TICK && c < CONNECTION_COUNT;
+			 i++, c++) {
+			const int r = timer_wheel_schedule(wheel, t + w->timeout[c],
+											   (void*)(uintptr_t)c);
+			if (r < 0)
+				abort();
+			id[c] = r;
+		}
+		for (uint32_t i = w->cancel_offset[t]; i < w->cancel_offset[t + 1];
+			 i++)
+			timer_wheel_cancel(wheel, id[w->cancelled[i]]);
+	}
+	free(id);
+	free_timer_wheel(wheel);
+	return result;
+}
+
+static result_t run_heap_view(const workload_t* w) {
+	result_t result = {0, 0};
+	uint64_t* expiry = malloc(CONNECTION_COUNT * sizeof(uint64_t));
+	uint32_t* connection = malloc(CONNECTION_COUNT * sizeof(uint32_t));
+	unsigned* id = malloc(CONNECTION_COUNT * sizeof(unsigned));
+	heap_view_t* heap = create_heap(CONNECTION_COUNT, sizeof(uint64_t),
+									expiry, compare_min_uint64_t);
+	assert(expiry != NULL && connection != NULL && id != NULL &&
+		   heap != NULL);
+	uint32_t c = 0;
+	for (unsigned t = 0; t < TICK_COUNT; t++) {
+		int root;
+		while ((root = heap_peek(heap)) >= 0 && expiry[root] <= t) {
+			heap_get_root(heap);
+			result.expired++;
+			result.checksum += connection[root];
+		}
+		for (unsigned i = 0; i < CONNECTIONS_PER_TICK && c < CONNECTION_COUNT;
+			 i++, c++) {
+			// insert_heap() uses the first index out of the heap
+			const unsigned idx = heap->pos_to_idx[heap->size];
+			uint64_t e = t + w->timeout[c];
+			if (insert_heap(heap, &e) < 0)
+				abort();
+			connection[idx] = c;
+			id[c] = idx;
+		}
+		for (uint32_t i = w->cancel_offset[t]; i < w->cancel_offset[t + 1];
+			 i++)
+			heap_remove(heap, id[w->cancelled[i]]);
+	}
+	free_heap(heap);
+	free(expiry);
+	free(connection);
+	free(id);
+	return result;
+}
+
+int main(void) {
+	workload_t w;
+	create_workload(&w);
+	double start = now();
+	const result_t wheel = run_timer_wheel(&w);
+	const double wheel_time = now() - start;
+	start = now();
+	const result_t heap = run_heap_view(&w);
+	const double heap_time = now() - start;
+	assert(wheel.expired == heap.expired && wheel.checksum == heap.checksum);
+
+	printf("connections: %u, timeouts: 1 to %u ticks, expired: %llu\n",
+		   CONNECTION_COUNT, MAX_TIMEOUT, wheel.expired);
+	printf("timer_wheel_t: %.3f ms\n", wheel_time * 1e3);
+	printf("heap_view_t: %.3f ms\n", heap_time * 1e3);
+	printf("speedup: %.2fx\n", heap_time / wheel_time);
+	free(w.timeout);
+	free(w.cancel_offset);
+	free(w.cancelled);
+	return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef STRUCT_DARY_HEAP_H
+#define STRUCT_DARY_HEAP_H
+
+#include "structures.h"
+#include "weight_type.h"
+
+/**
+ * @file dary_heap.h
+ * @brief Indexed d-ary heaps of graph_weight_t keys
+ * @ingroup dary_heap
+ *
+ * Defines a min-heap of indexes with decrease-key, laid out for the cache
+ */
+
+/**
+ * @defgroup dary_heap d-ary heaps
+ *
+ * Each entry of the heap array holds the key of an index next to the index,
+ * so that the comparisons read the heap array only, without going through
+ * the data array nor an indirect comparison function. The d children of a
+ * node are contiguous and the array is aligned so that the children of a node
+ * start a cache line: with 16 bytes entries, the 4 children of a 4-ary heap
+ * fill exactly one line. idx_to_pos still gives the position of each index
+ * for decrease-key.
+ *
+ * A d-ary heap is \f$\log_2{d}\f$ times shallower than a binary heap: a
+ * decrease-key costs less comparisons, a removal of the root d times more
+ * comparisons on contiguous memory.
+ * @{
+ */
+
+/** Position of an index which is not in the heap */
+#define DARY_HEAP_ABSENT ((unsigned)-1)
+
+/**
+ * @typedef dary_heap_entry_t
+ * @brief Typedef for the dary_heap_entry structure
+ */
+typedef struct dary_heap_entry dary_heap_entry_t;
+
+/**
+ * @struct dary_heap_entry
+ * @brief An index with its key
+ */
+struct dary_heap_entry {
+	graph_weight_t key; /**< Key of the index */
+	unsigned idx;		/**< Index */
+};
+
+/**
+ * @typedef dary_heap_t
+ * @brief Typedef for the dary_heap structure
+ */
+typedef struct dary_heap dary_heap_t;
+
+/**
+ * @struct dary_heap
+ * @brief A d-ary min-heap of indexes
+ */
+struct dary_heap {
+	dary_heap_entry_t* entries;
+	/**< Heap array, the children of the position p are at d * p + 1 to
+	 * d * p + d */
+	void* memory;
+	/**< Allocated memory of #entries before alignment */
+	unsigned* idx_to_pos;
+	/**< Position of each index in #entries or DARY_HEAP_ABSENT */
+	unsigned size;
+	/**< Number of entries */
+	unsigned capacity;
+	/**< Number of indexes (from 0 to capacity - 1) */
+	unsigned log_arity;
+	/**< Base 2 logarithm of d */
+};
+
+/**
+ * @brief Creates an empty d-ary heap
+ *
+ * __Every heap created with this function should be freed using
+ * free_dary_heap__
+ *
+ * @param capacity number of indexes which can be stored in the heap
+ * @param arity d, a power of 2 between 2 and 16
+ * @return a pointer to the heap or NULL if the function failed
+ */
+dary_heap_t* create_dary_heap(unsigned capacity, unsigned arity);
+
+/**
+ * @brief Frees the heap
+ * @param heap pointer to the heap
+ */
+void free_dary_heap(dary_heap_t* heap);
+
+/**
+ * @brief Removes every entry of the heap
+ *
+ * _Complexity:_ \f$O(size)\f$
+ *
+ * @param heap pointer to the heap
+ */
+void dary_heap_clear(dary_heap_t* heap);
+
+/**
+ * @brief Inserts an index or decreases its key
+ *
+ * If idx is already in the heap with a key lower or equal to key, nothing is
+ * done.
+ *
+ * _Complexity:_ \f$O(\log_d{n})\f$
+ *
+ * @param heap pointer to the heap
+ * @param idx index, smaller than the capacity (not checked)
+ * @param key new key of idx
+ */
+void dary_heap_decrease_key(dary_heap_t* heap,
+							unsigned idx,
+							graph_weight_t key);
+
+/**
+ * @brief Removes the index of lowest key
+ *
+ * _Complexity:_ \f$O(d \times \log_d{n})\f$
+ *
+ * @param heap pointer to the heap
+ * @param[out] key key of the index (facultative, can be left NULL)
+ * @return the index or -ERROR_IS_EMPTY if the heap is empty
+ */
+int dary_heap_pop(dary_heap_t* heap, graph_weight_t* key);
+
+/**
+ * @brief Tests if an index is in the heap
+ * @param heap pointer to the heap
+ * @param idx index, smaller than the capacity (not checked)
+ */
+static inline BOOL dary_heap_contains(const dary_heap_t* heap, unsigned idx) {
+	return heap->idx_to_pos[idx] != DARY_HEAP_ABSENT;
+}
+
+/** @} */
+
+#endif	// !STRUCT_DARY_HEAP_H
@@ -6,6 +6,7 @@
 #define ERROR_CAPACITY_EXCEEDED 2
 #define ERROR_IS_EMPTY 3
 #define ERROR_KEY_ALREADY_EXISTS 4
+#define ERROR_IO 5
 
 #define ERROR_INVALID_PARAM (1 << 3)
 #define ERROR_INVALID_PARAM1 (ERROR_INVALID_PARAM | 1)
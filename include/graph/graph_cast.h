@@ -6,15 +6,17 @@
  * @brief Conversion functions for different graph implementations
  * @ingroup graph
  *
- * Defines function to perform conversion between graph_mat and graph_list
- * types.
+ * Defines function to perform conversion between graph_mat, graph_list and
+ * graph_csr types.
+ *
+ * The rows of the source graph are converted independently, the functions
+ * taking a nb_threads parameter split them in nb_threads contiguous ranges
+ * converted by as many threads (0 is the same as 1).
  */
 
-typedef struct graph_mat graph_mat_t;
-struct graph_mat;
-
-typedef struct graph_list graph_list_t;
-struct graph_list;
+#include "graph/graph_csr.h"
+#include "graph/graph_list.h"
+#include "graph/graph_mat.h"
 
 /**
  * @brief Converts a graph_mat_t into a graph_list_t
@@ -22,6 +24,10 @@ struct graph_list;
  * Copy a graph defined as a matrix into a graph defined as adjacency lists.
  * The created graph_list_t will have to be released using free_graph_list()
  *
+ * The empty parts of the rows are skipped several cells at a time.
+ *
+ * _Complexity:_ \f$O(V^2 + E)\f$
+ *
  * @param graph_mat pointer to the graph to copy
  * @param graph_list Pointer which will reference the newly created graph_list_t
  * after function call
@@ -30,4 +36,84 @@ struct graph_list;
 graph_list_t* graph_mat_to_graph_list(graph_mat_t* graph_mat,
 									  graph_list_t** graph_list);
 
+/**
+ * @brief Same as graph_mat_to_graph_list() with nb_threads threads
+ * @param g pointer to the graph to copy
+ * @param nb_threads number of threads to use
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_list_t* graph_mat_to_graph_list_parallel(graph_mat_t* g,
+											   unsigned nb_threads);
+
+/**
+ * @brief Converts a graph_list_t into a graph_mat_t
+ *
+ * If g has several edges (i, j) the weight of the last one is kept.
+ * The created graph_mat_t will have to be released using free_graph_mat()
+ *
+ * _Complexity:_ \f$O(V^2 + E)\f$
+ *
+ * @param g pointer to the graph to copy
+ * @param nb_threads number of threads to use
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_mat_t* graph_list_to_graph_mat(graph_list_t* g, unsigned nb_threads);
+
+/**
+ * @brief Converts a graph_mat_t into a graph_csr_t
+ *
+ * The degrees of the rows are counted first so that the edges are allocated
+ * at once, the successors of each vertex are sorted.
+ * The created graph_csr_t will have to be released using free_graph_csr()
+ *
+ * _Complexity:_ \f$O(V^2 + E)\f$
+ *
+ * @param g pointer to the graph to copy
+ * @param nb_threads number of threads to use
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_csr_t* graph_mat_to_graph_csr(graph_mat_t* g, unsigned nb_threads);
+
+/**
+ * @brief Converts a graph_list_t into a graph_csr_t
+ *
+ * The degrees of the rows are counted first so that the edges are allocated
+ * at once, the successors of each vertex keep the order of its list.
+ * The created graph_csr_t will have to be released using free_graph_csr()
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param g pointer to the graph to copy
+ * @param nb_threads number of threads to use
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_csr_t* graph_list_to_graph_csr(graph_list_t* g, unsigned nb_threads);
+
+/**
+ * @brief Converts a graph_csr_t into a graph_list_t
+ *
+ * The created graph_list_t will have to be released using free_graph_list()
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param g pointer to the graph to copy
+ * @param nb_threads number of threads to use
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_list_t* graph_csr_to_graph_list(graph_csr_t* g, unsigned nb_threads);
+
+/**
+ * @brief Converts a graph_csr_t into a graph_mat_t
+ *
+ * If g has several edges (i, j) the weight of the last one is kept.
+ * The created graph_mat_t will have to be released using free_graph_mat()
+ *
+ * _Complexity:_ \f$O(V^2 + E)\f$
+ *
+ * @param g pointer to the graph to copy
+ * @param nb_threads number of threads to use
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_mat_t* graph_csr_to_graph_mat(graph_csr_t* g, unsigned nb_threads);
+
 #endif	// !GRAPHCAST_H
@@ -0,0 +1,85 @@
+#ifndef GRAPH_CENTRALITY_H
+#define GRAPH_CENTRALITY_H
+
+#include <stdint.h>
+#include "graph/graph_list.h"
+
+/**
+ * @file graph/graph_centrality.h
+ * @brief Centrality measures of graphs
+ * @ingroup graph
+ *
+ * Defines parallel implementations of centrality measures over graph_list_t
+ */
+
+/**
+ * @defgroup graph_centrality Centrality
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @brief Betweenness centrality of every vertex
+ *
+ * Computes with Brandes' algorithm, for every vertex v:
+ * @f[ C_B(v) = \sum_{s \neq v \neq t} \frac{\sigma_{st}(v)}{\sigma_{st}} @f]
+ * where @f$\sigma_{st}@f$ is the number of shortest paths from s to t and
+ * @f$\sigma_{st}(v)@f$ the number of those paths going through v.
+ *
+ * If the graph is not weighted the shortest paths are computed with a BFS,
+ * otherwise with Dijkstra, in which case __the weights should be strictly
+ * positive__. Edges are directed: for an undirected graph (every edge stored
+ * in both directions) each pair is counted twice and the result can be
+ * divided by 2.
+ *
+ * The sources are shared between nb_threads threads, each thread owning its
+ * scratch arrays (stack, sigma, delta, distances) and its own partial
+ * centrality which are summed at the end. A source whose thread can't be
+ * created is handled by the calling thread. An empty graph is left as is.
+ *
+ * _Complexity:_ \f$O(V \times E)\f$ unweighted, \f$O(V \times (V + E)
+ * \ln{V})\f$ weighted
+ *
+ * @param[in] g pointer to the graph
+ * @param[out] centrality array of size g->nb_vert
+ * @param nb_threads number of threads to use (0 is the same as 1)
+ * @return -ERROR_NO_ERROR or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when centrality is NULL
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_list_betweenness(graph_list_t* g,
+						   double* centrality,
+						   unsigned nb_threads);
+
+/**
+ * @brief Approximate betweenness centrality from sampled sources
+ *
+ * Same as graph_list_betweenness() but only the dependencies of nb_samples
+ * sources drawn uniformly without replacement are accumulated. The result is
+ * scaled by g->nb_vert / nb_samples so that it is an unbiased estimation of
+ * the exact betweenness. The sampling is deterministic for a given seed.
+ *
+ * _Complexity:_ \f$O(k \times E)\f$ unweighted, \f$O(k \times (V + E)
+ * \ln{V})\f$ weighted, with k = nb_samples
+ *
+ * @param[in] g pointer to the graph
+ * @param[out] centrality array of size g->nb_vert
+ * @param nb_samples number of sources (at most g->nb_vert)
+ * @param seed seed of the sampling
+ * @param nb_threads number of threads to use (0 is the same as 1)
+ * @return -ERROR_NO_ERROR or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when centrality is NULL
+ * - -ERROR_INVALID_PARAM3 when nb_samples is 0 or greater than g->nb_vert
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_list_betweenness_sampled(graph_list_t* g,
+								   double* centrality,
+								   unsigned nb_samples,
+								   uint64_t seed,
+								   unsigned nb_threads);
+
+/** @} */
+
+#endif	// !GRAPH_CENTRALITY_H
@@ -0,0 +1,285 @@
+#ifndef GRAPH_COMPRESSED_H
+#define GRAPH_COMPRESSED_H
+
+#include <stddef.h>
+#include "graph/graph_list.h"
+#include "graph/graph_workspace.h"
+#include "structures.h"
+#include "weight_type.h"
+
+/**
+ * @file graph/graph_compressed.h
+ * @brief Read-only compressed adjacency lists
+ * @ingroup graph
+ *
+ * Defines a compact read-only representation of a graph, its iterator and the
+ * traversal and shortest path algorithms using it
+ */
+
+/**
+ * @defgroup graph_compressed Compressed adjacency lists
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @typedef graph_compressed_t
+ * @brief Typedef for the graph_compressed structure
+ */
+typedef struct graph_compressed graph_compressed_t;
+
+/**
+ * @struct graph_compressed
+ * @brief Read-only graph whose adjacency lists are stored as varints
+ *
+ * The successors of each vertex are sorted and stored in the #neighbours byte
+ * stream, from offset[v] to offset[v + 1]:
+ * - the outdegree of v
+ * - the difference between the first successor and v (zigzag encoded as it
+ *   may be negative)
+ * - the gaps between two consecutive successors
+ *
+ * The weights are stored in the same order in the #weights stream, from
+ * weight_offset[v] to weight_offset[v + 1], zigzag encoded.
+ *
+ * Each value is a varint: 7 bits per byte, the highest bit being set on every
+ * byte but the last one. Small gaps and weights then take a single byte
+ * instead of the 4 + sizeof(graph_weight_t) bytes of a flat edge array.
+ */
+struct graph_compressed {
+	unsigned nb_vert;
+	/**< Number of vertices */
+	size_t nb_edges;
+	/**< Number of edges */
+	size_t* offset;
+	/**< Array of nb_vert + 1 offsets in #neighbours */
+	unsigned char* neighbours;
+	/**< Encoded adjacency lists */
+	size_t* weight_offset;
+	/**< Array of nb_vert + 1 offsets in #weights (NULL if the graph is not
+	 * weighted) */
+	unsigned char* weights;
+	/**< Encoded weights (NULL if the graph is not weighted) */
+};
+
+/**
+ * @typedef graph_compressed_iter_t
+ * @brief Typedef for the graph_compressed_iter structure
+ */
+typedef struct graph_compressed_iter graph_compressed_iter_t;
+
+/**
+ * @struct graph_compressed_iter
+ * @brief Iterator on the successors of a vertex
+ *
+ * Initialized by graph_compressed_neighbours() and advanced by
+ * graph_compressed_next() which decodes one successor at a time.
+ */
+struct graph_compressed_iter {
+	const unsigned char* neighbours;
+	/**< Position in graph_compressed#neighbours */
+	const unsigned char* weights;
+	/**< Position in graph_compressed#weights */
+	unsigned remaining;
+	/**< Number of successors left */
+	BOOL first;
+	/**< TRUE until the first successor is decoded */
+	unsigned to;
+	/**< Current successor */
+	graph_weight_t w;
+	/**< Weight of the edge to the current successor */
+};
+
+/**
+ * @brief Decodes a varint and advances the pointer after it
+ * @param p pointer to the position in the stream
+ * @return the decoded value
+ */
+static inline unsigned long long graph_compressed_read_varint(
+	const unsigned char** p) {
+	unsigned char byte = *(*p)++;
+	unsigned long long x = byte & 0x7F;
+	for (unsigned shift = 7; byte & 0x80; shift += 7) {
+		byte = *(*p)++;
+		x |= (unsigned long long)(byte & 0x7F) << shift;
+	}
+	return x;
+}
+
+/**
+ * @brief Decodes a zigzag encoded signed value
+ */
+static inline long long graph_compressed_unzigzag(unsigned long long x) {
+	return (long long)(x >> 1) ^ -(long long)(x & 1);
+}
+
+/**
+ * @brief Starts the iteration on the successors of a vertex
+ *
+ * v is not checked.
+ *
+ * _Complexity:_ \f$O(1)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param v index of the vertex
+ * @param[out] it iterator to initialize
+ * @return the outdegree of v
+ */
+static inline unsigned graph_compressed_neighbours(
+	const graph_compressed_t* g,
+	unsigned v,
+	graph_compressed_iter_t* it) {
+	it->neighbours = g->neighbours + g->offset[v];
+	it->weights = g->weights ? g->weights + g->weight_offset[v] : NULL;
+	it->remaining = graph_compressed_read_varint(&it->neighbours);
+	it->first = TRUE;
+	it->to = v;
+	it->w = 1;
+	return it->remaining;
+}
+
+/**
+ * @brief Decodes the next successor
+ *
+ * When TRUE is returned, it->to is the next successor and it->w the weight of
+ * the edge (1 if the graph is not weighted).
+ *
+ * _Complexity:_ \f$O(1)\f$
+ *
+ * @param it iterator initialized by graph_compressed_neighbours()
+ * @return FALSE if there is no successor left, TRUE otherwise
+ */
+static inline BOOL graph_compressed_next(graph_compressed_iter_t* it) {
+	if (it->remaining == 0)
+		return FALSE;
+	it->remaining--;
+	const unsigned long long gap =
+		graph_compressed_read_varint(&it->neighbours);
+	if (it->first) {
+		it->to += graph_compressed_unzigzag(gap);
+		it->first = FALSE;
+	} else
+		it->to += gap;
+	if (it->weights)
+		it->w = graph_compressed_unzigzag(
+			graph_compressed_read_varint(&it->weights));
+	return TRUE;
+}
+
+/**
+ * @brief Compresses a graph_list_t
+ *
+ * __Every graph created with this function should be freed using
+ * free_graph_compressed__
+ *
+ * _Complexity:_ \f$O(V + E \ln{d^+})\f$
+ *
+ * @param[in] g pointer to the graph to compress
+ * @return a pointer to the compressed graph or NULL if the function failed
+ */
+graph_compressed_t* graph_list_to_graph_compressed(graph_list_t* g);
+
+/**
+ * @brief Frees a compressed graph
+ * @param g pointer to the graph
+ */
+void free_graph_compressed(graph_compressed_t* g);
+
+/**
+ * @brief Number of bytes used by the graph (including its structure)
+ * @param[in] g pointer to the graph
+ */
+size_t graph_compressed_memory(const graph_compressed_t* g);
+
+/**
+ * @brief Breadth-First Search Traversal of a graph
+ *
+ * Same as graph_list_bfs(), the successors of a vertex are visited by
+ * increasing index.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param r Starting vertex
+ * @param[out] values vertices index in the order they were encountered
+ * @param[out] father list of predecessors (facultative, can be left NULL)
+ * @param ws workspace created for at least g->nb_vert vertices
+ * @return number of nodes reached or a negative error code
+ */
+int graph_compressed_bfs_ws(graph_compressed_t* g,
+							unsigned r,
+							int* values,
+							int* father,
+							graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_compressed_bfs_ws() with a temporary workspace
+ */
+int graph_compressed_bfs(graph_compressed_t* g,
+						 unsigned r,
+						 int* values,
+						 int* father);
+
+/**
+ * @brief Preorder Depth-First Search Traversal of a graph
+ *
+ * Same as graph_list_preorder_dfs(), the successors of a vertex are visited
+ * by increasing index.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param r Starting vertex
+ * @param[out] values vertices index in the order they were encountered
+ * @param[out] father list of predecessors (facultative, can be left NULL)
+ * @param ws workspace created for at least g->nb_vert vertices
+ * @return number of nodes reached or a negative error code
+ */
+int graph_compressed_preorder_dfs_ws(graph_compressed_t* g,
+									 unsigned r,
+									 int* values,
+									 int* father,
+									 graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_compressed_preorder_dfs_ws() with a temporary workspace
+ */
+int graph_compressed_preorder_dfs(graph_compressed_t* g,
+								  unsigned r,
+								  int* values,
+								  int* father);
+
+/**
+ * @brief Dijkstra algorithm on a compressed graph
+ *
+ * Same as graph_list_dijkstra(), __the weights of the edges have to be
+ * positive.__
+ *
+ * _Complexity:_ \f$O((V + E) \ln{V})\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param r Starting vertex (root)
+ * @param[out] distance distance[i] is the minimum distance from root to node i
+ * (GRAPH_WEIGHT_INF if there is no path to i)
+ * @param[out] father predecessor[i] is the predecessor of node i in the
+ * shortest path from root to node i (facultative, can be left NULL)
+ * @param ws workspace created for at least g->nb_vert vertices
+ * @return number of nodes reached or a negative error code
+ */
+int graph_compressed_dijkstra_ws(graph_compressed_t* g,
+								 unsigned r,
+								 graph_weight_t* distance,
+								 int* father,
+								 graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_compressed_dijkstra_ws() with a temporary workspace
+ */
+int graph_compressed_dijkstra(graph_compressed_t* g,
+							  unsigned r,
+							  graph_weight_t* distance,
+							  int* father);
+
+/** @} */
+
+#endif	// !GRAPH_COMPRESSED_H
@@ -0,0 +1,83 @@
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+
+#include <stddef.h>
+#include "structures.h"
+#include "weight_type.h"
+
+/**
+ * @file graph/graph_csr.h
+ * @brief Graphs defined in Compressed Sparse Row form
+ * @ingroup graph
+ *
+ * Defines a flat read-mostly representation of a graph whose edges are stored
+ * contiguously, row after row. It is created by the conversion functions of
+ * graph/graph_cast.h.
+ */
+
+/**
+ * @defgroup graph_csr Compressed Sparse Row graphs
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @typedef graph_csr_t
+ * @brief Typedef for the graph_csr structure
+ */
+typedef struct graph_csr graph_csr_t;
+
+/**
+ * @struct graph_csr
+ * @brief Graph whose edges are stored in two flat arrays
+ *
+ * The edges going out of v are the edges of index offset[v] to
+ * offset[v + 1] - 1: their destinations are in #to and their weights in
+ * #weights.
+ */
+struct graph_csr {
+	unsigned nb_vert;
+	/**< Number of vertices */
+	size_t nb_edges;
+	/**< Number of edges */
+	size_t* offset;
+	/**< Array of nb_vert + 1 offsets in #to and #weights */
+	unsigned* to;
+	/**< Destinations of the edges */
+	graph_weight_t* weights;
+	/**< Weights of the edges (NULL if the graph is not weighted) */
+};
+
+/**
+ * @brief Creates a graph_csr_t with room for nb_edges edges
+ *
+ * The offsets are left uninitialized.
+ *
+ * __Every graph created with this function should be freed using
+ * free_graph_csr__
+ *
+ * @param nb_vert number of vertices (should be strictly positive)
+ * @param nb_edges number of edges
+ * @param is_weighted should the graph be weighted
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_csr_t* create_graph_csr(unsigned nb_vert,
+							  size_t nb_edges,
+							  BOOL is_weighted);
+
+/**
+ * @brief Frees a graph_csr_t
+ * @param g pointer to the graph
+ */
+void free_graph_csr(graph_csr_t* g);
+
+/**
+ * @brief Outdegree of a vertex (v is not checked)
+ */
+static inline unsigned graph_csr_outdegree(const graph_csr_t* g, unsigned v) {
+	return g->offset[v + 1] - g->offset[v];
+}
+
+/** @} */
+
+#endif	// !GRAPH_CSR_H
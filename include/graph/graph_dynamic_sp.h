@@ -0,0 +1,121 @@
+#ifndef GRAPH_DYNAMIC_SP_H
+#define GRAPH_DYNAMIC_SP_H
+
+#include "graph/graph_list.h"
+#include "graph/graph_workspace.h"
+
+/**
+ * @file graph/graph_dynamic_sp.h
+ * @brief Dynamic single source shortest paths
+ * @ingroup graph
+ *
+ * Defines a structure maintaining the shortest paths from a root in a
+ * graph_list_t whose edges are inserted, removed or reweighted
+ */
+
+/**
+ * @defgroup graph_dynamic_sp Dynamic shortest paths
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @typedef graph_dynamic_sp_t
+ * @brief Typedef for the graph_dynamic_sp structure
+ */
+typedef struct graph_dynamic_sp graph_dynamic_sp_t;
+
+/**
+ * @struct graph_dynamic_sp
+ * @brief Shortest paths from a root kept up to date under edge updates
+ *
+ * The distances and the shortest path tree are computed once with Dijkstra
+ * algorithm, then each edge update only repairs the vertices whose distance
+ * changes (Ramalingam-Reps algorithm):
+ * - when the weight of an edge (a, b) decreases (or the edge is inserted), a
+ *   Dijkstra search starting from b only visits the vertices whose distance
+ *   decreases
+ * - when the weight of an edge (a, b) of the shortest path tree increases (or
+ *   the edge is removed), the subtree of b is detached, each of its vertices
+ *   gets the best distance through its predecessors outside of the subtree
+ *   and a Dijkstra search restricted to the subtree computes the new
+ *   distances. Updating an edge which is not in the tree costs nothing.
+ *
+ * The predecessors of each vertex are stored in a reversed copy of the graph,
+ * so __every edge update of the graph should go through
+ * graph_dynamic_sp_set_edge()__ while the structure is alive.
+ *
+ * __The weights of the edges have to be positive.__
+ */
+struct graph_dynamic_sp {
+	graph_list_t* g;
+	/**< Graph whose shortest paths are maintained (not owned) */
+	graph_list_t* reverse;
+	/**< Reversed graph: (b, a) is an edge of reverse iif (a, b) is in g */
+	unsigned root;
+	/**< Root of the shortest paths */
+	graph_weight_t* distance;
+	/**< distance[v] is the distance from root to v (GRAPH_WEIGHT_INF if v
+	 * cannot be reached) */
+	int* father;
+	/**< father[v] is the predecessor of v in the shortest path tree (-1 for
+	 * the root and the vertices which cannot be reached) */
+	graph_sp_workspace_t* ws;
+	/**< Marks, queue and heap of the updates */
+};
+
+/**
+ * @brief Computes the shortest paths from r and creates the structure
+ *
+ * __Every structure created with this function should be freed using
+ * free_graph_dynamic_sp__
+ *
+ * _Complexity:_ \f$O((V + E) \ln{V})\f$
+ *
+ * @param g pointer to the graph (it is not copied and should outlive the
+ * structure)
+ * @param r root of the shortest paths
+ * @return a pointer to the newly created structure or NULL if the function
+ * failed
+ */
+graph_dynamic_sp_t* create_graph_dynamic_sp(graph_list_t* g, unsigned r);
+
+/**
+ * @brief Frees the structure (but not its graph)
+ * @param dsp pointer to the structure
+ */
+void free_graph_dynamic_sp(graph_dynamic_sp_t* dsp);
+
+/**
+ * @brief Creates, removes or reweights an edge and repairs the shortest paths
+ *
+ * The graph is updated as with graph_list_set_edge(), then
+ * graph_dynamic_sp#distance and graph_dynamic_sp#father are repaired.
+ *
+ * _Complexity:_ \f$O((\delta_V + \delta_E) \ln{\delta_V})\f$ where
+ * \f$\delta_V\f$ is the number of vertices whose distance or father changes
+ * and \f$\delta_E\f$ the number of edges adjacent to them
+ *
+ * @param[inout] dsp pointer to the structure
+ * @param a origin vertex
+ * @param b target vertex
+ * @param val TRUE: the edge is created or reweighted, FALSE: the edge is
+ * removed
+ * @param weight if val == TRUE, this will be the weight of the edge
+ * @param reverse also update the symetrical edge (b, a)
+ * @return number of vertices repaired or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when dsp is NULL
+ * - -ERROR_INVALID_PARAM2 when a >= g->nb_vert
+ * - -ERROR_INVALID_PARAM3 when b >= g->nb_vert
+ * - -ERROR_INVALID_PARAM5 when weight is negative
+ */
+int graph_dynamic_sp_set_edge(graph_dynamic_sp_t* dsp,
+							  unsigned a,
+							  unsigned b,
+							  BOOL val,
+							  graph_weight_t weight,
+							  BOOL reverse);
+
+/** @} */
+
+#endif	// !GRAPH_DYNAMIC_SP_H
@@ -0,0 +1,186 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "graph/graph_list.h"
+#include "graph/graph_mat.h"
+#include "weight_type.h"
+
+/**
+ * @file graph/graph_generators.h
+ * @brief Random graph generators
+ * @ingroup graph
+ *
+ * Defines deterministic generators of large random graphs (R-MAT, grids,
+ * Erdős–Rényi graphs and DAGs) to test and benchmark the graph algorithms
+ */
+
+/**
+ * @defgroup graph_generators Random graph generators
+ * @ingroup graph
+ *
+ * Every generator writes its edges in a graph_edge_array_t which can then be
+ * converted to a graph_list_t or a graph_mat_t. The generators are seeded
+ * with prng_seed() so that a seed always gives the same graph.
+ *
+ * The weights are drawn uniformly in [1, max_weight], the graph is unweighted
+ * (every weight is 1) if max_weight is 0.
+ *
+ * The graphs never contain a self loop or twice the same edge.
+ * @{
+ */
+
+/**
+ * @typedef graph_edge_t
+ * @brief Typedef for the graph_edge structure
+ */
+typedef struct graph_edge graph_edge_t;
+
+/**
+ * @struct graph_edge
+ * @brief An edge (from, to) with a weight
+ */
+struct graph_edge {
+	unsigned from;	  /**< Origin vertex */
+	unsigned to;	  /**< Destination vertex */
+	graph_weight_t w; /**< Weight of the edge */
+};
+
+/**
+ * @typedef graph_edge_array_t
+ * @brief Typedef for the graph_edge_array structure
+ */
+typedef struct graph_edge_array graph_edge_array_t;
+
+/**
+ * @struct graph_edge_array
+ * @brief Packed array of the edges of a graph
+ */
+struct graph_edge_array {
+	unsigned nb_vert;
+	/**< Number of vertices */
+	size_t nb_edges;
+	/**< Number of edges */
+	graph_edge_t* edges;
+	/**< Array of nb_edges edges */
+	BOOL is_weighted;
+	/**< FALSE if every weight is 1 */
+};
+
+/**
+ * @brief Frees an edge array
+ * @param edges pointer to the edge array
+ */
+void free_graph_edge_array(graph_edge_array_t* edges);
+
+/**
+ * @brief Creates an adjacency list graph from an edge array
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] edges pointer to the edge array
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_list_t* graph_edge_array_to_graph_list(const graph_edge_array_t* edges);
+
+/**
+ * @brief Creates an adjacency matrix graph from an edge array
+ *
+ * _Complexity:_ \f$O(V^2 + E)\f$
+ *
+ * @param[in] edges pointer to the edge array
+ * @return a pointer to the newly created graph or NULL if the function failed
+ */
+graph_mat_t* graph_edge_array_to_graph_mat(const graph_edge_array_t* edges);
+
+/**
+ * @brief Recursive MATrix (R-MAT) graph
+ *
+ * Each edge is placed by choosing recursively one of the four quadrants of
+ * the adjacency matrix with the probabilities a, b, c and 1 - a - b - c, which
+ * gives a skewed degree distribution similar to social and web graphs (the
+ * Graph500 benchmark uses a = 0.57, b = c = 0.19). The self loops and the
+ * duplicated edges are removed so the graph may have less than nb_edges edges.
+ *
+ * _Complexity:_ \f$O(E \times scale + E \ln{E})\f$
+ *
+ * @param scale the graph has 2^scale vertices (at most 31)
+ * @param nb_edges number of edges to draw
+ * @param a probability of the top left quadrant
+ * @param b probability of the top right quadrant
+ * @param c probability of the bottom left quadrant
+ * @param max_weight maximum weight of an edge
+ * @param seed seed of the generator
+ * @return a pointer to the edge array or NULL if the function failed
+ */
+graph_edge_array_t* graph_generate_rmat(unsigned scale,
+										size_t nb_edges,
+										double a,
+										double b,
+										double c,
+										graph_weight_t max_weight,
+										uint64_t seed);
+
+/**
+ * @brief Two-dimensional grid
+ *
+ * The vertex of row i and column j is i * cols + j, it is linked in both
+ * directions to its four neighbours, each direction having its own random
+ * weight.
+ *
+ * _Complexity:_ \f$O(rows \times cols)\f$
+ *
+ * @param rows number of rows
+ * @param cols number of columns
+ * @param max_weight maximum weight of an edge
+ * @param seed seed of the generator
+ * @return a pointer to the edge array or NULL if the function failed
+ */
+graph_edge_array_t* graph_generate_grid(unsigned rows,
+										unsigned cols,
+										graph_weight_t max_weight,
+										uint64_t seed);
+
+/**
+ * @brief Erdős–Rényi G(n, p) directed graph
+ *
+ * Each of the n * (n - 1) possible edges is present with probability p. The
+ * gaps between two present edges are drawn from a geometric distribution so
+ * that the generation only costs the number of edges generated.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param n number of vertices
+ * @param p probability of each edge
+ * @param max_weight maximum weight of an edge
+ * @param seed seed of the generator
+ * @return a pointer to the edge array or NULL if the function failed
+ */
+graph_edge_array_t* graph_generate_gnp(unsigned n,
+									   double p,
+									   graph_weight_t max_weight,
+									   uint64_t seed);
+
+/**
+ * @brief Random directed acyclic graph
+ *
+ * Draws a random topological order of the n vertices then each of the
+ * n * (n - 1) / 2 edges going forward in this order with probability p.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param n number of vertices
+ * @param p probability of each edge
+ * @param max_weight maximum weight of an edge
+ * @param seed seed of the generator
+ * @return a pointer to the edge array or NULL if the function failed
+ */
+graph_edge_array_t* graph_generate_dag(unsigned n,
+									   double p,
+									   graph_weight_t max_weight,
+									   uint64_t seed);
+
+/** @} */
+
+#endif	// !GRAPH_GENERATORS_H
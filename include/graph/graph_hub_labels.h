@@ -0,0 +1,137 @@
+#ifndef GRAPH_HUB_LABELS_H
+#define GRAPH_HUB_LABELS_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "graph/graph_list.h"
+#include "weight_type.h"
+
+/**
+ * @file graph/graph_hub_labels.h
+ * @brief Hub labeling distance oracle
+ * @ingroup graph
+ *
+ * Defines a 2-hop labeling of a graph_list_t built by pruned landmark
+ * labeling, which answers distance queries without searching the graph
+ */
+
+/**
+ * @defgroup graph_hub_labels Hub labeling
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @typedef graph_hub_labels_t
+ * @brief Typedef for the graph_hub_labels structure
+ */
+typedef struct graph_hub_labels graph_hub_labels_t;
+
+/**
+ * @struct graph_hub_labels
+ * @brief 2-hop labels of every vertex of a directed graph
+ *
+ * Each vertex v has an out label, a list of hubs h with the distance from v
+ * to h, and an in label, a list of hubs h with the distance from h to v. For
+ * every pair (s, t) connected by a path, a hub of a shortest path from s to t
+ * is in both the out label of s and the in label of t, so that:
+ * @f[ d(s, t) = \min_{h \in L_{out}(s) \cap L_{in}(t)} d(s, h) + d(h, t) @f]
+ *
+ * The hubs are identified by their rank in the order of the construction
+ * (vertices of higher degree first), each label being sorted by rank. The
+ * labels are stored contiguously: the out label of v is made of the entries
+ * out_offset[v] to out_offset[v + 1] - 1 of out_hub and out_dist.
+ */
+struct graph_hub_labels {
+	unsigned nb_vert;
+	/**< Number of vertices */
+	size_t* out_offset;
+	/**< Array of nb_vert + 1 offsets in out_hub and out_dist */
+	unsigned* out_hub;
+	/**< Ranks of the hubs of the out labels */
+	graph_weight_t* out_dist;
+	/**< Distances from the vertices to the hubs of their out labels */
+	size_t* in_offset;
+	/**< Array of nb_vert + 1 offsets in in_hub and in_dist */
+	unsigned* in_hub;
+	/**< Ranks of the hubs of the in labels */
+	graph_weight_t* in_dist;
+	/**< Distances from the hubs of their in labels to the vertices */
+};
+
+/**
+ * @brief Builds the hub labels of a graph (pruned landmark labeling)
+ *
+ * The vertices are processed by decreasing degree (indegree + outdegree).
+ * For each vertex h, a search from h (BFS if the graph is not weighted,
+ * Dijkstra otherwise) adds h to the in label of every vertex v it reaches,
+ * unless the labels built so far already give a distance from h to v at most
+ * as long: the search is then pruned at v. A second search on the reversed
+ * graph fills the out labels the same way.
+ *
+ * __The weights of the edges have to be positive.__
+ *
+ * __Every index created with this function should be freed using
+ * free_graph_hub_labels__
+ *
+ * _Complexity:_ \f$O(V \times (V + E) \ln{V})\f$ in the worst case, much less
+ * on graphs with a few well connected vertices (road and social networks)
+ *
+ * @param[in] g pointer to the graph
+ * @return a pointer to the index or NULL if the function failed
+ */
+graph_hub_labels_t* create_graph_hub_labels(graph_list_t* g);
+
+/**
+ * @brief Frees the hub labels
+ * @param labels pointer to the index
+ */
+void free_graph_hub_labels(graph_hub_labels_t* labels);
+
+/**
+ * @brief Distance from s to t
+ *
+ * Merges the out label of s and the in label of t. s and t are not checked.
+ *
+ * _Complexity:_ \f$O(|L_{out}(s)| + |L_{in}(t)|)\f$
+ *
+ * @param[in] labels pointer to the index
+ * @param s origin vertex
+ * @param t destination vertex
+ * @return the distance from s to t or GRAPH_WEIGHT_INF if there is no path
+ */
+graph_weight_t graph_hub_labels_distance(const graph_hub_labels_t* labels,
+										 unsigned s,
+										 unsigned t);
+
+/**
+ * @brief Total number of entries of the labels
+ * @param[in] labels pointer to the index
+ */
+size_t graph_hub_labels_size(const graph_hub_labels_t* labels);
+
+/**
+ * @brief Writes the index in a binary file
+ *
+ * The file can only be read back by a build of the library using the same
+ * weight type and byte order.
+ *
+ * @param[in] labels pointer to the index
+ * @param file file opened for writing in binary mode
+ * @return -ERROR_NO_ERROR or a negative error code:
+ * - -ERROR_INVALID_PARAM1 or -ERROR_INVALID_PARAM2 when a pointer is NULL
+ * - -ERROR_IO when the file could not be written
+ */
+int graph_hub_labels_save(const graph_hub_labels_t* labels, FILE* file);
+
+/**
+ * @brief Reads an index written by graph_hub_labels_save()
+ * @param file file opened for reading in binary mode
+ * @return a pointer to the index or NULL if the file could not be read or is
+ * not a valid index
+ */
+graph_hub_labels_t* graph_hub_labels_load(FILE* file);
+
+/** @} */
+
+#endif	// !GRAPH_HUB_LABELS_H
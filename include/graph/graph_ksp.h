@@ -0,0 +1,72 @@
+#ifndef GRAPH_KSP_H
+#define GRAPH_KSP_H
+
+#include "graph/graph_list.h"
+
+/**
+ * @file graph/graph_ksp.h
+ * @brief K shortest paths
+ * @ingroup graph
+ *
+ * Defines algorithms computing several alternative shortest paths between two
+ * vertices of a graph_list_t
+ */
+
+/**
+ * @defgroup graph_ksp K shortest paths
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @brief Yen's k shortest loopless paths
+ *
+ * Computes the k shortest paths from src to dst which do not go twice
+ * through the same vertex, in non-decreasing order of cost.
+ *
+ * __The weights of the edges have to be positive.__
+ *
+ * Every spur path search runs on the same Dijkstra buffers (distance, father,
+ * heap and marks) which are allocated once for the whole call, the vertices
+ * and edges removed from the graph for a search are marked with a stamp so
+ * that they are restored in \f$O(1)\f$. The candidate paths are ordered by a
+ * priority_queue_t on their cost, which grows with the number of candidates
+ * found, and the duplicates are detected by a hash set of the candidates.
+ *
+ * The output arrays should be allocated by the user:
+ * - paths of size k * g->nb_vert, the i-th path is stored in
+ *   paths[i * g->nb_vert] to paths[i * g->nb_vert + lengths[i] - 1] from src to
+ *   dst
+ * - lengths of size k, lengths[i] is the number of vertices of the i-th path
+ * - costs of size k, costs[i] is the cost of the i-th path (facultative, can
+ *   be left NULL)
+ *
+ * _Complexity:_ \f$O(k \times V \times (V + E) \ln{V})\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param src Starting vertex
+ * @param dst Destination vertex
+ * @param k Maximum number of paths
+ * @param[out] paths vertices of the paths
+ * @param[out] lengths number of vertices of each path
+ * @param[out] costs cost of each path
+ * @return number of paths found (which can be lower than k) or a negative
+ * error code:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when src >= g->nb_vert
+ * - -ERROR_INVALID_PARAM3 when dst >= g->nb_vert
+ * - -ERROR_INVALID_PARAM5 when paths is NULL
+ * - -ERROR_INVALID_PARAM6 when lengths is NULL
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_list_yen(graph_list_t* g,
+				   unsigned src,
+				   unsigned dst,
+				   unsigned k,
+				   unsigned* paths,
+				   unsigned* lengths,
+				   graph_weight_t* costs);
+
+/** @} */
+
+#endif	// !GRAPH_KSP_H
@@ -2,6 +2,7 @@
 #define GRAPH_LIST_H
 
 #include "list_ref/list_ref.h"
+#include "graph/graph_workspace.h"
 #include "weight_type.h"
 
 /**
@@ -401,6 +402,226 @@ int graph_list_ford_dantzig(graph_list_t* g,
 							int* father,
 							int* cycle);
 
+/**
+ * @defgroup graph_list_dag Longest paths and scheduling on DAGs
+ *
+ * These algorithms work on directed acyclic graphs (DAG) and take as input the
+ * topological order denum computed once with
+ * graph_list_topological_ordering(). They then perform a single linear pass
+ * over this order and write their results in arrays allocated by the user
+ * (with a size of graph_list#nb_vert) so that they can be called repeatedly on
+ * the same DAG without any allocation.
+ *
+ * These algorithms can return these **error codes**:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when denum is NULL
+ * - -ERROR_INVALID_PARAMn when the n-th parameter is a NULL output array or
+ * an out of range source vertex
+ */
+
+/**
+ * @brief Longest paths from a single vertex of a DAG
+ * @ingroup graph_list_dag
+ *
+ * Same as graph_list_dag_longest_path_multi() with a single source.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] denum vertices in topological order
+ * @param r Starting vertex (root)
+ * @param[out] distance distance[i] is the maximum distance from root to node i
+ * (-GRAPH_WEIGHT_INF if there is no path to i)
+ * @param[out] father predecessor[i] is the predecessor of node i in the
+ * longest path from root to node i
+ * @return number of nodes reached or a negative error code
+ */
+int graph_list_dag_longest_path(graph_list_t* g,
+								const unsigned* denum,
+								unsigned r,
+								graph_weight_t* distance,
+								int* father);
+
+/**
+ * @brief Longest paths from a set of vertices of a DAG
+ * @ingroup graph_list_dag
+ *
+ * __g must be a Directed Acyclic Graph (DAG)__ and denum should be the
+ * topological order returned by graph_list_topological_ordering().
+ *
+ * distance[i] is the maximum, among every source s, of the longest path from
+ * s to i. Every source has a distance of 0. If a node i can't be reached from
+ * any source we have:
+ * - distance[i] = -GRAPH_WEIGHT_INF
+ * - father[i] = -1
+ *
+ * father is facultative and can be left NULL.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] denum vertices in topological order
+ * @param[in] sources array of the starting vertices
+ * @param nb_sources number of starting vertices
+ * @param[out] distance distance[i] is the maximum distance from the sources to
+ * node i
+ * @param[out] father predecessor[i] is the predecessor of node i in the
+ * longest path from the sources to node i
+ * @return number of nodes reached or a negative error code
+ */
+int graph_list_dag_longest_path_multi(graph_list_t* g,
+									  const unsigned* denum,
+									  const unsigned* sources,
+									  unsigned nb_sources,
+									  graph_weight_t* distance,
+									  int* father);
+
+/**
+ * @brief Critical path analysis of a DAG
+ * @ingroup graph_list_dag
+ *
+ * Every vertex is a task and an edge (a, b) of weight w means that b cannot
+ * start before w units of time after the start of a. Tasks without
+ * predecessors start at 0 and the duration of the project is the largest
+ * earliest start time.
+ *
+ * - earliest[i] is the earliest time the i-th task can start
+ * - latest[i] is the latest time the i-th task can start without delaying
+ *   the project
+ * - slack[i] = latest[i] - earliest[i] (the critical tasks have a slack of 0)
+ *
+ * slack is facultative and can be left NULL.
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] denum vertices in topological order
+ * @param[out] earliest earliest start time of each vertex
+ * @param[out] latest latest start time of each vertex
+ * @param[out] slack slack of each vertex
+ * @return -ERROR_NO_ERROR or a negative error code
+ */
+int graph_list_critical_path(graph_list_t* g,
+							 const unsigned* denum,
+							 graph_weight_t* earliest,
+							 graph_weight_t* latest,
+							 graph_weight_t* slack);
+
+/**
+ * @defgroup graph_list_ws Workspace variants
+ *
+ * Each traversal and shortest path algorithm has a `_ws` variant taking a
+ * workspace created by create_graph_sp_workspace(). The variant does not
+ * allocate any memory so that many queries on the same graph (or on graphs of
+ * at most the same size) only pay for the allocations once. The other variant
+ * creates and frees a workspace at each call.
+ *
+ * The parameters and return values are the ones of the original function,
+ * -ERROR_INVALID_PARAMn is returned if ws is NULL or too small.
+ */
+
+/**
+ * @brief Same as graph_list_preorder_dfs() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_preorder_dfs_ws(graph_list_t* g,
+							   unsigned r,
+							   int* values,
+							   int* father,
+							   graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_postorder_dfs() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_postorder_dfs_ws(graph_list_t* g,
+								unsigned r,
+								int* values,
+								int* father,
+								graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_bfs() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_bfs_ws(graph_list_t* g,
+					  unsigned r,
+					  int* values,
+					  int* father,
+					  graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_topological_ordering() using a workspace
+ * @ingroup graph_list_ws
+ *
+ * The degrees of the vertices are stored in graph_sp_workspace#degree.
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_topological_ordering_ws(graph_list_t* g,
+									   unsigned* num,
+									   unsigned* denum,
+									   graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_dijkstra() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_dijkstra_ws(graph_list_t* g,
+						   unsigned r,
+						   graph_weight_t* distance,
+						   int* father,
+						   graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_bellman() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * The topological order is stored in graph_sp_workspace#num.
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_bellman_ws(graph_list_t* g,
+						  unsigned r,
+						  graph_weight_t* distance,
+						  int* father,
+						  graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_ford() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * The workspace is unused and only given for consistency.
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_ford_ws(graph_list_t* g,
+					   unsigned r,
+					   graph_weight_t* distance,
+					   int* father,
+					   graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_list_ford_dantzig() using the buffers of a workspace
+ * @ingroup graph_list_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_list_ford_dantzig_ws(graph_list_t* g,
+							   unsigned r,
+							   graph_weight_t* distance,
+							   int* father,
+							   int* cycle,
+							   graph_sp_workspace_t* ws);
+
 /** @} */
 
 #endif
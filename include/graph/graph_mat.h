@@ -1,6 +1,7 @@
 #ifndef GRAPH_MAT_H
 #define GRAPH_MAT_H
 
+#include "graph/graph_workspace.h"
 #include "structures.h"
 #include "weight_type.h"
 
@@ -389,6 +390,121 @@ int graph_mat_ford_dantzig(graph_mat_t* g,
 
 // int Ford_and_Fulkerson(GRAPH_MAT* g, unsigned src, unsigned well, )
 
+/**
+ * @defgroup graph_mat_ws Workspace variants
+ *
+ * Each traversal and shortest path algorithm has a `_ws` variant taking a
+ * workspace created by create_graph_sp_workspace(). The variant does not
+ * allocate any memory so that many queries on the same graph (or on graphs of
+ * at most the same size) only pay for the allocations once. The other variant
+ * creates and frees a workspace at each call.
+ *
+ * The parameters and return values are the ones of the original function,
+ * -ERROR_INVALID_PARAMn is returned if ws is NULL or too small.
+ */
+
+/**
+ * @brief Same as graph_mat_preorder_dfs() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_preorder_dfs_ws(graph_mat_t* g,
+							  unsigned r,
+							  int* values,
+							  int* father,
+							  graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_postorder_dfs() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_postorder_dfs_ws(graph_mat_t* g,
+							   unsigned r,
+							   int* values,
+							   int* father,
+							   graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_bfs() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_bfs_ws(graph_mat_t* g,
+					 unsigned r,
+					 int* values,
+					 int* father,
+					 graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_topological_ordering() using a workspace
+ * @ingroup graph_mat_ws
+ *
+ * The degrees of the vertices are stored in graph_sp_workspace#degree.
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_topological_ordering_ws(graph_mat_t* g,
+									  unsigned* num,
+									  unsigned* denum,
+									  graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_dijkstra() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_dijkstra_ws(graph_mat_t* g,
+						  unsigned r,
+						  graph_weight_t* distance,
+						  int* father,
+						  graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_bellman() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * The topological order is stored in graph_sp_workspace#num.
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_bellman_ws(graph_mat_t* g,
+						 unsigned r,
+						 graph_weight_t* distance,
+						 int* father,
+						 graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_ford() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * The workspace is unused and only given for consistency.
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_ford_ws(graph_mat_t* g,
+					  unsigned r,
+					  graph_weight_t* distance,
+					  int* father,
+					  graph_sp_workspace_t* ws);
+
+/**
+ * @brief Same as graph_mat_ford_dantzig() using the buffers of a workspace
+ * @ingroup graph_mat_ws
+ *
+ * @param ws workspace created for at least g->nb_vert vertices
+ */
+int graph_mat_ford_dantzig_ws(graph_mat_t* g,
+							  unsigned r,
+							  graph_weight_t* distance,
+							  int* father,
+							  int* cycle,
+							  graph_sp_workspace_t* ws);
+
 /** @} */
 
 #endif
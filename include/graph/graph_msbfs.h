@@ -0,0 +1,71 @@
+#ifndef GRAPH_MSBFS_H
+#define GRAPH_MSBFS_H
+
+#include "graph/graph_list.h"
+
+/**
+ * @file graph/graph_msbfs.h
+ * @brief Multi-source Breadth-First Search
+ * @ingroup graph
+ *
+ * Defines a BFS which computes the distances from many sources in a single
+ * traversal of the graph.
+ */
+
+/**
+ * @defgroup graph_msbfs Multi-source BFS
+ * @ingroup graph
+ * @{
+ */
+
+#ifndef GRAPH_MSBFS_WORDS
+/**
+ * @brief Number of 64 bits words in the frontier of a vertex
+ *
+ * graph_list_msbfs() runs 64 * GRAPH_MSBFS_WORDS BFS concurrently. It can be
+ * overridden at compile time (1 for 64 sources, 4 for 256 sources).
+ */
+#define GRAPH_MSBFS_WORDS 4
+#endif
+
+/**
+ * @brief Number of sources processed together by graph_list_msbfs()
+ */
+#define GRAPH_MSBFS_BATCH (64 * GRAPH_MSBFS_WORDS)
+
+/**
+ * @brief Breadth-First Search from several sources
+ *
+ * Computes the unweighted distance (number of edges) from every source to
+ * every vertex of the graph.
+ *
+ * The sources are processed by batches of #GRAPH_MSBFS_BATCH. Each vertex
+ * holds one bit per source of the batch in its frontier, so that a single
+ * pass over the adjacency lists of a level advances every BFS of the batch at
+ * once.
+ *
+ * distance should be an allocated array of size nb_sources * g->nb_vert.
+ * After the call distance[s * g->nb_vert + i] is the distance from sources[s]
+ * to the vertex i, or -1 if i can't be reached from sources[s].
+ *
+ * _Complexity:_ \f$O(\lceil S / 64 \rceil \times D \times (V + E))\f$ where
+ * D is the largest distance found in the batch
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] sources array of the starting vertices
+ * @param nb_sources number of starting vertices
+ * @param[out] distance array of the distances, row by row for each source
+ * @return -ERROR_NO_ERROR or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when sources is NULL or a source is out of range
+ * - -ERROR_INVALID_PARAM4 when distance is NULL
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_list_msbfs(graph_list_t* g,
+					 const unsigned* sources,
+					 unsigned nb_sources,
+					 int* distance);
+
+/** @} */
+
+#endif	// !GRAPH_MSBFS_H
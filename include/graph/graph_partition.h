@@ -0,0 +1,132 @@
+#ifndef GRAPH_PARTITION_H
+#define GRAPH_PARTITION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "graph/graph_list.h"
+
+/**
+ * @file graph/graph_partition.h
+ * @brief Graph partitioning
+ * @ingroup graph
+ *
+ * Defines a multilevel k-way partitioner over graph_list_t and the split of a
+ * graph into one subgraph per part, to distribute a graph between workers
+ */
+
+/**
+ * @defgroup graph_partition Partitioning
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @typedef graph_subgraph_t
+ * @brief Typedef for the graph_subgraph structure
+ */
+typedef struct graph_subgraph graph_subgraph_t;
+
+/**
+ * @struct graph_subgraph
+ * @brief Part of a graph with its ghost vertices
+ *
+ * The first #nb_owned vertices of #g are the vertices of the part, in
+ * increasing order of their index in the whole graph, with all their out
+ * edges. They are followed by the ghost vertices: the vertices of other parts
+ * which are the destination of an edge of the part. Ghost vertices have no
+ * out edge in the subgraph.
+ */
+struct graph_subgraph {
+	graph_list_t* g;
+	/**< Subgraph, NULL if the part is empty */
+	unsigned nb_owned;
+	/**< Number of vertices of the part */
+	unsigned* global;
+	/**< Index in the whole graph of each vertex of #g */
+};
+
+/**
+ * @brief Multilevel partition of a graph in k balanced parts
+ *
+ * The graph is considered undirected, the weight of an edge between two
+ * vertices being the number of edges between them in either direction.
+ *
+ * - Coarsening: the graph is repeatedly contracted by a heavy edge matching
+ *   (each vertex, in random order, is merged with the unmatched neighbour it
+ *   shares the heaviest edge with) until it has a few vertices per part or
+ *   stops shrinking.
+ * - Initial partition: the parts of the coarsest graph are grown one after
+ *   the other from a seed, greedily adding the vertex the most connected to
+ *   the part until it weighs 1 / k of the vertices.
+ * - Uncoarsening: the partition is projected back on each finer graph and
+ *   refined with Fiduccia-Mattheyses moves: boundary vertices are moved to
+ *   the neighbouring part which reduces the edge cut the most without
+ *   breaking the balance, overweight parts moving their vertices first.
+ *
+ * Each part has at most \f$\lceil (1 + imbalance) V / k \rceil\f$ vertices
+ * unless the coarsening merged too many vertices to meet the constraint.
+ * The result is deterministic for a given seed.
+ *
+ * _Complexity:_ \f$O((V + E) \ln{V})\f$ in practice
+ *
+ * @param[in] g pointer to the graph
+ * @param k number of parts, at most g->nb_vert
+ * @param imbalance tolerated relative excess of vertices of a part (0.03 for
+ * 3%)
+ * @param seed seed of the random matchings
+ * @param[out] part array of size g->nb_vert filled with the part of each
+ * vertex, between 0 and k - 1
+ * @return -ERROR_NO_ERROR or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when k is 0 or greater than g->nb_vert
+ * - -ERROR_INVALID_PARAM3 when imbalance is negative
+ * - -ERROR_INVALID_PARAM5 when part is NULL
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_list_partition(graph_list_t* g,
+						 unsigned k,
+						 double imbalance,
+						 uint64_t seed,
+						 unsigned* part);
+
+/**
+ * @brief Number of edges between vertices of different parts
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] part array of size g->nb_vert of the part of each vertex
+ */
+size_t graph_list_edge_cut(graph_list_t* g, const unsigned* part);
+
+/**
+ * @brief Splits a graph in one subgraph per part
+ *
+ * The weights of the edges are kept. The edge cut of the partition is the
+ * number of edges to a ghost vertex in all the subgraphs.
+ *
+ * __Every array of subgraphs created with this function should be freed
+ * using free_graph_subgraphs__
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] part array of size g->nb_vert of the part of each vertex,
+ * between 0 and k - 1
+ * @param k number of parts
+ * @return an array of k subgraphs or NULL if the function failed
+ */
+graph_subgraph_t* graph_list_split(graph_list_t* g,
+								   const unsigned* part,
+								   unsigned k);
+
+/**
+ * @brief Frees the subgraphs created by graph_list_split()
+ * @param subgraphs array of subgraphs
+ * @param k number of subgraphs
+ */
+void free_graph_subgraphs(graph_subgraph_t* subgraphs, unsigned k);
+
+/** @} */
+
+#endif	// !GRAPH_PARTITION_H
@@ -0,0 +1,81 @@
+#ifndef GRAPH_RCSP_H
+#define GRAPH_RCSP_H
+
+#include "graph/graph_csr.h"
+
+/**
+ * @file graph/graph_rcsp.h
+ * @brief Resource constrained shortest paths
+ * @ingroup graph
+ *
+ * Defines a label-setting algorithm computing the cheapest path whose
+ * consumption of a second weight (resource) stays within a budget
+ */
+
+/**
+ * @defgroup graph_rcsp Resource constrained shortest paths
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @brief Cheapest path from src to dst whose resource is within a budget
+ *
+ * Every edge i of g has a cost g->weights[i] (1 if g is not weighted) and a
+ * resource resource[i]. The path minimizes the sum of the costs among the
+ * paths whose sum of resources is at most budget.
+ *
+ * A label (cost, resource) represents a path from src to a vertex. Each
+ * vertex keeps the Pareto set of its labels: a new label is dropped if a
+ * label of the vertex is cheaper and uses less resource, otherwise it
+ * removes the labels it dominates. The labels are settled by increasing cost
+ * from a priority queue, so that the first label of dst settled is optimal.
+ * A label is also dropped if it cannot reach dst within the budget, the
+ * minimum resource from each vertex to dst being computed beforehand by a
+ * Dijkstra on the reversed graph. All the labels are stored in a single
+ * pool, the Pareto sets being linked lists of indexes in the pool.
+ *
+ * With max_labels > 0 a vertex keeps at most max_labels labels, which bounds
+ * the time and memory of the search: when the set is full a new label
+ * replaces the label using the most resource if it uses less, and is dropped
+ * otherwise. The path found is then feasible but not always the cheapest,
+ * and a feasible path may not be found.
+ *
+ * __The costs have to be strictly positive and the resources positive.__
+ *
+ * _Complexity:_ \f$O(L \times (d^+ + \ln{L}))\f$ where L is the number of
+ * labels created, which is at most \f$V \times max\_labels\f$ when
+ * max_labels > 0
+ *
+ * @param[in] g pointer to the graph
+ * @param[in] resource array of size g->nb_edges of the resource of each edge
+ * @param src Starting vertex
+ * @param dst Destination vertex
+ * @param budget maximum resource of the path
+ * @param max_labels maximum number of labels of a vertex (0 for no limit)
+ * @param[out] path array of size g->nb_vert filled with the vertices of the
+ * path from src to dst
+ * @param[out] cost cost of the path (facultative, can be left NULL)
+ * @param[out] used resource of the path (facultative, can be left NULL)
+ * @return the number of vertices of the path, 0 if no path within the budget
+ * was found, or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when g is NULL
+ * - -ERROR_INVALID_PARAM2 when resource is NULL
+ * - -ERROR_INVALID_PARAM3 when src >= g->nb_vert
+ * - -ERROR_INVALID_PARAM4 when dst >= g->nb_vert
+ * - -ERROR_INVALID_PARAM7 when path is NULL
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_csr_rcsp(const graph_csr_t* g,
+				   const graph_weight_t* resource,
+				   unsigned src,
+				   unsigned dst,
+				   graph_weight_t budget,
+				   unsigned max_labels,
+				   unsigned* path,
+				   graph_weight_t* cost,
+				   graph_weight_t* used);
+
+/** @} */
+
+#endif	// !GRAPH_RCSP_H
@@ -0,0 +1,271 @@
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <stdint.h>
+#include "graph/graph_list.h"
+#include "graph/graph_workspace.h"
+
+/**
+ * @file graph/graph_snapshot.h
+ * @brief Versioned graphs with lock-free readers
+ * @ingroup graph
+ *
+ * Defines a graph modified by a single writer while concurrent readers
+ * traverse immutable versions of it without taking any lock.
+ */
+
+/**
+ * @defgroup graph_snapshot Versioned graphs
+ * @ingroup graph
+ *
+ * The adjacency of a version is stored in two levels of immutable blocks:
+ * the version points to pages of #GRAPH_SNAPSHOT_PAGE_SIZE vertices which
+ * point to the array of the out edges of each vertex. The writer modifies a
+ * pending version which shares all its blocks with the published one, except
+ * the blocks it modified which are copied on the first write (copy-on-write).
+ * Publishing a version atomically replaces the pointer read by the readers.
+ *
+ * A version replaced by a newer one is freed once no reader can still hold
+ * it (epoch-based reclamation): the writer increments a global epoch at each
+ * publication, a reader announces the epoch in its own slot when it acquires
+ * a version, and a retired version is freed when every active slot announces
+ * an epoch older than its retirement.
+ *
+ * The writer functions (graph_versioned_set_edge(),
+ * graph_versioned_publish(), free_graph_versioned()) should be called by a
+ * single thread. Each reader uses its own slot with graph_versioned_acquire()
+ * and graph_versioned_release().
+ * @{
+ */
+
+/** Number of vertices of a page */
+#define GRAPH_SNAPSHOT_PAGE_SIZE 64
+
+/**
+ * @typedef graph_snapshot_edges_t
+ * @brief Typedef for the graph_snapshot_edges structure
+ */
+typedef struct graph_snapshot_edges graph_snapshot_edges_t;
+
+/**
+ * @struct graph_snapshot_edges
+ * @brief Immutable array of the out edges of a vertex
+ */
+struct graph_snapshot_edges {
+	unsigned refcount;
+	/**< Number of pages pointing to the array (only used by the writer) */
+	unsigned nb_edges;
+	/**< Number of edges */
+	graph_list_edge_t edges[];
+	/**< The edges in insertion order */
+};
+
+/**
+ * @typedef graph_snapshot_page_t
+ * @brief Typedef for the graph_snapshot_page structure
+ */
+typedef struct graph_snapshot_page graph_snapshot_page_t;
+
+/**
+ * @struct graph_snapshot_page
+ * @brief Immutable block of the adjacency of #GRAPH_SNAPSHOT_PAGE_SIZE
+ * vertices
+ */
+struct graph_snapshot_page {
+	unsigned refcount;
+	/**< Number of versions pointing to the page (only used by the writer) */
+	unsigned version;
+	/**< Version which created the page */
+	graph_snapshot_edges_t* adj[GRAPH_SNAPSHOT_PAGE_SIZE];
+	/**< Out edges of each vertex, NULL if it has none */
+};
+
+/**
+ * @typedef graph_snapshot_t
+ * @brief Typedef for the graph_snapshot structure
+ */
+typedef struct graph_snapshot graph_snapshot_t;
+
+/**
+ * @struct graph_snapshot
+ * @brief Immutable version of a graph
+ */
+struct graph_snapshot {
+	unsigned nb_vert;
+	/**< Number of vertices */
+	BOOL is_weighted;
+	/**< TRUE if the edges are weighted */
+	unsigned version;
+	/**< Number of the version, incremented at each publication */
+	graph_snapshot_page_t** pages;
+	/**< Array of the pages of the vertices */
+	uint64_t retire_epoch;
+	/**< Epoch at which the version was replaced (only used by the writer) */
+	graph_snapshot_t* next_retired;
+	/**< Next version waiting to be freed (only used by the writer) */
+};
+
+/**
+ * @typedef graph_versioned_t
+ * @brief Typedef for the graph_versioned structure
+ */
+typedef struct graph_versioned graph_versioned_t;
+
+/**
+ * @struct graph_versioned
+ * @brief Published and pending versions of a graph with the reader slots
+ */
+struct graph_versioned {
+	graph_snapshot_t* current;
+	/**< Published version, read atomically */
+	graph_snapshot_t* pending;
+	/**< Version modified by the writer, NULL if there is no modification */
+	uint64_t epoch;
+	/**< Global epoch, incremented at each publication */
+	uint64_t* slots;
+	/**< Epoch announced by each reader (one cache line each), 0 if idle */
+	unsigned nb_readers;
+	/**< Number of reader slots */
+	graph_snapshot_t* retired;
+	/**< List of the replaced versions not yet freed */
+};
+
+/**
+ * @brief Creates a versioned graph whose first version is a copy of g
+ *
+ * __Every versioned graph created with this function should be freed using
+ * free_graph_versioned__
+ *
+ * _Complexity:_ \f$O(V + E)\f$
+ *
+ * @param[in] g pointer to the graph
+ * @param nb_readers number of reader slots
+ * @return a pointer to the versioned graph or NULL if the function failed
+ */
+graph_versioned_t* create_graph_versioned(graph_list_t* g,
+										  unsigned nb_readers);
+
+/**
+ * @brief Frees the versioned graph and all its versions
+ *
+ * No reader should hold a version anymore.
+ *
+ * @param gv pointer to the versioned graph
+ */
+void free_graph_versioned(graph_versioned_t* gv);
+
+/**
+ * @brief Creates, modifies or removes an edge in the pending version
+ *
+ * Same as graph_list_set_edge(). The modification is not visible to the
+ * readers before the next call to graph_versioned_publish().
+ *
+ * _Complexity:_ \f$O(d^+)\f$, plus \f$O(V / 64)\f$ for the first modification
+ * after a publication
+ *
+ * @param gv pointer to the versioned graph
+ * @param a origin vertex
+ * @param b target vertex
+ * @param val TRUE: the edge is created, FALSE: the edges is removed
+ * @param weight if val == TRUE, this will be the weight of the new edge
+ * @param reverse create or remove the symetrical edge (b, a)
+ * @return -ERROR_NO_ERROR or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when gv is NULL
+ * - -ERROR_INVALID_PARAM2 or -ERROR_INVALID_PARAM3 when a vertex is out of
+ *   the graph
+ * - -ERROR_ALLOCATION_FAILED in case of malloc failure
+ */
+int graph_versioned_set_edge(graph_versioned_t* gv,
+							 unsigned a,
+							 unsigned b,
+							 BOOL val,
+							 graph_weight_t weight,
+							 BOOL reverse);
+
+/**
+ * @brief Publishes the pending version
+ *
+ * The readers acquiring a version after this call get the pending version.
+ * The replaced version is retired and the retired versions no reader can
+ * hold anymore are freed.
+ *
+ * @param gv pointer to the versioned graph
+ * @return the number of the published version or a negative error code:
+ * - -ERROR_INVALID_PARAM1 when gv is NULL
+ */
+int graph_versioned_publish(graph_versioned_t* gv);
+
+/**
+ * @brief Number of retired versions which are not freed yet
+ * @param gv pointer to the versioned graph
+ */
+unsigned graph_versioned_nb_retired(const graph_versioned_t* gv);
+
+/**
+ * @brief Acquires the published version for a reader
+ *
+ * The version stays valid and unchanged until graph_versioned_release() is
+ * called with the same slot. Wait-free.
+ *
+ * @param gv pointer to the versioned graph
+ * @param reader slot of the reader, smaller than gv->nb_readers
+ * @return the published version
+ */
+const graph_snapshot_t* graph_versioned_acquire(graph_versioned_t* gv,
+												unsigned reader);
+
+/**
+ * @brief Releases the version acquired by a reader
+ * @param gv pointer to the versioned graph
+ * @param reader slot of the reader
+ */
+void graph_versioned_release(graph_versioned_t* gv, unsigned reader);
+
+/**
+ * @brief Out edges of a vertex
+ * @param[in] s pointer to the version
+ * @param v vertex, not checked
+ * @return the array of the edges of v or NULL if it has no edge
+ */
+static inline const graph_snapshot_edges_t* graph_snapshot_edges(
+	const graph_snapshot_t* s,
+	unsigned v) {
+	return s->pages[v / GRAPH_SNAPSHOT_PAGE_SIZE]
+		->adj[v % GRAPH_SNAPSHOT_PAGE_SIZE];
+}
+
+/**
+ * @brief Gets the (a, b) edge of a version
+ *
+ * _Complexity:_ \f$O(d^+)\f$
+ *
+ * @param[in] s pointer to the version
+ * @param a origin vertex, not checked
+ * @param b target vertex
+ * @return a pointer to the edge or NULL if there is none
+ */
+const graph_list_edge_t* graph_snapshot_get_edge(const graph_snapshot_t* s,
+												 unsigned a,
+												 unsigned b);
+
+/**
+ * @brief Same as graph_list_dijkstra_ws() on a version
+ *
+ * The workspace should belong to the calling thread.
+ *
+ * @param[in] s pointer to the version
+ * @param r root vertex
+ * @param[out] distance array of size s->nb_vert of the distances from r
+ * @param[out] father array of size s->nb_vert of predecessors (may be NULL)
+ * @param ws workspace created for at least s->nb_vert vertices
+ * @return number of vertices reached or a negative error code
+ */
+int graph_snapshot_dijkstra_ws(const graph_snapshot_t* s,
+							   unsigned r,
+							   graph_weight_t* distance,
+							   int* father,
+							   graph_sp_workspace_t* ws);
+
+/** @} */
+
+#endif	// !GRAPH_SNAPSHOT_H
@@ -0,0 +1,176 @@
+#ifndef GRAPH_TYPED_H
+#define GRAPH_TYPED_H
+
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include "graph/graph_workspace.h"
+#include "list_ref/list_ref.h"
+#include "structures.h"
+
+/**
+ * @file graph/graph_typed.h
+ * @brief Graphs whose weight type is chosen at compile time
+ * @ingroup graph
+ *
+ * Defines specializations of the graphs and of the shortest path algorithms
+ * for several weight types which can be used together in the same program.
+ */
+
+/**
+ * @defgroup graph_typed Graphs with typed weights
+ * @ingroup graph
+ *
+ * graph_list_t and graph_mat_t use graph_weight_t which is fixed for the
+ * whole library by the weight_type option. The structures and functions of
+ * this group are generated by DECLARE_GRAPH_TYPED() for each of the following
+ * suffixes:
+ *
+ * | suffix | weight type | infinity            |
+ * |--------|-------------|---------------------|
+ * | i32    | int32_t     | INT32_MAX           |
+ * | i64    | int64_t     | INT64_MAX           |
+ * | f32    | float       | INFINITY            |
+ * | f64    | double      | HUGE_VAL (infinity) |
+ *
+ * For instance with the f64 suffix: graph_list_f64_t, create_graph_list_f64(),
+ * graph_list_f64_set_edge(), graph_list_dijkstra_f64(),
+ * graph_list_dijkstra_ws_f64(), graph_mat_f64_t, graph_mat_bellman_f64(),
+ * graph_mat_ford_dantzig_ws_f64()... The structures are generated from the
+ * same code as graph_list_t and graph_mat_t and the shortest path algorithms
+ * behave as their graph_weight_t counterparts, except that a vertex at an
+ * infinite distance is never used to relax its successors.
+ *
+ * The _ws variants take a graph_sp_workspace_t created for at least as many
+ * vertices as the graph, whose marks, buffers and heap are reused on the
+ * typed distances so that the algorithms do not allocate; the other variants
+ * create one for the call.
+ *
+ * The distances are added with weight_add_saturate_<suffix>(). For the
+ * integer types, as weight_add_truncate_overflow(), an overflowing sum of
+ * finite operands is clamped to \f$\pm(max - 1)\f$ so that the infinity
+ * \f$max\f$ only means unreached, and the infinity absorbs any finite
+ * operand as the IEEE 754 infinity does for the floating point types.
+ * @{
+ */
+
+#define GRAPH_WEIGHT_INF_i32 INT32_MAX
+#define GRAPH_WEIGHT_INF_i64 INT64_MAX
+#define GRAPH_WEIGHT_INF_f32 ((float)INFINITY)
+#define GRAPH_WEIGHT_INF_f64 HUGE_VAL
+
+/**
+ * @brief Defines the saturating addition of a signed integer type
+ *
+ * The sum is computed on the unsigned type of the same width. It overflowed
+ * iff both operands have the same sign and the sum a different one, in which
+ * case a mask selects the bound of the sign of the operands. The result is
+ * then clamped to [-(max - 1), max - 1], and replaced by max if an operand is
+ * max. The selections are written as masks and conditional expressions,
+ * which compilers usually turn into conditional moves rather than branches.
+ */
+#define DEFINE_WEIGHT_ADD_SATURATE_INT(sfx, type, utype, max)         \
+	static inline type weight_add_saturate_##sfx(type a, type b) {    \
+		const unsigned shift = sizeof(type) * CHAR_BIT - 1;           \
+		const utype ua = a, ub = b, sum = ua + ub;                    \
+		const utype overflow = -(((ua ^ sum) & (ub ^ sum)) >> shift); \
+		const utype saturated = (ua >> shift) + (utype)max;           \
+		type s = (type)((sum & ~overflow) | (saturated & overflow));  \
+		s = s > max - 1 ? max - 1 : s;                                \
+		s = s < -(max - 1) ? -(max - 1) : s;                          \
+		const utype inf = -(utype)((a == max) | (b == max));          \
+		return (type)(((utype)s & ~inf) | ((utype)max & inf));        \
+	}
+
+DEFINE_WEIGHT_ADD_SATURATE_INT(i32, int32_t, uint32_t, INT32_MAX)
+DEFINE_WEIGHT_ADD_SATURATE_INT(i64, int64_t, uint64_t, INT64_MAX)
+
+static inline float weight_add_saturate_f32(float a, float b) {
+	return a + b;
+}
+
+static inline double weight_add_saturate_f64(double a, double b) {
+	return a + b;
+}
+
+/**
+ * @brief Declares the shortest path functions of a representation
+ * @param rep list or mat
+ * @param sfx suffix appended to the names
+ * @param type weight type
+ */
+#define DECLARE_GRAPH_TYPED_SHORTEST_PATHS(rep, sfx, type)                   \
+	int graph_##rep##_dijkstra_ws_##sfx(graph_##rep##_##sfx##_t* g,          \
+										unsigned r, type* distance,          \
+										int* father,                         \
+										graph_sp_workspace_t* ws);           \
+	int graph_##rep##_dijkstra_##sfx(graph_##rep##_##sfx##_t* g, unsigned r, \
+									 type* distance, int* father);           \
+	int graph_##rep##_bellman_ws_##sfx(graph_##rep##_##sfx##_t* g,           \
+									   unsigned r, type* distance,           \
+									   int* father,                          \
+									   graph_sp_workspace_t* ws);            \
+	int graph_##rep##_bellman_##sfx(graph_##rep##_##sfx##_t* g, unsigned r,  \
+									type* distance, int* father);            \
+	int graph_##rep##_ford_##sfx(graph_##rep##_##sfx##_t* g, unsigned r,     \
+								 type* distance, int* father);               \
+	int graph_##rep##_ford_dantzig_ws_##sfx(                                 \
+		graph_##rep##_##sfx##_t* g, unsigned r, type* distance, int* father, \
+		int* cycle, graph_sp_workspace_t* ws);                               \
+	int graph_##rep##_ford_dantzig_##sfx(graph_##rep##_##sfx##_t* g,         \
+										 unsigned r, type* distance,         \
+										 int* father, int* cycle);
+
+/**
+ * @brief Declares the graphs and shortest path functions for a weight type
+ * @param sfx suffix appended to the names
+ * @param type weight type
+ */
+#define DECLARE_GRAPH_TYPED(sfx, type)                                    \
+	typedef struct graph_list_##sfx##_edge {                              \
+		type w;                                                           \
+		unsigned to;                                                      \
+	} graph_list_##sfx##_edge_t;                                          \
+                                                                          \
+	typedef struct graph_list_##sfx {                                     \
+		unsigned nb_vert;                                                 \
+		list_ref_t* neighbours;                                           \
+		BOOL is_weighted;                                                 \
+	} graph_list_##sfx##_t;                                               \
+                                                                          \
+	typedef struct graph_mat_##sfx {                                      \
+		unsigned nb_vert;                                                 \
+		type* weights;                                                    \
+		BOOL* edges;                                                      \
+	} graph_mat_##sfx##_t;                                                \
+                                                                          \
+	graph_list_##sfx##_t* create_graph_list_##sfx(unsigned size,          \
+												  BOOL is_weighted);      \
+	void free_graph_list_##sfx(graph_list_##sfx##_t* g);                  \
+	graph_list_##sfx##_edge_t* graph_list_##sfx##_get_edge(               \
+		graph_list_##sfx##_t* g, unsigned a, unsigned b);                 \
+	void graph_list_##sfx##_set_edge(graph_list_##sfx##_t* g, unsigned a, \
+									 unsigned b, BOOL val, type weight,   \
+									 BOOL reverse);                       \
+	DECLARE_GRAPH_TYPED_SHORTEST_PATHS(list, sfx, type)                   \
+                                                                          \
+	graph_mat_##sfx##_t* create_graph_mat_##sfx(unsigned size,            \
+												BOOL is_weighted);        \
+	void free_graph_mat_##sfx(graph_mat_##sfx##_t* g);                    \
+	BOOL graph_mat_##sfx##_get_edge(graph_mat_##sfx##_t* g, unsigned a,   \
+									unsigned b);                          \
+	type graph_mat_##sfx##_get_weight(graph_mat_##sfx##_t* g, unsigned a, \
+									  unsigned b);                        \
+	void graph_mat_##sfx##_set_edge(graph_mat_##sfx##_t* g, unsigned a,   \
+									unsigned b, BOOL val, type weight,    \
+									BOOL reverse);                        \
+	DECLARE_GRAPH_TYPED_SHORTEST_PATHS(mat, sfx, type)
+
+DECLARE_GRAPH_TYPED(i32, int32_t)
+DECLARE_GRAPH_TYPED(i64, int64_t)
+DECLARE_GRAPH_TYPED(f32, float)
+DECLARE_GRAPH_TYPED(f64, double)
+
+/** @} */
+
+#endif	// !GRAPH_TYPED_H
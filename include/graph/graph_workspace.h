@@ -0,0 +1,192 @@
+#ifndef GRAPH_WORKSPACE_H
+#define GRAPH_WORKSPACE_H
+
+#include "circular_buffer.h"
+#include "dary_heap.h"
+#include "heap_view.h"
+#include "structures.h"
+#include "weight_type.h"
+
+/**
+ * @file graph/graph_workspace.h
+ * @brief Reusable memory for graph algorithms
+ * @ingroup graph
+ *
+ * Defines a workspace owning the temporary buffers of the traversal and
+ * shortest path algorithms so that they can be called repeatedly without any
+ * allocation.
+ */
+
+/**
+ * @defgroup graph_workspace Shortest path workspace
+ * @ingroup graph
+ * @{
+ */
+
+/**
+ * @brief heap_view_t of graph_weight_t distances with the lowest at the root
+ *
+ * Defines weight_heap_get_root() and weight_heap_update_up() (see
+ * DEFINE_HEAP_VIEW), used by the shortest path algorithms on the heap of the
+ * workspace.
+ */
+DEFINE_HEAP_VIEW(weight_heap, graph_weight_t, a < b)
+
+/**
+ * @brief Decreases the key of v to d, inserting v if it is not in the heap
+ *
+ * The indexes of the heap must be a permutation of the vertices, the ones at
+ * a position lower than heap_view#size being in the heap. This allows to
+ * start from an empty heap (size set to 0) and to push only the reached
+ * vertices instead of filling it with graph_sp_workspace_heap().
+ *
+ * _Complexity:_ \f$O(\log n)\f$
+ *
+ * @param heap heap of graph_weight_t distances, usually the one of a workspace
+ * @param v vertex to insert or update
+ * @param d new distance of v, lower than or equal to its current one
+ */
+static inline void weight_heap_push_vertex(heap_view_t* heap,
+										   unsigned v,
+										   graph_weight_t d) {
+	const unsigned pos = heap->idx_to_pos[v];
+	if (pos >= heap->size) {
+		// Swaps v with the first vertex outside of the heap
+		const unsigned other = heap->pos_to_idx[heap->size];
+		heap->idx_to_pos[other] = pos;
+		heap->pos_to_idx[pos] = other;
+		heap->idx_to_pos[v] = heap->size;
+		heap->pos_to_idx[heap->size] = v;
+		heap->size++;
+	}
+	weight_heap_update_up(heap, v, d);
+}
+
+/**
+ * @typedef graph_sp_workspace_t
+ * @brief Typedef for the graph_sp_workspace structure
+ */
+typedef struct graph_sp_workspace graph_sp_workspace_t;
+
+/**
+ * @struct graph_sp_workspace
+ * @brief Temporary buffers of the graph algorithms
+ *
+ * A workspace is created for a number of vertices and can be given to the
+ * `_ws` variant of every traversal and shortest path algorithm of graph_list_t
+ * and graph_mat_t with at most #nb_vert vertices (for instance
+ * graph_list_dijkstra_ws()). The other variants create and free a workspace
+ * at each call.
+ *
+ * The marks are version-stamped: a vertex v is marked during the current
+ * algorithm iif mark[v] >= #stamp, so that unmarking every vertex only
+ * increments #stamp instead of clearing the array.
+ *
+ * A workspace can only be used by one algorithm at a time.
+ */
+struct graph_sp_workspace {
+	unsigned nb_vert;
+	/**< Maximum number of vertices of the graphs */
+	unsigned* mark;
+	/**< Version-stamped marks of the vertices */
+	unsigned stamp;
+	/**< Stamp of the current algorithm */
+	unsigned* num;
+	/**< Array of size 2 * #nb_vert for the topological orderings */
+	unsigned* degree;
+	/**< Array of size #nb_vert for the degrees of the vertices */
+	graph_weight_t* distance;
+	/**< Array of size #nb_vert of distances */
+	heap_view_t* heap;
+	/**< Heap of #nb_vert indexes, its data is set by the algorithm using it */
+	dary_heap_t* dary_heap;
+	/**< d-ary heap of #nb_vert vertices used by Dijkstra when the library is
+	 * built with DIJKSTRA_DARY_HEAP_ARITY, NULL otherwise */
+	circular_buffer_t* waiting_list;
+	/**< Queue or stack of #nb_vert vertices */
+};
+
+/**
+ * @brief Creates a workspace for graphs up to nb_vert vertices
+ *
+ * __Every workspace created with this function should be freed using
+ * free_graph_sp_workspace__
+ *
+ * @param nb_vert maximum number of vertices of the graphs (should be strictly
+ * positive)
+ * @return a pointer to the newly created workspace or NULL if the function
+ * failed
+ */
+graph_sp_workspace_t* create_graph_sp_workspace(unsigned nb_vert);
+
+/**
+ * @brief Frees a workspace
+ * @param ws pointer to the workspace
+ */
+void free_graph_sp_workspace(graph_sp_workspace_t* ws);
+
+/**
+ * @brief Prepares the workspace for a new algorithm
+ *
+ * Unmarks every vertex and empties the waiting list.
+ *
+ * _Complexity:_ \f$O(1)\f$ (amortized)
+ *
+ * Makes the two next values of the stamp available: graph_sp_workspace#stamp
+ * for a first mark state and graph_sp_workspace#stamp + 1 for a second one.
+ * @param ws pointer to the workspace
+ */
+void graph_sp_workspace_reset(graph_sp_workspace_t* ws);
+
+/**
+ * @brief Sets the mark state of a vertex
+ * @param ws pointer to the workspace
+ * @param v index of the vertex
+ * @param state 1 or 2
+ */
+static inline void graph_sp_workspace_set_mark(graph_sp_workspace_t* ws,
+											   unsigned v,
+											   unsigned state) {
+	ws->mark[v] = ws->stamp + state - 1;
+}
+
+/**
+ * @brief Gets the mark state of a vertex
+ * @param ws pointer to the workspace
+ * @param v index of the vertex
+ * @return 0 if the vertex was not marked since the last call to
+ * graph_sp_workspace_reset(), its mark state otherwise
+ */
+static inline unsigned graph_sp_workspace_get_mark(graph_sp_workspace_t* ws,
+												   unsigned v) {
+	return ws->mark[v] >= ws->stamp ? ws->mark[v] - ws->stamp + 1 : 0;
+}
+
+/**
+ * @brief Fills the heap of the workspace with n vertices
+ *
+ * Every vertex from 0 to n - 1 is put in the heap whose data is set to
+ * distance, with the vertex r at the root. This is a valid heap as long as
+ * distance[r] is the lowest value of distance.
+ *
+ * The element size and comparison function of the heap stay the ones of
+ * graph_weight_t, which the functions generated by DEFINE_HEAP_VIEW() ignore:
+ * distance can be an array of another weight type as long as the heap is only
+ * used through such functions (see graph/graph_typed.h).
+ *
+ * _Complexity:_ \f$O(n)\f$
+ *
+ * @param ws pointer to the workspace
+ * @param n number of vertices (at most graph_sp_workspace#nb_vert)
+ * @param r root of the heap
+ * @param distance data of the heap, graph_weight_t distances by default
+ * @return the heap of the workspace
+ */
+heap_view_t* graph_sp_workspace_heap(graph_sp_workspace_t* ws,
+									 unsigned n,
+									 unsigned r,
+									 void* distance);
+
+/** @} */
+
+#endif	// !GRAPH_WORKSPACE_H
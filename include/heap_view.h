@@ -3,6 +3,8 @@
 
 #include <stdlib.h>
 #include "compare.h"
+#include "errors.h"
+#include "structures.h"
 
 typedef unsigned (*getid_fn_t)(void*);
 
@@ -105,6 +107,46 @@ heap_view_t* create_heap_no_check(unsigned size,
 								  void* data,
 								  compare_fn_t compare);
 
+/**
+ * @brief Create a heap from an array in any order
+ *
+ * The first *size* elements of the array referenced by data are put in the
+ * heap and their indexes are ordered by Floyd's bottom-up construction, which
+ * is linear instead of the \f$O(n\ln{n})\f$ of *size* calls to
+ * insert_heap(). The array is not modified.
+ *
+ * Complexity: O(size + capacity)
+ * @param capacity Number max of element that will be added to the heap
+ * @param size Number of elements of data to put in the heap
+ * @param size_bytes Size (in bytes) of an element of data
+ * @param data Pointer to an array of *capacity* elements
+ * @param compare Pointer to a function which takes two pointers to elements of
+ * data
+ * @return A pointer to the newly created heap or NULL if size > capacity or in
+ * case of allocation failure
+ */
+heap_view_t* create_heap_heapify(unsigned capacity,
+								 unsigned size,
+								 size_t size_bytes,
+								 void* data,
+								 compare_fn_t compare);
+
+/**
+ * @brief Insert several elements into the heap
+ *
+ * The count elements of elems are copied into heap_view#data at the first
+ * indexes out of the heap as by count calls to insert_heap(). When count is at
+ * least the size of the heap, the whole heap is rebuilt bottom-up instead.
+ *
+ * Complexity: O(min(count * ln(n), n))
+ * @param heap pointer to the heap
+ * @param elems pointer to an array of count elements
+ * @param count number of elements to insert
+ * @return heap->size in case of success and -ERROR_CAPACITY_EXCEEDED if the
+ * elements do not fit in the heap
+ */
+int heap_insert_many(heap_view_t* heap, void* elems, unsigned count);
+
 /**
  * @brief Return the maximum element of the heap and remove it from the heap
  *
@@ -122,8 +164,9 @@ int heap_get_root(heap_view_t* heap);
  * The memory referenced by *elem* pointer should be of heap_view#size_bytes
  * bytes.<br>
  * These bytes will be copied into heap_view#data at index
- * heap_view#size and the index will be rearranged to keep the structure of a
- * heap.
+ * heap_view#pos_to_idx[heap_view#size], the first index out of the heap
+ * (heap_view#size if no element was removed from the heap), and the index
+ * will be rearranged to keep the structure of a heap.
  *
  * Complexity: O(ln(n))
  * @param heap pointer to the heap
@@ -147,6 +190,68 @@ int insert_heap(heap_view_t* heap, void* elem);
  */
 void heap_update_up(heap_view_t* heap, unsigned int idx, void* elem);
 
+/**
+ * @brief Update the value of an element of the heap toward -inf
+ *
+ * Update the value of the element idx of the heap.
+ * The value passed by parameter elem should be lower than the current value
+ * according to the comparison function heap_view#compare
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @param idx Index of the element to be updated, it should be in the heap
+ * @param elem Pointer to the new value of the idx-th element
+ */
+void heap_update_down(heap_view_t* heap, unsigned int idx, void* elem);
+
+/**
+ * @brief Update the value of an element of the heap in any direction
+ *
+ * Calls heap_update_up() or heap_update_down() depending on the comparison
+ * of elem with the current value of the idx-th element.
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @param idx Index of the element to be updated, it should be in the heap
+ * @param elem Pointer to the new value of the idx-th element
+ */
+void heap_update(heap_view_t* heap, unsigned int idx, void* elem);
+
+/**
+ * @brief Remove an element from the heap
+ *
+ * The element idx is moved out of the heap, its value in heap_view#data is
+ * left untouched. It is the next index used by insert_heap().
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @param idx Index of the element to remove
+ * @return idx or -ERROR_INVALID_PARAM2 if idx is not in the heap
+ */
+int heap_remove(heap_view_t* heap, unsigned int idx);
+
+/**
+ * @brief Return the maximum element of the heap without removing it
+ *
+ * Complexity: O(1)
+ * @param heap Pointer to the heap
+ * @return The index of the top element of the heap or -ERROR_IS_EMPTY if the
+ * heap is empty
+ */
+int heap_peek(const heap_view_t* heap);
+
+/**
+ * @brief Test if an element is in the heap
+ *
+ * Complexity: O(1)
+ * @param heap Pointer to the heap
+ * @param idx Index of the element
+ * @return TRUE if idx is lower than heap_view#capacity and is in the heap
+ */
+static inline BOOL heap_contains(const heap_view_t* heap, unsigned int idx) {
+	return idx < heap->capacity && heap->idx_to_pos[idx] < heap->size;
+}
+
 /**
  * @brief Free a heap
  *
@@ -159,6 +264,232 @@ void heap_update_up(heap_view_t* heap, unsigned int idx, void* elem);
  */
 void free_heap(heap_view_t* heap);
 
+/**
+ * @brief Sort an array in increasing order
+ *
+ * The array is made a heap in place then its maximum is moved at the end
+ * until the heap is empty. The sort is not stable and needs no memory.
+ * Sort with a reversed comparison (see DEFINE_COMPARE_MIN_SCALAR) to get
+ * the decreasing order.
+ *
+ * Complexity: O(n ln(n))
+ * @param data Pointer to an array of size elements
+ * @param size Number of elements of the array
+ * @param size_bytes Size (in bytes) of an element of data
+ * @param compare Pointer to a function which takes two pointers to elements of
+ * data
+ */
+void heap_sort(void* data,
+			   unsigned size,
+			   size_t size_bytes,
+			   compare_fn_t compare);
+
+/**
+ * @brief Sort the k lowest elements of an array
+ *
+ * After the call the k first elements of data are the k lowest elements in
+ * increasing order, the other elements are left in an unspecified order. Use
+ * a reversed comparison to get the k greatest elements in decreasing order.
+ *
+ * Complexity: O(n ln(k))
+ * @param data Pointer to an array of size elements
+ * @param size Number of elements of the array
+ * @param k Number of elements to select (at most size)
+ * @param size_bytes Size (in bytes) of an element of data
+ * @param compare Pointer to a function which takes two pointers to elements of
+ * data
+ */
+void partial_sort(void* data,
+				  unsigned size,
+				  unsigned k,
+				  size_t size_bytes,
+				  compare_fn_t compare);
+
+/**
+ * @brief Defines a heap_view_t specialized for a key type
+ *
+ * The functions of heap_view.h compare the elements through
+ * heap_view#compare, a call through a pointer for each step of a sift whose
+ * result is then compared to 1 or -1. This macro defines static inline
+ * functions working on the same heap_view_t structure but comparing the keys
+ * with less_expr, an expression of the two keys a and b of type type which is
+ * true if a should be above b, so that the compiler can inline the
+ * comparisons. heap_view#compare and heap_view#size_bytes are ignored by these
+ * functions and heap_view#data should be an array of type.
+ *
+ * The functions defined are, for a name prefix:
+ * | function                            | behaves like                   |
+ * |-------------------------------------|--------------------------------|
+ * | name_peek(heap)                     | heap_peek()                    |
+ * | name_get_root(heap)                 | heap_get_root()                |
+ * | name_insert(heap, key)              | insert_heap()                  |
+ * | name_insert_many(heap, keys, count) | heap_insert_many()             |
+ * | name_update_up(heap, idx, key)      | heap_update_up()               |
+ * | name_update_down(heap, idx, key)    | heap_update_down()             |
+ * | name_update(heap, idx, key)         | heap_update()                  |
+ * | name_remove(heap, idx)              | heap_remove()                  |
+ * | name_heapify(heap)                  | create_heap_heapify() ordering |
+ *
+ * They break the ties as the functions of heap_view.h, so both can be used on
+ * the same heap. When a node has two children, the one to follow is selected
+ * by adding the result of the comparison to the position of the left child
+ * rather than by a branch; the single child of the last father is handled
+ * after the loop. A full heap or an index out of the heap is reported by the
+ * returned error code only, the checks of test_macros.h not being used.
+ *
+ * For instance `DEFINE_HEAP_VIEW(weight_heap, graph_weight_t, a < b)` defines
+ * weight_heap_get_root(), weight_heap_update_up()... behaving like
+ * heap_get_root(), heap_update_up()... on a heap created with
+ * compare_min_graph_weight_t.
+ *
+ * @param name prefix of the functions
+ * @param type type of the keys
+ * @param less_expr expression of a and b, true if a has priority over b
+ */
+#define DEFINE_HEAP_VIEW(name, type, less_expr)                              \
+	static inline BOOL name##_less(type a, type b) {                         \
+		return (less_expr);                                                  \
+	}                                                                        \
+                                                                             \
+	static inline type name##_key(const heap_view_t* heap, unsigned pos) {   \
+		return ((const type*)heap->data)[heap->pos_to_idx[pos]];             \
+	}                                                                        \
+                                                                             \
+	static inline void name##_pullup(heap_view_t* heap, unsigned n) {        \
+		const unsigned idx = heap->pos_to_idx[n];                            \
+		const type key = ((const type*)heap->data)[idx];                     \
+		while (n != 0) {                                                     \
+			const unsigned father = (n - 1) / 2;                             \
+			const unsigned fidx = heap->pos_to_idx[father];                  \
+			if (!name##_less(key, ((const type*)heap->data)[fidx]))          \
+				break;                                                       \
+			heap->idx_to_pos[fidx] = n;                                      \
+			heap->pos_to_idx[n] = fidx;                                      \
+			n = father;                                                      \
+		}                                                                    \
+		heap->idx_to_pos[idx] = n;                                           \
+		heap->pos_to_idx[n] = idx;                                           \
+	}                                                                        \
+                                                                             \
+	static inline void name##_pulldown(heap_view_t* heap, unsigned n) {      \
+		const unsigned idx = heap->pos_to_idx[n];                            \
+		const type key = ((const type*)heap->data)[idx];                     \
+		const unsigned size = heap->size;                                    \
+		unsigned child;                                                      \
+		/* Nodes with two children, the right one winning the ties as in     \
+		 * heap_view.c */                                                    \
+		while ((child = 2 * n + 1) + 1 < size) {                             \
+			child += !name##_less(name##_key(heap, child),                   \
+								  name##_key(heap, child + 1));              \
+			if (!name##_less(name##_key(heap, child), key))                  \
+				break;                                                       \
+			const unsigned cidx = heap->pos_to_idx[child];                   \
+			heap->idx_to_pos[cidx] = n;                                      \
+			heap->pos_to_idx[n] = cidx;                                      \
+			n = child;                                                       \
+		}                                                                    \
+		/* The last father can have a single child. After a break, child is \
+		 * not above key and nothing moves */                                \
+		if (child < size && name##_less(name##_key(heap, child), key)) {     \
+			const unsigned cidx = heap->pos_to_idx[child];                   \
+			heap->idx_to_pos[cidx] = n;                                      \
+			heap->pos_to_idx[n] = cidx;                                      \
+			n = child;                                                       \
+		}                                                                    \
+		heap->idx_to_pos[idx] = n;                                           \
+		heap->pos_to_idx[n] = idx;                                           \
+	}                                                                        \
+                                                                             \
+	static inline int name##_peek(const heap_view_t* heap) {                 \
+		if (heap->size == 0)                                                 \
+			return -ERROR_IS_EMPTY;                                          \
+		return heap->pos_to_idx[0];                                          \
+	}                                                                        \
+                                                                             \
+	static inline int name##_get_root(heap_view_t* heap) {                   \
+		if (heap->size == 0)                                                 \
+			return -ERROR_IS_EMPTY;                                          \
+		const unsigned root = heap->pos_to_idx[0];                           \
+		const unsigned last = heap->pos_to_idx[--heap->size];                \
+		heap->idx_to_pos[root] = heap->size;                                 \
+		heap->pos_to_idx[heap->size] = root;                                 \
+		if (heap->size > 0) {                                                \
+			heap->idx_to_pos[last] = 0;                                      \
+			heap->pos_to_idx[0] = last;                                      \
+			name##_pulldown(heap, 0);                                        \
+		}                                                                    \
+		return root;                                                         \
+	}                                                                        \
+                                                                             \
+	static inline int name##_insert(heap_view_t* heap, type key) {           \
+		if (heap->size >= heap->capacity)                                    \
+			return -ERROR_CAPACITY_EXCEEDED;                                 \
+		((type*)heap->data)[heap->pos_to_idx[heap->size]] = key;             \
+		name##_pullup(heap, heap->size);                                     \
+		return ++heap->size;                                                 \
+	}                                                                        \
+                                                                             \
+	static inline void name##_heapify(heap_view_t* heap) {                   \
+		for (unsigned n = heap->size / 2; n > 0; n--)                        \
+			name##_pulldown(heap, n - 1);                                    \
+	}                                                                        \
+                                                                             \
+	static inline int name##_insert_many(heap_view_t* heap,                  \
+										 const type* keys, unsigned count) { \
+		if (count > heap->capacity - heap->size)                             \
+			return -ERROR_CAPACITY_EXCEEDED;                                 \
+		for (unsigned i = 0; i < count; i++)                                 \
+			((type*)heap->data)[heap->pos_to_idx[heap->size + i]] = keys[i]; \
+		if (count >= heap->size) {                                           \
+			heap->size += count;                                             \
+			name##_heapify(heap);                                            \
+		} else {                                                             \
+			for (unsigned i = 0; i < count; i++)                             \
+				name##_pullup(heap, heap->size++);                           \
+		}                                                                    \
+		return heap->size;                                                   \
+	}                                                                        \
+                                                                             \
+	static inline void name##_update_up(heap_view_t* heap, unsigned idx,     \
+										type key) {                          \
+		((type*)heap->data)[idx] = key;                                      \
+		name##_pullup(heap, heap->idx_to_pos[idx]);                          \
+	}                                                                        \
+                                                                             \
+	static inline void name##_update_down(heap_view_t* heap, unsigned idx,   \
+										  type key) {                        \
+		((type*)heap->data)[idx] = key;                                      \
+		name##_pulldown(heap, heap->idx_to_pos[idx]);                        \
+	}                                                                        \
+                                                                             \
+	static inline void name##_update(heap_view_t* heap, unsigned idx,        \
+									 type key) {                             \
+		const BOOL up = name##_less(key, ((const type*)heap->data)[idx]);    \
+		((type*)heap->data)[idx] = key;                                      \
+		if (up)                                                              \
+			name##_pullup(heap, heap->idx_to_pos[idx]);                      \
+		else                                                                 \
+			name##_pulldown(heap, heap->idx_to_pos[idx]);                    \
+	}                                                                        \
+                                                                             \
+	static inline int name##_remove(heap_view_t* heap, unsigned idx) {       \
+		if (!heap_contains(heap, idx))                                       \
+			return -ERROR_INVALID_PARAM2;                                    \
+		const unsigned pos = heap->idx_to_pos[idx];                          \
+		const unsigned last = heap->pos_to_idx[heap->size - 1];              \
+		heap->idx_to_pos[idx] = heap->size - 1;                              \
+		heap->pos_to_idx[heap->size - 1] = idx;                              \
+		heap->idx_to_pos[last] = pos;                                        \
+		heap->pos_to_idx[pos] = last;                                        \
+		heap->size--;                                                        \
+		if (pos < heap->size) {                                              \
+			/* The last element replaces idx and can go either way */        \
+			name##_pullup(heap, pos);                                        \
+			name##_pulldown(heap, heap->idx_to_pos[last]);                   \
+		}                                                                    \
+		return idx;                                                          \
+	}
+
 /** @} */  // end of heap_view
 
 #endif
@@ -0,0 +1,158 @@
+#ifndef STRUCT_MINMAX_HEAP_H
+#define STRUCT_MINMAX_HEAP_H
+
+#include <stddef.h>
+#include "compare.h"
+#include "structures.h"
+
+/**
+ * @file minmax_heap.h
+ * @brief Indexed min-max heaps
+ * @ingroup minmax_heap
+ *
+ * Defines a double-ended priority queue giving both its minimum and its
+ * maximum
+ */
+
+/**
+ * @defgroup minmax_heap Min-max heaps
+ *
+ * A min-max heap is a binary heap whose even levels (the root is at level 0)
+ * are ordered as a min-heap and odd levels as a max-heap: the minimum is the
+ * root and the maximum one of its two children. Both ends are found in
+ * \f$O(1)\f$ and removed in \f$O(\log{n})\f$.
+ *
+ * As heap_view_t, a min-max heap is a view ordering the indexes of the
+ * elements of an array it does not own, with the position of every index in
+ * #idx_to_pos so that any element can be removed.
+ * @{
+ */
+
+/**
+ * @typedef minmax_heap_t
+ * @brief Typedef for the minmax_heap structure
+ */
+typedef struct minmax_heap minmax_heap_t;
+
+/**
+ * @struct minmax_heap
+ * @brief An indexed min-max heap
+ *
+ * The fields have the meaning of the fields of heap_view_t.
+ */
+struct minmax_heap {
+	compare_fn_t compare;
+	/**< function used to compare two elements of #data */
+	void* data;
+	/**< value + idx * size_bytes is the value of the idx-th element */
+	unsigned* idx_to_pos;
+	/**< idx_to_pos[idx] is the position of the idx-th element in the heap */
+	unsigned* pos_to_idx;
+	/**< pos_to_idx[pos] is the index of the element at the position pos */
+	unsigned size;
+	/**< Number of elements in the heap */
+	size_t size_bytes;
+	/**< Size (in bytes) of an element of the array referenced by data */
+	unsigned capacity;
+	/**< Maximum number of element that the heap can contain */
+};
+
+/**
+ * @brief Create an empty min-max heap with a fixed capacity
+ *
+ * __Every heap created with this function should be freed using
+ * free_minmax_heap__
+ *
+ * @param capacity Number max of element that will be added to the heap
+ * @param size_bytes Size (in bytes) of an element of data
+ * @param data Pointer to an array of *capacity* elements, which is not freed
+ * by the heap
+ * @param compare Pointer to a function which takes two pointers to elements of
+ * data
+ * @return A pointer to the newly created heap or NULL if the function failed
+ */
+minmax_heap_t* create_minmax_heap(unsigned capacity,
+								  size_t size_bytes,
+								  void* data,
+								  compare_fn_t compare);
+
+/**
+ * @brief Free a min-max heap, but not its data
+ * @param heap Pointer to the heap
+ */
+void free_minmax_heap(minmax_heap_t* heap);
+
+/**
+ * @brief Insert an element into the heap
+ *
+ * The bytes referenced by elem are copied into data at the first index out of
+ * the heap, minmax_heap#pos_to_idx[minmax_heap#size].
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @param elem Pointer to the element to insert
+ * @return the index of the element or -ERROR_CAPACITY_EXCEEDED if the heap is
+ * full
+ */
+int minmax_heap_insert(minmax_heap_t* heap, void* elem);
+
+/**
+ * @brief Index of the minimum element
+ *
+ * Complexity: O(1)
+ * @param heap Pointer to the heap
+ * @return the index or -ERROR_IS_EMPTY if the heap is empty
+ */
+int minmax_heap_peek_min(const minmax_heap_t* heap);
+
+/**
+ * @brief Index of the maximum element
+ *
+ * Complexity: O(1)
+ * @param heap Pointer to the heap
+ * @return the index or -ERROR_IS_EMPTY if the heap is empty
+ */
+int minmax_heap_peek_max(const minmax_heap_t* heap);
+
+/**
+ * @brief Remove the minimum element
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @return the index of the element or -ERROR_IS_EMPTY if the heap is empty
+ */
+int minmax_heap_pop_min(minmax_heap_t* heap);
+
+/**
+ * @brief Remove the maximum element
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @return the index of the element or -ERROR_IS_EMPTY if the heap is empty
+ */
+int minmax_heap_pop_max(minmax_heap_t* heap);
+
+/**
+ * @brief Remove an element from the heap
+ *
+ * Complexity: O(ln(n))
+ * @param heap Pointer to the heap
+ * @param idx Index of the element
+ * @return idx or -ERROR_INVALID_PARAM2 if idx is not in the heap
+ */
+int minmax_heap_remove(minmax_heap_t* heap, unsigned idx);
+
+/**
+ * @brief Test if an element is in the heap
+ * @param heap Pointer to the heap
+ * @param idx Index of the element
+ * @return TRUE if idx is lower than minmax_heap#capacity and is in the heap
+ */
+static inline BOOL minmax_heap_contains(const minmax_heap_t* heap,
+										unsigned idx) {
+	return idx < heap->capacity && heap->idx_to_pos[idx] < heap->size;
+}
+
+/** @} */
+
+#endif	// !STRUCT_MINMAX_HEAP_H
@@ -0,0 +1,151 @@
+#ifndef STRUCT_MULTIQUEUE_H
+#define STRUCT_MULTIQUEUE_H
+
+#include "prng.h"
+#include "structures.h"
+#include "weight_type.h"
+
+/**
+ * @file multiqueue.h
+ * @brief Concurrent relaxed priority queues
+ * @ingroup multiqueue
+ *
+ * Defines a priority queue shared by threads which trades the exact order of
+ * the removals for scalability
+ */
+
+/**
+ * @defgroup multiqueue MultiQueues
+ *
+ * A MultiQueue is made of c * t binary heaps for t threads, each one
+ * protected by its own spin lock. An insertion goes to a random heap, a
+ * removal takes the root of the better of two random heaps. A thread never
+ * waits for a lock: if the lock of the chosen heap is taken it chooses
+ * again. The key removed is not always the lowest key but its rank is
+ * expected to be O(c * t), which is enough for parallel shortest paths (a
+ * vertex settled too early is relaxed again) or job scheduling.
+ *
+ * Each thread draws the heaps with its own prng_t. The heaps are padded to
+ * a cache line so that two threads working on neighbouring heaps do not
+ * share a line.
+ * @{
+ */
+
+/**
+ * @typedef multiqueue_entry_t
+ * @brief Typedef for the multiqueue_entry structure
+ */
+typedef struct multiqueue_entry multiqueue_entry_t;
+
+/**
+ * @struct multiqueue_entry
+ * @brief A value with its key
+ */
+struct multiqueue_entry {
+	graph_weight_t key; /**< Key of the value */
+	unsigned value;		/**< Value */
+};
+
+/**
+ * @typedef multiqueue_heap_t
+ * @brief Typedef for the multiqueue_heap union
+ */
+typedef union multiqueue_heap multiqueue_heap_t;
+
+/**
+ * @union multiqueue_heap
+ * @brief A binary heap behind a lock, padded to a cache line
+ */
+union multiqueue_heap {
+	struct {
+		multiqueue_entry_t* entries;
+		/**< Heap array of #capacity entries */
+		unsigned size;
+		/**< Number of entries */
+		unsigned capacity;
+		/**< Number of entries which fit in #entries */
+		graph_weight_t top;
+		/**< Key of the root, GRAPH_WEIGHT_INF if the heap is empty. It is
+		 * read without the lock to choose the heap of a removal */
+		int lock;
+		/**< 1 while a thread works on the heap */
+	} h;
+	char line[64];
+	/**< Padding to a cache line */
+};
+
+/**
+ * @typedef multiqueue_t
+ * @brief Typedef for the multiqueue structure
+ */
+typedef struct multiqueue multiqueue_t;
+
+/**
+ * @struct multiqueue
+ * @brief A relaxed priority queue shared by threads
+ */
+struct multiqueue {
+	multiqueue_heap_t* heaps;
+	/**< Array of #nb_heaps heaps aligned on a cache line */
+	void* memory;
+	/**< Allocated memory of #heaps before alignment */
+	unsigned nb_heaps;
+	/**< Number of heaps */
+};
+
+/**
+ * @brief Creates an empty MultiQueue
+ *
+ * __Every MultiQueue created with this function should be freed using
+ * free_multiqueue__
+ *
+ * @param nb_threads number of threads using the MultiQueue
+ * @param c number of heaps per thread (usually 2 to 4)
+ * @return a pointer to the MultiQueue or NULL if the function failed
+ */
+multiqueue_t* create_multiqueue(unsigned nb_threads, unsigned c);
+
+/**
+ * @brief Frees the MultiQueue
+ *
+ * No thread should be using the MultiQueue.
+ *
+ * @param mq pointer to the MultiQueue
+ */
+void free_multiqueue(multiqueue_t* mq);
+
+/**
+ * @brief Inserts a value in a random heap
+ *
+ * _Complexity:_ \f$O(\ln{n})\f$ amortized
+ *
+ * @param mq pointer to the MultiQueue
+ * @param rng random generator of the calling thread
+ * @param key key of the value (lower than GRAPH_WEIGHT_INF)
+ * @param value value (at most INT_MAX)
+ * @return -ERROR_NO_ERROR or -ERROR_ALLOCATION_FAILED
+ */
+int multiqueue_push(multiqueue_t* mq,
+					prng_t* rng,
+					graph_weight_t key,
+					unsigned value);
+
+/**
+ * @brief Removes the value of lowest key of the better of two random heaps
+ *
+ * When the two heaps are empty the others are tried in order, so that
+ * -ERROR_IS_EMPTY is only returned if every heap was found empty. With
+ * concurrent insertions it does not mean that the MultiQueue is still empty.
+ *
+ * _Complexity:_ \f$O(\ln{n})\f$
+ *
+ * @param mq pointer to the MultiQueue
+ * @param rng random generator of the calling thread
+ * @param[out] key key of the value (facultative, can be left NULL)
+ * @return the value or -ERROR_IS_EMPTY
+ */
+int multiqueue_pop(multiqueue_t* mq, prng_t* rng, graph_weight_t* key);
+
+/** @} */
+
+#endif	// !STRUCT_MULTIQUEUE_H
@@ -0,0 +1,191 @@
+#ifndef STRUCT_PAIRING_HEAP_H
+#define STRUCT_PAIRING_HEAP_H
+
+#include <stddef.h>
+#include "structures.h"
+#include "weight_type.h"
+
+/**
+ * @file pairing_heap.h
+ * @brief Meldable pairing heaps of graph_weight_t keys
+ * @ingroup pairing_heap
+ *
+ * Defines min pairing heaps whose nodes are allocated from a shared pool
+ */
+
+/**
+ * @defgroup pairing_heap Pairing heaps
+ *
+ * A pairing heap is a tree whose root has the lowest key, each node holding
+ * the list of its children. Two heaps are melded by linking their roots in
+ * \f$O(1)\f$, and a decrease-key cuts the subtree of the node and links it to
+ * the root in \f$O(1)\f$. Only the removal of the root does the work: its
+ * children are melded by pairs from left to right, then the pairs are melded
+ * from right to left, in \f$O(\log{n})\f$ amortized.
+ *
+ * The nodes are allocated by chunks from a pairing_pool_t, which keeps the
+ * nodes of the popped elements in a free list for the next insertions. The
+ * heaps using the same pool can be melded together.
+ * @{
+ */
+
+/**
+ * @typedef pairing_node_t
+ * @brief Typedef for the pairing_node structure
+ */
+typedef struct pairing_node pairing_node_t;
+
+/**
+ * @struct pairing_node
+ * @brief A node of a pairing heap
+ */
+struct pairing_node {
+	graph_weight_t key;
+	/**< Key of the node */
+	unsigned value;
+	/**< Value associated to the key */
+	pairing_node_t* child;
+	/**< First child */
+	pairing_node_t* next;
+	/**< Next sibling, or next free node when the node is in the free list */
+	pairing_node_t* prev;
+	/**< Previous sibling, or the parent for a first child */
+};
+
+/**
+ * @typedef pairing_pool_t
+ * @brief Typedef for the pairing_pool structure
+ */
+typedef struct pairing_pool pairing_pool_t;
+
+/**
+ * @struct pairing_pool
+ * @brief Allocator of the nodes of pairing heaps
+ */
+struct pairing_pool {
+	void* chunks;
+	/**< Linked list of the allocated chunks */
+	pairing_node_t* free;
+	/**< List of the free nodes linked by pairing_node#next */
+	unsigned chunk_size;
+	/**< Number of nodes of a chunk */
+};
+
+/**
+ * @typedef pairing_heap_t
+ * @brief Typedef for the pairing_heap structure
+ */
+typedef struct pairing_heap pairing_heap_t;
+
+/**
+ * @struct pairing_heap
+ * @brief A min pairing heap
+ */
+struct pairing_heap {
+	pairing_node_t* root;
+	/**< Node with the lowest key, NULL if the heap is empty */
+	unsigned size;
+	/**< Number of nodes */
+	pairing_pool_t* pool;
+	/**< Pool allocating the nodes */
+};
+
+/**
+ * @brief Creates a node pool
+ *
+ * __Every pool created with this function should be freed using
+ * free_pairing_pool, after the heaps using it__
+ *
+ * @param chunk_size number of nodes allocated at once (strictly positive)
+ * @return a pointer to the pool or NULL if the function failed
+ */
+pairing_pool_t* create_pairing_pool(unsigned chunk_size);
+
+/**
+ * @brief Frees the pool and every node it allocated
+ * @param pool pointer to the pool
+ */
+void free_pairing_pool(pairing_pool_t* pool);
+
+/**
+ * @brief Initializes an empty pairing heap
+ * @param heap pointer to the heap
+ * @param pool pool allocating the nodes of the heap
+ */
+void pairing_heap_init(pairing_heap_t* heap, pairing_pool_t* pool);
+
+/**
+ * @brief Gives back every node of the heap to its pool
+ *
+ * _Complexity:_ \f$O(n)\f$
+ *
+ * @param heap pointer to the heap, which is empty afterwards
+ */
+void pairing_heap_clear(pairing_heap_t* heap);
+
+/**
+ * @brief Inserts a key
+ *
+ * _Complexity:_ \f$O(1)\f$
+ *
+ * @param heap pointer to the heap
+ * @param key key of the node
+ * @param value value associated to the key (at most INT_MAX)
+ * @return the node, valid until it is popped, or NULL if the allocation of a
+ * chunk failed
+ */
+pairing_node_t* pairing_heap_insert(pairing_heap_t* heap,
+									graph_weight_t key,
+									unsigned value);
+
+/**
+ * @brief Moves every node of other to heap
+ *
+ * The two heaps should use the same pool.
+ *
+ * _Complexity:_ \f$O(1)\f$
+ *
+ * @param heap pointer to the heap receiving the nodes
+ * @param other pointer to the heap which is empty afterwards
+ */
+void pairing_heap_meld(pairing_heap_t* heap, pairing_heap_t* other);
+
+/**
+ * @brief Decreases the key of a node of the heap
+ *
+ * Nothing is done if key is not lower than the key of the node.
+ *
+ * _Complexity:_ \f$O(1)\f$, \f$O(\log{n})\f$ amortized
+ *
+ * @param heap pointer to the heap containing node
+ * @param node node returned by pairing_heap_insert()
+ * @param key new key of the node
+ */
+void pairing_heap_decrease_key(pairing_heap_t* heap,
+							   pairing_node_t* node,
+							   graph_weight_t key);
+
+/**
+ * @brief Removes the node of lowest key
+ *
+ * The node is given back to the pool.
+ *
+ * _Complexity:_ \f$O(\log{n})\f$ amortized
+ *
+ * @param heap pointer to the heap
+ * @param[out] key key of the node (facultative, can be left NULL)
+ * @return the value of the node or -ERROR_IS_EMPTY if the heap is empty
+ */
+int pairing_heap_pop(pairing_heap_t* heap, graph_weight_t* key);
+
+/**
+ * @brief Tests if the heap is empty
+ * @param heap pointer to the heap
+ */
+static inline BOOL pairing_heap_empty(const pairing_heap_t* heap) {
+	return heap->root == NULL;
+}
+
+/** @} */
+
+#endif	// !STRUCT_PAIRING_HEAP_H
@@ -0,0 +1,157 @@
+#ifndef STRUCT_PRIORITY_QUEUE_H
+#define STRUCT_PRIORITY_QUEUE_H
+
+#include <stddef.h>
+#include "compare.h"
+#include "structures.h"
+
+/**
+ * @file priority_queue.h
+ * @brief Growable priority queues
+ * @ingroup priority_queue
+ *
+ * Defines a binary heap which owns its elements and grows with them
+ */
+
+/**
+ * @defgroup priority_queue Priority queues
+ *
+ * Unlike heap_view_t, a priority queue stores the elements themselves in the
+ * heap array: there is no index to follow to reach the data, and no capacity
+ * to choose beforehand since the array is reallocated geometrically. The
+ * elements can not be updated in place, use heap_view_t to change the
+ * priority of an element.
+ *
+ * As for heap_view_t, the root is the maximum element according to the
+ * compare function.
+ * @{
+ */
+
+/** Capacity of the first allocation of a priority queue */
+#define PRIORITY_QUEUE_MIN_CAPACITY 8
+
+/**
+ * @typedef priority_queue_t
+ * @brief Typedef for the priority_queue structure
+ */
+typedef struct priority_queue priority_queue_t;
+
+/**
+ * @struct priority_queue
+ * @brief A binary heap of elements of size_bytes bytes
+ */
+struct priority_queue {
+	char* data;
+	/**< Heap array of #capacity elements, the root is at 0 */
+	char* tmp;
+	/**< Room for one element moved during a sift */
+	unsigned size;
+	/**< Number of elements */
+	unsigned capacity;
+	/**< Number of elements which fit in #data */
+	size_t size_bytes;
+	/**< Size (in bytes) of an element */
+	compare_fn_t compare;
+	/**< Function used to compare two elements */
+};
+
+/**
+ * @brief Creates an empty priority queue
+ *
+ * __Every priority queue created with this function should be freed using
+ * free_priority_queue__
+ *
+ * @param size_bytes size (in bytes) of an element
+ * @param compare function comparing two elements
+ * @return a pointer to the priority queue or NULL if the function failed
+ */
+priority_queue_t* create_priority_queue(size_t size_bytes,
+										compare_fn_t compare);
+
+/**
+ * @brief Frees the priority queue and its elements
+ * @param pq pointer to the priority queue
+ */
+void free_priority_queue(priority_queue_t* pq);
+
+/**
+ * @brief Inserts a copy of an element
+ *
+ * The array is reallocated with twice its capacity if it is full.
+ *
+ * _Complexity:_ amortized \f$O(\ln{n})\f$
+ *
+ * @param pq pointer to the priority queue
+ * @param elem pointer to the element
+ * @return the new size or -ERROR_ALLOCATION_FAILED
+ */
+int priority_queue_push(priority_queue_t* pq, const void* elem);
+
+/**
+ * @brief Removes the maximum element
+ *
+ * _Complexity:_ \f$O(\ln{n})\f$
+ *
+ * @param pq pointer to the priority queue
+ * @param[out] elem the removed element is copied there (facultative, can be
+ * left NULL)
+ * @return -ERROR_NO_ERROR or -ERROR_IS_EMPTY if the priority queue is empty
+ */
+int priority_queue_pop(priority_queue_t* pq, void* elem);
+
+/**
+ * @brief Removes the maximum element and inserts an element
+ *
+ * Equivalent to a pop followed by a push with a single sift, which is the
+ * main operation of a bounded top-k or of a k-way merge.
+ *
+ * _Complexity:_ \f$O(\ln{n})\f$
+ *
+ * @param pq pointer to the priority queue
+ * @param elem pointer to the element to insert
+ * @param[out] top the removed element is copied there (facultative, can be
+ * left NULL)
+ * @return -ERROR_NO_ERROR or -ERROR_IS_EMPTY if the priority queue is empty
+ * (then nothing is inserted)
+ */
+int priority_queue_replace_top(priority_queue_t* pq,
+							   const void* elem,
+							   void* top);
+
+/**
+ * @brief Allocates room for at least capacity elements
+ * @param pq pointer to the priority queue
+ * @param capacity number of elements
+ * @return -ERROR_NO_ERROR or -ERROR_ALLOCATION_FAILED
+ */
+int priority_queue_reserve(priority_queue_t* pq, unsigned capacity);
+
+/**
+ * @brief Reduces the capacity to the size of the priority queue
+ * @param pq pointer to the priority queue
+ * @return -ERROR_NO_ERROR or -ERROR_ALLOCATION_FAILED (the priority queue is
+ * left untouched)
+ */
+int priority_queue_shrink(priority_queue_t* pq);
+
+/**
+ * @brief Maximum element of the priority queue
+ * @param pq pointer to the priority queue
+ * @return a pointer to the element, valid until the next modification, or
+ * NULL if the priority queue is empty
+ */
+static inline void* priority_queue_peek(const priority_queue_t* pq) {
+	return pq->size == 0 ? NULL : pq->data;
+}
+
+/**
+ * @brief Tests if the priority queue is empty
+ * @param pq pointer to the priority queue
+ */
+static inline BOOL priority_queue_empty(const priority_queue_t* pq) {
+	return pq->size == 0;
+}
+
+/** @} */
+
+#endif	// !STRUCT_PRIORITY_QUEUE_H
@@ -0,0 +1,87 @@
+#ifndef STRUCT_PRNG_H
+#define STRUCT_PRNG_H
+
+#include <stdint.h>
+
+/**
+ * @file prng.h
+ * @brief Seedable pseudo-random number generator
+ *
+ * Defines a small xoshiro256** generator seeded with splitmix64. For a given
+ * seed the sequence of numbers is the same on every platform, which makes
+ * randomized algorithms and benchmarks reproducible.
+ */
+
+/**
+ * @typedef prng_t
+ * @brief Typedef for the prng structure
+ */
+typedef struct prng prng_t;
+
+/**
+ * @struct prng
+ * @brief State of the generator
+ */
+struct prng {
+	uint64_t s[4]; /**< xoshiro256** state (should not be all zero) */
+};
+
+static inline uint64_t prng_splitmix64(uint64_t* x) {
+	uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/**
+ * @brief Initializes the generator from a seed
+ * @param rng pointer to the generator
+ * @param seed any 64 bits value
+ */
+static inline void prng_seed(prng_t* rng, uint64_t seed) {
+	for (int i = 0; i < 4; i++)
+		rng->s[i] = prng_splitmix64(&seed);
+}
+
+static inline uint64_t prng_rotl(uint64_t x, int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Returns the next 64 bits random value
+ * @param rng pointer to the generator
+ */
+static inline uint64_t prng_next(prng_t* rng) {
+	uint64_t* s = rng->s;
+	const uint64_t result = prng_rotl(s[1] * 5, 7) * 9;
+	const uint64_t t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = prng_rotl(s[3], 45);
+	return result;
+}
+
+/**
+ * @brief Returns a random value in [0, bound[
+ *
+ * Uses the multiply-shift reduction on the 32 high bits, bound should be
+ * strictly positive and smaller than 2^32.
+ * @param rng pointer to the generator
+ * @param bound upper bound (excluded)
+ */
+static inline uint32_t prng_bounded(prng_t* rng, uint32_t bound) {
+	return (uint32_t)(((prng_next(rng) >> 32) * (uint64_t)bound) >> 32);
+}
+
+/**
+ * @brief Returns a random double in [0, 1[
+ * @param rng pointer to the generator
+ */
+static inline double prng_double(prng_t* rng) {
+	return (double)(prng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif	// !STRUCT_PRNG_H
@@ -0,0 +1,198 @@
+#ifndef STRUCT_TIMER_WHEEL_H
+#define STRUCT_TIMER_WHEEL_H
+
+#include <stdint.h>
+#include "circular_buffer.h"
+#include "structures.h"
+
+/**
+ * @file timer_wheel.h
+ * @brief Hierarchical timer wheels
+ * @ingroup timer_wheel
+ *
+ * Defines a scheduler of timers in O(1) per timer, for large numbers of
+ * timeouts which are mostly cancelled before they expire
+ */
+
+/**
+ * @defgroup timer_wheel Timer wheels
+ *
+ * The time is counted in ticks. Level k of the wheel has
+ * TIMER_WHEEL_SLOTS slots of \f$TIMER\_WHEEL\_SLOTS^k\f$ ticks each: a timer
+ * is put in the slot of the lowest level whose range covers its delay.
+ * Each time the slots of a level have been all gone through, the next slot of
+ * the level above is emptied into the lower levels (cascade), so that a timer
+ * moves down at most TIMER_WHEEL_LEVELS - 1 times before it expires.
+ *
+ * The slots are circular_buffer_t of (timer, generation) entries which grow
+ * when they are full. Cancelling a timer only increments its generation: its
+ * entry is dropped when its slot is emptied.
+ * @{
+ */
+
+/** Number of levels of the wheel */
+#define TIMER_WHEEL_LEVELS 4
+/** Base 2 logarithm of the number of slots of a level */
+#define TIMER_WHEEL_SLOT_BITS 8
+/** Number of slots of a level */
+#define TIMER_WHEEL_SLOTS (1u << TIMER_WHEEL_SLOT_BITS)
+/** Maximum number of expired timers given at once to the callback */
+#define TIMER_WHEEL_BATCH 64
+
+/**
+ * @typedef timer_wheel_expired_t
+ * @brief Typedef for the timer_wheel_expired structure
+ */
+typedef struct timer_wheel_expired timer_wheel_expired_t;
+
+/**
+ * @struct timer_wheel_expired
+ * @brief A timer given to the expiry callback
+ */
+struct timer_wheel_expired {
+	unsigned id; /**< Identifier returned by timer_wheel_schedule() */
+	void* data;	 /**< Data given to timer_wheel_schedule() */
+};
+
+/**
+ * @brief Callback receiving a batch of expired timers
+ * @param timers array of count expired timers, by increasing expiry
+ * @param count number of timers (at most TIMER_WHEEL_BATCH)
+ * @param ctx argument given to timer_wheel_advance()
+ */
+typedef void (*timer_wheel_expire_fn)(const timer_wheel_expired_t* timers,
+									  unsigned count,
+									  void* ctx);
+
+/**
+ * @typedef timer_wheel_timer_t
+ * @brief Typedef for the timer_wheel_timer structure
+ */
+typedef struct timer_wheel_timer timer_wheel_timer_t;
+
+/**
+ * @struct timer_wheel_timer
+ * @brief A timer of the wheel
+ */
+struct timer_wheel_timer {
+	uint64_t expiry;
+	/**< Tick at which the timer expires */
+	void* data;
+	/**< Data of the timer */
+	unsigned generation;
+	/**< Incremented when the timer expires or is cancelled */
+	unsigned next_free;
+	/**< Next free timer when the timer is not pending */
+	BOOL pending;
+	/**< TRUE while the timer is scheduled */
+};
+
+/**
+ * @typedef timer_wheel_t
+ * @brief Typedef for the timer_wheel structure
+ */
+typedef struct timer_wheel timer_wheel_t;
+
+/**
+ * @struct timer_wheel
+ * @brief A hierarchical timer wheel
+ */
+struct timer_wheel {
+	circular_buffer_t* slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+	/**< Entries of the timers of each slot of each level */
+	unsigned level_size[TIMER_WHEEL_LEVELS];
+	/**< Number of entries of each level, cancelled timers included */
+	timer_wheel_timer_t* timers;
+	/**< Array of #capacity timers */
+	unsigned capacity;
+	/**< Maximum number of pending timers */
+	unsigned free;
+	/**< First free timer, #capacity if every timer is pending */
+	unsigned nb_pending;
+	/**< Number of pending timers */
+	uint64_t now;
+	/**< Current tick */
+	timer_wheel_expired_t batch[TIMER_WHEEL_BATCH];
+	/**< Expired timers waiting to be given to the callback */
+	unsigned batch_size;
+	/**< Number of timers in #batch */
+};
+
+/**
+ * @brief Creates an empty timer wheel
+ *
+ * __Every timer wheel created with this function should be freed using
+ * free_timer_wheel__
+ *
+ * @param capacity maximum number of pending timers
+ * @param now current tick
+ * @return a pointer to the timer wheel or NULL if the function failed
+ */
+timer_wheel_t* create_timer_wheel(unsigned capacity, uint64_t now);
+
+/**
+ * @brief Frees the timer wheel
+ * @param wheel pointer to the timer wheel
+ */
+void free_timer_wheel(timer_wheel_t* wheel);
+
+/**
+ * @brief Schedules a timer
+ *
+ * A timer whose expiry is not after the current tick expires at the next
+ * tick.
+ *
+ * _Complexity:_ \f$O(1)\f$ amortized
+ *
+ * @param wheel pointer to the timer wheel
+ * @param expiry tick at which the timer expires
+ * @param data data given back to the callback
+ * @return the identifier of the timer, valid until it expires or is
+ * cancelled, or a negative error code:
+ * - -ERROR_CAPACITY_EXCEEDED if capacity timers are pending
+ * - -ERROR_ALLOCATION_FAILED if a slot could not grow
+ */
+int timer_wheel_schedule(timer_wheel_t* wheel, uint64_t expiry, void* data);
+
+/**
+ * @brief Cancels a pending timer
+ *
+ * _Complexity:_ \f$O(1)\f$
+ *
+ * @param wheel pointer to the timer wheel
+ * @param id identifier returned by timer_wheel_schedule()
+ * @return -ERROR_NO_ERROR or -ERROR_INVALID_PARAM2 if the timer is not
+ * pending
+ */
+int timer_wheel_cancel(timer_wheel_t* wheel, unsigned id);
+
+/**
+ * @brief Advances the current tick and expires the timers due
+ *
+ * The timers whose expiry is at most now are given to expire by batches of
+ * at most TIMER_WHEEL_BATCH timers, by increasing expiry. They are not
+ * pending anymore when the callback is called, which can schedule and cancel
+ * timers.
+ *
+ * _Complexity:_ \f$O(t + e)\f$ for t ticks elapsed and e timers expired,
+ * the ticks being skipped by \f$TIMER\_WHEEL\_SLOTS^k\f$ while the levels
+ * below k are empty
+ *
+ * @param wheel pointer to the timer wheel
+ * @param now new current tick (nothing is done if it is not after the
+ * current tick)
+ * @param expire callback receiving the expired timers
+ * @param ctx argument given to expire
+ * @return the number of timers expired or -ERROR_ALLOCATION_FAILED if a slot
+ * could not grow during a cascade. In that case the timers expired before are
+ * given to expire, the current tick is the last one fully processed and every
+ * pending timer is still in the wheel, so that the call can be repeated.
+ */
+int timer_wheel_advance(timer_wheel_t* wheel,
+						uint64_t now,
+						timer_wheel_expire_fn expire,
+						void* ctx);
+
+/** @} */
+
+#endif	// !STRUCT_TIMER_WHEEL_H
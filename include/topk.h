@@ -0,0 +1,132 @@
+#ifndef STRUCT_TOPK_H
+#define STRUCT_TOPK_H
+
+#include "structures.h"
+
+/**
+ * @file topk.h
+ * @brief Streaming top-k selection
+ * @ingroup topk
+ *
+ * Defines a bounded heap keeping the k greatest keys of a stream
+ */
+
+/**
+ * @defgroup topk Top-k selection
+ *
+ * The k greatest keys seen so far are kept in a min-heap of k entries whose
+ * root, the lowest of them, is the threshold a new key has to exceed. Most
+ * keys of a long stream are below the threshold: topk_push() rejects them
+ * inline with one comparison, before calling the O(log k) insertion.
+ * @{
+ */
+
+/**
+ * @typedef topk_entry_t
+ * @brief Typedef for the topk_entry structure
+ */
+typedef struct topk_entry topk_entry_t;
+
+/**
+ * @struct topk_entry
+ * @brief A key with the identifier of its item
+ */
+struct topk_entry {
+	double key;	 /**< Key of the item */
+	unsigned id; /**< Identifier of the item */
+};
+
+/**
+ * @typedef topk_t
+ * @brief Typedef for the topk structure
+ */
+typedef struct topk topk_t;
+
+/**
+ * @struct topk
+ * @brief The k greatest entries of a stream
+ */
+struct topk {
+	topk_entry_t* entries;
+	/**< Min-heap of #size entries */
+	unsigned size;
+	/**< Number of entries, at most #k */
+	unsigned k;
+	/**< Number of entries kept */
+	double threshold;
+	/**< Key of the root when the heap is full */
+};
+
+/**
+ * @brief Creates an empty top-k selection
+ *
+ * __Every topk_t created with this function should be freed using
+ * free_topk__
+ *
+ * @param k number of entries to keep (strictly positive)
+ * @return a pointer to the topk_t or NULL if the function failed
+ */
+topk_t* create_topk(unsigned k);
+
+/**
+ * @brief Frees the top-k selection
+ * @param topk pointer to the topk_t
+ */
+void free_topk(topk_t* topk);
+
+/**
+ * @brief Removes every entry
+ * @param topk pointer to the topk_t
+ */
+void topk_clear(topk_t* topk);
+
+/**
+ * @brief Inserts an entry, replacing the lowest one if the heap is full
+ *
+ * Called by topk_push() for the keys which pass the threshold.
+ *
+ * @param topk pointer to the topk_t
+ * @param key key of the item
+ * @param id identifier of the item
+ */
+void topk_insert(topk_t* topk, double key, unsigned id);
+
+/**
+ * @brief Offers an item to the top-k selection
+ *
+ * While fewer than k entries are kept every key is accepted. Then a key is
+ * accepted only if it is greater than the lowest key kept, which it
+ * replaces.
+ *
+ * _Complexity:_ \f$O(1)\f$ if the key is rejected, \f$O(\log{k})\f$
+ * otherwise
+ *
+ * @param topk pointer to the topk_t
+ * @param key key of the item
+ * @param id identifier of the item
+ * @return TRUE if the item was kept
+ */
+static inline BOOL topk_push(topk_t* topk, double key, unsigned id) {
+	// Both comparisons are evaluated to avoid a second branch
+	if ((topk->size == topk->k) & (key <= topk->threshold))
+		return FALSE;
+	topk_insert(topk, key, id);
+	return TRUE;
+}
+
+/**
+ * @brief Moves the entries kept to an array, greatest key first
+ *
+ * The top-k selection is empty afterwards, ready for a new window.
+ *
+ * _Complexity:_ \f$O(k \log{k})\f$
+ *
+ * @param topk pointer to the topk_t
+ * @param[out] out array of at least topk->size entries
+ * @return the number of entries written
+ */
+unsigned topk_extract(topk_t* topk, topk_entry_t* out);
+
+/** @} */
+
+#endif	// !STRUCT_TOPK_H
@@ -0,0 +1,114 @@
+#include "dary_heap.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "test_macros.h"
+
+#define CACHE_LINE 64
+
+dary_heap_t* create_dary_heap(unsigned capacity, unsigned arity) {
+	dary_heap_t* ret;
+	when_true_ret(capacity == 0, NULL);
+	when_true_ret(arity < 2 || arity > 16 || (arity & (arity - 1)) != 0, NULL);
+	dary_heap_t* heap = calloc(1, sizeof(dary_heap_t));
+	when_null_ret(heap, NULL);
+	while ((1u << heap->log_arity) < arity)
+		heap->log_arity++;
+	heap->capacity = capacity;
+	heap->idx_to_pos = malloc(capacity * sizeof(unsigned));
+	// One more entry and a line of padding to align the children groups
+	heap->memory =
+		malloc((capacity + 1) * sizeof(dary_heap_entry_t) + CACHE_LINE);
+	when_true_jmp(heap->idx_to_pos == NULL || heap->memory == NULL, NULL,
+				  error);
+	// entries + 1, the first child of the root, starts a cache line
+	const uintptr_t first = (uintptr_t)heap->memory + sizeof(dary_heap_entry_t);
+	const uintptr_t aligned =
+		(first + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+	heap->entries = (dary_heap_entry_t*)(aligned - sizeof(dary_heap_entry_t));
+	for (unsigned i = 0; i < capacity; i++)
+		heap->idx_to_pos[i] = DARY_HEAP_ABSENT;
+	return heap;
+error:
+	free_dary_heap(heap);
+	return ret;
+}
+
+void free_dary_heap(dary_heap_t* heap) {
+	if (heap == NULL)
+		return;
+	free(heap->memory);
+	free(heap->idx_to_pos);
+	free(heap);
+}
+
+void dary_heap_clear(dary_heap_t* heap) {
+	for (unsigned p = 0; p < heap->size; p++)
+		heap->idx_to_pos[heap->entries[p].idx] = DARY_HEAP_ABSENT;
+	heap->size = 0;
+}
+
+/**
+ * Moves the entry up from the position pos to its place
+ */
+static void sift_up(dary_heap_t* heap, unsigned pos, dary_heap_entry_t entry) {
+	dary_heap_entry_t* entries = heap->entries;
+	while (pos > 0) {
+		const unsigned parent = (pos - 1) >> heap->log_arity;
+		if (entries[parent].key <= entry.key)
+			break;
+		entries[pos] = entries[parent];
+		heap->idx_to_pos[entries[pos].idx] = pos;
+		pos = parent;
+	}
+	entries[pos] = entry;
+	heap->idx_to_pos[entry.idx] = pos;
+}
+
+void dary_heap_decrease_key(dary_heap_t* heap,
+							unsigned idx,
+							graph_weight_t key) {
+	unsigned pos = heap->idx_to_pos[idx];
+	if (pos == DARY_HEAP_ABSENT)
+		pos = heap->size++;
+	else if (heap->entries[pos].key <= key)
+		return;
+	sift_up(heap, pos, (dary_heap_entry_t){key, idx});
+}
+
+int dary_heap_pop(dary_heap_t* heap, graph_weight_t* key) {
+	if (heap->size == 0)
+		return -ERROR_IS_EMPTY;
+	dary_heap_entry_t* entries = heap->entries;
+	const dary_heap_entry_t root = entries[0];
+	const dary_heap_entry_t last = entries[--heap->size];
+	heap->idx_to_pos[root.idx] = DARY_HEAP_ABSENT;
+	if (key != NULL)
+		*key = root.key;
+	if (heap->size == 0)
+		return root.idx;
+
+	const unsigned size = heap->size;
+	const unsigned arity = 1u << heap->log_arity;
+	unsigned pos = 0;
+	for (;;) {
+		const unsigned first = (pos << heap->log_arity) + 1;
+		if (first >= size)
+			break;
+		const unsigned end = first + arity < size ? first + arity : size;
+		// The children are contiguous, the scan stays in one cache line
+		unsigned min = first;
+		for (unsigned c = first + 1; c < end; c++) {
+			if (entries[c].key < entries[min].key)
+				min = c;
+		}
+		if (last.key <= entries[min].key)
+			break;
+		entries[pos] = entries[min];
+		heap->idx_to_pos[entries[pos].idx] = pos;
+		pos = min;
+	}
+	entries[pos] = last;
+	heap->idx_to_pos[last.idx] = pos;
+	return root.idx;
+}
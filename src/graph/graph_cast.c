@@ -1,30 +1,344 @@
-#include "graph/graph_list.h"
-#include "graph/graph_mat.h"
+#include "graph/graph_cast.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "errors.h"
+#include "graph_list_private.h"
+#include "test_macros.h"
 
-int graph_list_add_edge_noverif(graph_list_t* g,
-								unsigned int a,
-								unsigned int b,
-								long long weight);
+/**
+ * Range of rows [begin, end[ converted by a thread
+ */
+typedef struct row_task {
+	const void* src;
+	void* dst;
+	unsigned begin;
+	unsigned end;
+	int ret;
+} row_task_t;
 
-graph_list_t* graph_mat_to_graph_list(graph_mat_t* graph_mat,
-									  graph_list_t** graph_list) {
-	if (!graph_list) {
-		graph_list = malloc(sizeof(graph_list_t*));
-		*graph_list = NULL;
+typedef void* (*row_worker_fn)(void* arg);
+
+/**
+ * Splits the n rows in nb_threads contiguous ranges and converts each of them
+ * with worker. The last range is converted by the calling thread, and so is
+ * any range whose thread can't be created.
+ */
+static int run_rows(const void* src,
+					void* dst,
+					unsigned n,
+					unsigned nb_threads,
+					row_worker_fn worker) {
+	int ret = -ERROR_NO_ERROR;
+	if (nb_threads == 0)
+		nb_threads = 1;
+	nb_threads = MIN(nb_threads, n);
+	if (nb_threads == 1) {
+		row_task_t task = {src, dst, 0, n, -ERROR_NO_ERROR};
+		worker(&task);
+		return task.ret;
 	}
 
-	free_graph_list(*graph_list);
-	const size_t size = graph_mat->nb_vert;
-	*graph_list = create_graph_list(size, graph_mat->weights != NULL);
+	row_task_t* tasks = malloc(nb_threads * sizeof(row_task_t));
+	when_null_ret(tasks, -ERROR_ALLOCATION_FAILED);
+	pthread_t* threads = malloc(nb_threads * sizeof(pthread_t));
+	BOOL* started = calloc(nb_threads, sizeof(BOOL));
+	when_true_jmp(threads == NULL || started == NULL, -ERROR_ALLOCATION_FAILED,
+				  exit);
+
+	for (unsigned t = 0; t < nb_threads; t++) {
+		tasks[t].src = src;
+		tasks[t].dst = dst;
+		tasks[t].begin = (uint64_t)n * t / nb_threads;
+		tasks[t].end = (uint64_t)n * (t + 1) / nb_threads;
+		tasks[t].ret = -ERROR_NO_ERROR;
+		if (t + 1 < nb_threads &&
+			pthread_create(&threads[t], NULL, worker, &tasks[t]) == 0)
+			started[t] = TRUE;
+		else
+			worker(&tasks[t]);
+	}
+	for (unsigned t = 0; t < nb_threads; t++) {
+		if (started[t] == TRUE)
+			pthread_join(threads[t], NULL);
+		if (tasks[t].ret != -ERROR_NO_ERROR)
+			ret = tasks[t].ret;
+	}
+
+exit:
+	free(started);
+	free(threads);
+	free(tasks);
+	return ret;
+}
+
+/**
+ * Number of cells of a matrix row skipped at once when they are all FALSE
+ */
+#define BLOCK_CELLS (4 * sizeof(uint64_t) / sizeof(BOOL))
+
+/**
+ * Index of the first edge of the row at or after the column j (n if there is
+ * none). The empty blocks of BLOCK_CELLS cells are skipped by testing four 64
+ * bits words at once instead of each cell.
+ */
+static unsigned next_edge(const BOOL* row, unsigned j, unsigned n) {
+	while (j + BLOCK_CELLS <= n) {
+		uint64_t block[4];
+		memcpy(block, row + j, sizeof(block));
+		if ((block[0] | block[1] | block[2] | block[3]) != 0)
+			break;
+		j += BLOCK_CELLS;
+	}
+	while (j < n && row[j] == FALSE)
+		j++;
+	return j;
+}
+
+#define foreach_mat_edge(g, i, j)                                           \
+	for (unsigned j = next_edge(&(g)->edges[(size_t)(i) * (g)->nb_vert], 0, \
+								(g)->nb_vert);                              \
+		 j < (g)->nb_vert;                                                  \
+		 j = next_edge(&(g)->edges[(size_t)(i) * (g)->nb_vert], j + 1,      \
+					   (g)->nb_vert))
+
+static graph_weight_t mat_weight(const graph_mat_t* g, unsigned i, unsigned j) {
+	return g->weights ? g->weights[(size_t)i * g->nb_vert + j] : 1;
+}
+
+static void* mat_to_list_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_mat_t* mat = task->src;
+	graph_list_t* list = task->dst;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		foreach_mat_edge(mat, i, j) {
+			const graph_weight_t w = mat_weight(mat, i, j);
+			if (graph_list_add_edge_noverif(list, i, j, w)) {
+				task->ret = -ERROR_ALLOCATION_FAILED;
+				return NULL;
+			}
+		}
+	}
+	return NULL;
+}
+
+static void* list_to_mat_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_list_t* list = task->src;
+	graph_mat_t* mat = task->dst;
+	const size_t n = mat->nb_vert;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		foreach_node(&list->neighbours[i], e, graph_list_edge_t) {
+			mat->edges[i * n + e->to] = TRUE;
+			if (mat->weights)
+				mat->weights[i * n + e->to] = e->w;
+		}
+	}
+	return NULL;
+}
+
+static void* mat_degree_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_mat_t* mat = task->src;
+	graph_csr_t* csr = task->dst;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		size_t degree = 0;
+		foreach_mat_edge(mat, i, j) {
+			degree++;
+		}
+		csr->offset[i + 1] = degree;
+	}
+	return NULL;
+}
+
+static void* mat_to_csr_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_mat_t* mat = task->src;
+	graph_csr_t* csr = task->dst;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		size_t k = csr->offset[i];
+		foreach_mat_edge(mat, i, j) {
+			csr->to[k] = j;
+			if (csr->weights)
+				csr->weights[k] = mat_weight(mat, i, j);
+			k++;
+		}
+	}
+	return NULL;
+}
+
+static void* list_degree_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_list_t* list = task->src;
+	graph_csr_t* csr = task->dst;
+	for (unsigned i = task->begin; i < task->end; i++)
+		csr->offset[i + 1] = length_list(&list->neighbours[i]);
+	return NULL;
+}
+
+static void* list_to_csr_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_list_t* list = task->src;
+	graph_csr_t* csr = task->dst;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		size_t k = csr->offset[i];
+		foreach_node(&list->neighbours[i], e, graph_list_edge_t) {
+			csr->to[k] = e->to;
+			if (csr->weights)
+				csr->weights[k] = e->w;
+			k++;
+		}
+	}
+	return NULL;
+}
 
-	for (unsigned i = 0; i < size; i++) {
-		for (unsigned j = 0; j < size; j++) {
-			if (graph_mat_get_edge(graph_mat, i, j)) {
-				graph_list_add_edge_noverif(
-					*graph_list, i, j, graph_mat_get_weight(graph_mat, i, j));
+static void* csr_to_list_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_csr_t* csr = task->src;
+	graph_list_t* list = task->dst;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		for (size_t k = csr->offset[i]; k < csr->offset[i + 1]; k++) {
+			const graph_weight_t w = csr->weights ? csr->weights[k] : 1;
+			if (graph_list_add_edge_noverif(list, i, csr->to[k], w)) {
+				task->ret = -ERROR_ALLOCATION_FAILED;
+				return NULL;
 			}
 		}
 	}
+	return NULL;
+}
+
+static void* csr_to_mat_worker(void* arg) {
+	row_task_t* task = arg;
+	const graph_csr_t* csr = task->src;
+	graph_mat_t* mat = task->dst;
+	const size_t n = mat->nb_vert;
+	for (unsigned i = task->begin; i < task->end; i++) {
+		for (size_t k = csr->offset[i]; k < csr->offset[i + 1]; k++) {
+			mat->edges[i * n + csr->to[k]] = TRUE;
+			if (mat->weights)
+				mat->weights[i * n + csr->to[k]] = csr->weights[k];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Turns the degrees stored in offset[1..n] into offsets then allocates the
+ * edges of the graph
+ */
+static int reserve_edges(graph_csr_t* csr) {
+	const unsigned n = csr->nb_vert;
+	csr->offset[0] = 0;
+	for (unsigned i = 0; i < n; i++)
+		csr->offset[i + 1] += csr->offset[i];
+	csr->nb_edges = csr->offset[n];
+	const size_t size = csr->nb_edges ? csr->nb_edges : 1;
+
+	unsigned* to = realloc(csr->to, size * sizeof(unsigned));
+	when_null_ret(to, -ERROR_ALLOCATION_FAILED);
+	csr->to = to;
+	if (csr->weights) {
+		graph_weight_t* weights =
+			realloc(csr->weights, size * sizeof(graph_weight_t));
+		when_null_ret(weights, -ERROR_ALLOCATION_FAILED);
+		csr->weights = weights;
+	}
+	return -ERROR_NO_ERROR;
+}
+
+graph_list_t* graph_mat_to_graph_list_parallel(graph_mat_t* g,
+											   unsigned nb_threads) {
+	when_null_ret(g, NULL);
+	graph_list_t* list = create_graph_list(g->nb_vert, g->weights != NULL);
+	when_null_ret(list, NULL);
+	if (run_rows(g, list, g->nb_vert, nb_threads, mat_to_list_worker) !=
+		-ERROR_NO_ERROR) {
+		free_graph_list(list);
+		return NULL;
+	}
+	return list;
+}
 
-	return *graph_list;
+graph_list_t* graph_mat_to_graph_list(graph_mat_t* graph_mat,
+									  graph_list_t** graph_list) {
+	graph_list_t* list = graph_mat_to_graph_list_parallel(graph_mat, 1);
+	if (graph_list) {
+		free_graph_list(*graph_list);
+		*graph_list = list;
+	}
+	return list;
+}
+
+graph_mat_t* graph_list_to_graph_mat(graph_list_t* g, unsigned nb_threads) {
+	when_null_ret(g, NULL);
+	graph_mat_t* mat = create_graph_mat(g->nb_vert, g->is_weighted);
+	when_null_ret(mat, NULL);
+	if (run_rows(g, mat, g->nb_vert, nb_threads, list_to_mat_worker) !=
+		-ERROR_NO_ERROR) {
+		free_graph_mat(mat);
+		return NULL;
+	}
+	return mat;
+}
+
+graph_csr_t* graph_mat_to_graph_csr(graph_mat_t* g, unsigned nb_threads) {
+	graph_csr_t* ret;
+	when_null_ret(g, NULL);
+	graph_csr_t* csr = create_graph_csr(g->nb_vert, 0, g->weights != NULL);
+	when_null_ret(csr, NULL);
+	when_false_jmp(run_rows(g, csr, g->nb_vert, nb_threads,
+							mat_degree_worker) == -ERROR_NO_ERROR,
+				   NULL, error);
+	when_false_jmp(reserve_edges(csr) == -ERROR_NO_ERROR, NULL, error);
+	when_false_jmp(run_rows(g, csr, g->nb_vert, nb_threads,
+							mat_to_csr_worker) == -ERROR_NO_ERROR,
+				   NULL, error);
+	return csr;
+error:
+	free_graph_csr(csr);
+	return ret;
+}
+
+graph_csr_t* graph_list_to_graph_csr(graph_list_t* g, unsigned nb_threads) {
+	graph_csr_t* ret;
+	when_null_ret(g, NULL);
+	graph_csr_t* csr = create_graph_csr(g->nb_vert, 0, g->is_weighted);
+	when_null_ret(csr, NULL);
+	when_false_jmp(run_rows(g, csr, g->nb_vert, nb_threads,
+							list_degree_worker) == -ERROR_NO_ERROR,
+				   NULL, error);
+	when_false_jmp(reserve_edges(csr) == -ERROR_NO_ERROR, NULL, error);
+	when_false_jmp(run_rows(g, csr, g->nb_vert, nb_threads,
+							list_to_csr_worker) == -ERROR_NO_ERROR,
+				   NULL, error);
+	return csr;
+error:
+	free_graph_csr(csr);
+	return ret;
+}
+
+graph_list_t* graph_csr_to_graph_list(graph_csr_t* g, unsigned nb_threads) {
+	when_null_ret(g, NULL);
+	graph_list_t* list = create_graph_list(g->nb_vert, g->weights != NULL);
+	when_null_ret(list, NULL);
+	if (run_rows(g, list, g->nb_vert, nb_threads, csr_to_list_worker) !=
+		-ERROR_NO_ERROR) {
+		free_graph_list(list);
+		return NULL;
+	}
+	return list;
+}
+
+graph_mat_t* graph_csr_to_graph_mat(graph_csr_t* g, unsigned nb_threads) {
+	when_null_ret(g, NULL);
+	graph_mat_t* mat = create_graph_mat(g->nb_vert, g->weights != NULL);
+	when_null_ret(mat, NULL);
+	if (run_rows(g, mat, g->nb_vert, nb_threads, csr_to_mat_worker) !=
+		-ERROR_NO_ERROR) {
+		free_graph_mat(mat);
+		return NULL;
+	}
+	return mat;
 }
@@ -0,0 +1,284 @@
+#include "graph/graph_centrality.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "compare.h"
+#include "errors.h"
+#include "heap_view.h"
+#include "prng.h"
+#include "test_macros.h"
+
+DEFINE_COMPARE_MIN_SCALAR(graph_weight_t)
+
+#define UNSETTLED UINT_MAX
+
+/**
+ * Per-thread scratch memory of Brandes' algorithm, allocated once and reused
+ * for every source handled by the thread
+ */
+typedef struct brandes_scratch {
+	unsigned* stack;  // vertices by non-decreasing distance from the source
+	unsigned* order;  // order[v] is the position of v in stack
+	double* sigma;	  // number of shortest paths from the source
+	double* delta;	  // dependency of the source on each vertex
+	graph_weight_t* distance;
+	heap_view_t* heap;	// Only used for weighted graphs
+} brandes_scratch_t;
+
+typedef struct brandes_task {
+	graph_list_t* g;
+	const unsigned* sources;  // NULL to use every vertex as a source
+	unsigned nb_sources;
+	unsigned first;
+	unsigned step;
+	double* centrality;	 // partial centrality of the thread
+	int ret;
+} brandes_task_t;
+
+static void free_brandes_scratch(brandes_scratch_t* sc) {
+	free(sc->stack);
+	free(sc->order);
+	free(sc->sigma);
+	free(sc->delta);
+	free(sc->distance);
+	free_heap(sc->heap);
+}
+
+static int init_brandes_scratch(brandes_scratch_t* sc, graph_list_t* g) {
+	const unsigned n = g->nb_vert;
+	sc->stack = malloc(n * sizeof(unsigned));
+	sc->order = malloc(n * sizeof(unsigned));
+	sc->sigma = malloc(n * sizeof(double));
+	sc->delta = malloc(n * sizeof(double));
+	sc->distance = malloc(n * sizeof(graph_weight_t));
+	sc->heap = NULL;
+	if (g->is_weighted && sc->distance != NULL)
+		sc->heap = create_heap(n, sizeof(graph_weight_t), sc->distance,
+							   compare_min_graph_weight_t);
+	if (sc->stack == NULL || sc->order == NULL || sc->sigma == NULL ||
+		sc->delta == NULL || sc->distance == NULL ||
+		(g->is_weighted && sc->heap == NULL)) {
+		free_brandes_scratch(sc);
+		return -ERROR_ALLOCATION_FAILED;
+	}
+	return -ERROR_NO_ERROR;
+}
+
+static void reset_brandes_scratch(brandes_scratch_t* sc,
+								  unsigned n,
+								  unsigned s) {
+	for (unsigned i = 0; i < n; i++) {
+		sc->distance[i] = GRAPH_WEIGHT_INF;
+		sc->sigma[i] = 0;
+		sc->order[i] = UNSETTLED;
+	}
+	sc->distance[s] = 0;
+	sc->sigma[s] = 1;
+}
+
+static unsigned brandes_bfs(graph_list_t* g,
+							unsigned s,
+							brandes_scratch_t* sc) {
+	unsigned head = 0, tail = 1;
+	sc->stack[0] = s;
+	sc->order[s] = 0;
+	// The stack is also used as the BFS queue
+	while (head < tail) {
+		const unsigned v = sc->stack[head++];
+		const graph_weight_t d = sc->distance[v] + 1;
+		foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+			if (sc->distance[e->to] == GRAPH_WEIGHT_INF) {
+				sc->distance[e->to] = d;
+				sc->order[e->to] = tail;
+				sc->stack[tail++] = e->to;
+			}
+			if (sc->distance[e->to] == d)
+				sc->sigma[e->to] += sc->sigma[v];
+		}
+	}
+	return tail;
+}
+
+static unsigned brandes_dijkstra(graph_list_t* g,
+								 unsigned s,
+								 brandes_scratch_t* sc) {
+	heap_view_t* heap = sc->heap;
+	// Every vertex is in the heap with an infinite distance but the source
+	heap->size = g->nb_vert;
+	for (unsigned i = 0; i < g->nb_vert; i++) {
+		heap->idx_to_pos[i] = i;
+		heap->pos_to_idx[i] = i;
+	}
+	heap->idx_to_pos[s] = 0;
+	heap->idx_to_pos[0] = s;
+	heap->pos_to_idx[s] = 0;
+	heap->pos_to_idx[0] = s;
+
+	unsigned count = 0;
+	int v;
+	while ((v = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (sc->distance[v] == GRAPH_WEIGHT_INF)
+			break;
+		sc->order[v] = count;
+		sc->stack[count++] = v;
+		foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+			if (sc->order[e->to] != UNSETTLED)
+				continue;
+			graph_weight_t d =
+				weight_add_truncate_overflow(sc->distance[v], e->w);
+			if (d < sc->distance[e->to]) {
+				weight_heap_update_up(heap, e->to, d);
+				sc->sigma[e->to] = sc->sigma[v];
+			} else if (d == sc->distance[e->to]) {
+				sc->sigma[e->to] += sc->sigma[v];
+			}
+		}
+	}
+	return count;
+}
+
+static void brandes_accumulate(graph_list_t* g,
+							   unsigned s,
+							   unsigned count,
+							   brandes_scratch_t* sc,
+							   double* centrality) {
+	// The successors of w on a shortest path are settled after w so their
+	// dependency is already known
+	for (unsigned i = count; i-- > 0;) {
+		const unsigned w = sc->stack[i];
+		double delta = 0;
+		foreach_node(&g->neighbours[w], e, graph_list_edge_t) {
+			const unsigned v = e->to;
+			if (sc->order[v] == UNSETTLED || sc->order[v] <= i)
+				continue;
+			const graph_weight_t d =
+				g->is_weighted
+					? weight_add_truncate_overflow(sc->distance[w], e->w)
+					: sc->distance[w] + 1;
+			if (d == sc->distance[v])
+				delta += sc->sigma[w] / sc->sigma[v] * (1 + sc->delta[v]);
+		}
+		sc->delta[w] = delta;
+		if (w != s)
+			centrality[w] += delta;
+	}
+}
+
+static void* brandes_worker(void* arg) {
+	brandes_task_t* task = arg;
+	graph_list_t* g = task->g;
+	brandes_scratch_t sc;
+	task->ret = init_brandes_scratch(&sc, g);
+	if (task->ret != -ERROR_NO_ERROR)
+		return NULL;
+
+	for (unsigned i = task->first; i < task->nb_sources; i += task->step) {
+		const unsigned s = task->sources ? task->sources[i] : i;
+		reset_brandes_scratch(&sc, g->nb_vert, s);
+		const unsigned count = g->is_weighted ? brandes_dijkstra(g, s, &sc)
+											  : brandes_bfs(g, s, &sc);
+		brandes_accumulate(g, s, count, &sc, task->centrality);
+	}
+	free_brandes_scratch(&sc);
+	return NULL;
+}
+
+static int brandes(graph_list_t* g,
+				   double* centrality,
+				   const unsigned* sources,
+				   unsigned nb_sources,
+				   double scale,
+				   unsigned nb_threads) {
+	int ret = -ERROR_NO_ERROR;
+	const unsigned n = g->nb_vert;
+	if (nb_sources == 0)
+		return -ERROR_NO_ERROR;
+	if (nb_threads == 0)
+		nb_threads = 1;
+	nb_threads = MIN(nb_threads, nb_sources);
+
+	brandes_task_t* tasks = malloc(nb_threads * sizeof(brandes_task_t));
+	when_null_ret(tasks, -ERROR_ALLOCATION_FAILED);
+	pthread_t* threads = malloc(nb_threads * sizeof(pthread_t));
+	BOOL* started = calloc(nb_threads, sizeof(BOOL));
+	// Partial centralities of the threads, reduced at the end
+	double* partial = calloc((size_t)nb_threads * n, sizeof(double));
+	when_true_jmp(threads == NULL || started == NULL || partial == NULL,
+				  -ERROR_ALLOCATION_FAILED, exit);
+
+	for (unsigned t = 0; t < nb_threads; t++) {
+		tasks[t].g = g;
+		tasks[t].sources = sources;
+		tasks[t].nb_sources = nb_sources;
+		tasks[t].first = t;
+		tasks[t].step = nb_threads;
+		tasks[t].centrality = partial + (size_t)t * n;
+		tasks[t].ret = -ERROR_NO_ERROR;
+		// The last task is run by the calling thread, and so is any task
+		// whose thread can't be created
+		if (t + 1 < nb_threads &&
+			pthread_create(&threads[t], NULL, brandes_worker, &tasks[t]) == 0)
+			started[t] = TRUE;
+		else
+			brandes_worker(&tasks[t]);
+	}
+	for (unsigned t = 0; t < nb_threads; t++) {
+		if (started[t] == TRUE)
+			pthread_join(threads[t], NULL);
+		if (tasks[t].ret != -ERROR_NO_ERROR)
+			ret = tasks[t].ret;
+	}
+
+	for (unsigned i = 0; i < n; i++) {
+		double sum = 0;
+		for (unsigned t = 0; t < nb_threads; t++)
+			sum += partial[(size_t)t * n + i];
+		centrality[i] = sum * scale;
+	}
+
+exit:
+	free(partial);
+	free(started);
+	free(threads);
+	free(tasks);
+	return ret;
+}
+
+int graph_list_betweenness(graph_list_t* g,
+						   double* centrality,
+						   unsigned nb_threads) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_null_ret(centrality, -ERROR_INVALID_PARAM2);
+	return brandes(g, centrality, NULL, g->nb_vert, 1.0, nb_threads);
+}
+
+int graph_list_betweenness_sampled(graph_list_t* g,
+								   double* centrality,
+								   unsigned nb_samples,
+								   uint64_t seed,
+								   unsigned nb_threads) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_null_ret(centrality, -ERROR_INVALID_PARAM2);
+	when_true_ret(nb_samples == 0 || nb_samples > g->nb_vert,
+				  -ERROR_INVALID_PARAM3);
+
+	unsigned* sources = malloc(g->nb_vert * sizeof(unsigned));
+	when_null_ret(sources, -ERROR_ALLOCATION_FAILED);
+	for (unsigned i = 0; i < g->nb_vert; i++)
+		sources[i] = i;
+
+	// Partial Fisher-Yates shuffle: the first nb_samples are the sample
+	prng_t rng;
+	prng_seed(&rng, seed);
+	for (unsigned i = 0; i < nb_samples; i++) {
+		const unsigned j = i + prng_bounded(&rng, g->nb_vert - i);
+		const unsigned tmp = sources[i];
+		sources[i] = sources[j];
+		sources[j] = tmp;
+	}
+
+	int ret = brandes(g, centrality, sources, nb_samples,
+					  (double)g->nb_vert / nb_samples, nb_threads);
+	free(sources);
+	return ret;
+}
@@ -0,0 +1,288 @@
+#include "graph/graph_compressed.h"
+#include <stdlib.h>
+#include "errors.h"
+#include "heap_view.h"
+#include "list_ref/list_ref.h"
+#include "test_macros.h"
+#include "workspace_wrap.h"
+
+/**
+ * Growable byte array used to encode a stream
+ */
+typedef struct byte_stream {
+	unsigned char* data;
+	size_t size;
+	size_t capacity;
+} byte_stream_t;
+
+static int write_varint(byte_stream_t* s, unsigned long long x) {
+	// A 64 bits value takes at most 10 bytes
+	if (s->size + 10 > s->capacity) {
+		const size_t capacity = s->capacity < 64 ? 64 : 2 * s->capacity;
+		unsigned char* data = realloc(s->data, capacity);
+		when_null_ret(data, -ERROR_ALLOCATION_FAILED);
+		s->data = data;
+		s->capacity = capacity;
+	}
+	while (x >= 0x80) {
+		s->data[s->size++] = (x & 0x7F) | 0x80;
+		x >>= 7;
+	}
+	s->data[s->size++] = x;
+	return -ERROR_NO_ERROR;
+}
+
+static unsigned long long zigzag(long long x) {
+	return ((unsigned long long)x << 1) ^ (unsigned long long)(x >> 63);
+}
+
+static int compare_edges(const void* a, const void* b) {
+	const unsigned to_a = ((const graph_list_edge_t*)a)->to;
+	const unsigned to_b = ((const graph_list_edge_t*)b)->to;
+	return (to_a > to_b) - (to_a < to_b);
+}
+
+graph_compressed_t* graph_list_to_graph_compressed(graph_list_t* g) {
+	graph_compressed_t* ret;
+	when_null_ret(g, NULL);
+	graph_compressed_t* c = calloc(1, sizeof(graph_compressed_t));
+	when_null_ret(c, NULL);
+	byte_stream_t neighbours = {NULL, 0, 0};
+	byte_stream_t weights = {NULL, 0, 0};
+	graph_list_edge_t* edges = NULL;
+
+	const unsigned n = g->nb_vert;
+	c->nb_vert = n;
+	c->offset = malloc((n + 1) * sizeof(size_t));
+	when_null_jmp(c->offset, NULL, error);
+	if (g->is_weighted) {
+		c->weight_offset = malloc((n + 1) * sizeof(size_t));
+		when_null_jmp(c->weight_offset, NULL, error);
+	}
+
+	unsigned max_degree = 0;
+	for (unsigned v = 0; v < n; v++) {
+		const unsigned degree = length_list(&g->neighbours[v]);
+		if (degree > max_degree)
+			max_degree = degree;
+	}
+	edges = malloc((max_degree ? max_degree : 1) * sizeof(graph_list_edge_t));
+	when_null_jmp(edges, NULL, error);
+
+	for (unsigned v = 0; v < n; v++) {
+		unsigned degree = 0;
+		foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+			edges[degree++] = *e;
+		}
+		qsort(edges, degree, sizeof(graph_list_edge_t), compare_edges);
+		c->nb_edges += degree;
+
+		c->offset[v] = neighbours.size;
+		when_false_jmp(write_varint(&neighbours, degree) == ERROR_NO_ERROR,
+					   NULL, error);
+		unsigned previous = v;
+		for (unsigned i = 0; i < degree; i++) {
+			const unsigned long long gap =
+				i == 0 ? zigzag((long long)edges[i].to - v)
+					   : edges[i].to - previous;
+			previous = edges[i].to;
+			when_false_jmp(write_varint(&neighbours, gap) == ERROR_NO_ERROR,
+						   NULL, error);
+		}
+
+		if (c->weight_offset == NULL)
+			continue;
+		c->weight_offset[v] = weights.size;
+		for (unsigned i = 0; i < degree; i++) {
+			when_false_jmp(write_varint(&weights, zigzag(edges[i].w)) ==
+							   ERROR_NO_ERROR,
+						   NULL, error);
+		}
+	}
+	c->offset[n] = neighbours.size;
+	if (c->weight_offset)
+		c->weight_offset[n] = weights.size;
+
+	// Gives the unused capacity back
+	c->neighbours = realloc(neighbours.data, neighbours.size + 1);
+	when_null_jmp(c->neighbours, NULL, error);
+	neighbours.data = NULL;
+	if (c->weight_offset) {
+		c->weights = realloc(weights.data, weights.size + 1);
+		when_null_jmp(c->weights, NULL, error);
+		weights.data = NULL;
+	}
+	free(edges);
+	return c;
+error:
+	free(edges);
+	free(neighbours.data);
+	free(weights.data);
+	free_graph_compressed(c);
+	return ret;
+}
+
+void free_graph_compressed(graph_compressed_t* g) {
+	if (g == NULL)
+		return;
+	free(g->offset);
+	free(g->neighbours);
+	free(g->weight_offset);
+	free(g->weights);
+	free(g);
+}
+
+size_t graph_compressed_memory(const graph_compressed_t* g) {
+	size_t size = sizeof(graph_compressed_t);
+	size += (g->nb_vert + 1) * sizeof(size_t) + g->offset[g->nb_vert];
+	if (g->weight_offset)
+		size +=
+			(g->nb_vert + 1) * sizeof(size_t) + g->weight_offset[g->nb_vert];
+	return size;
+}
+
+#define TRAVERSAL_INIT                                                \
+	when_null_ret(g, -ERROR_INVALID_PARAM1);                          \
+	when_false_ret(r < g->nb_vert, -ERROR_INVALID_PARAM2);            \
+	when_null_ret(values, -ERROR_INVALID_PARAM3);                     \
+	WORKSPACE_CHECK(5)                                                \
+	graph_sp_workspace_reset(ws);                                     \
+	if (father != NULL)                                               \
+		father[r] = -1;
+
+int graph_compressed_bfs_ws(graph_compressed_t* g,
+							unsigned r,
+							int* values,
+							int* father,
+							graph_sp_workspace_t* ws) {
+	TRAVERSAL_INIT
+	circular_buffer_t* queue = ws->waiting_list;
+	graph_sp_workspace_set_mark(ws, r, TRUE);
+	circular_buffer_push_back(queue, &r);
+
+	unsigned index = 0;
+	graph_compressed_iter_t it;
+	while (circular_buffer_size(queue) != 0) {
+		int vertex;
+		circular_buffer_pop_front(queue, &vertex);
+		values[index++] = vertex;
+		graph_compressed_neighbours(g, vertex, &it);
+		while (graph_compressed_next(&it)) {
+			if (graph_sp_workspace_get_mark(ws, it.to))
+				continue;
+			graph_sp_workspace_set_mark(ws, it.to, TRUE);
+			if (father != NULL)
+				father[it.to] = vertex;
+			circular_buffer_push_back(queue, &it.to);
+		}
+	}
+	return index;
+}
+
+int graph_compressed_bfs(graph_compressed_t* g,
+						 unsigned r,
+						 int* values,
+						 int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_compressed_bfs_ws(g, r, values, father, ws))
+}
+
+int graph_compressed_preorder_dfs_ws(graph_compressed_t* g,
+									 unsigned r,
+									 int* values,
+									 int* father,
+									 graph_sp_workspace_t* ws) {
+	TRAVERSAL_INIT
+	circular_buffer_t* stack = ws->waiting_list;
+	// The successors of a vertex are decoded in increasing order, they are
+	// stored in num to be pushed in the reverse order so that the lowest one
+	// is visited first
+	unsigned* successors = ws->num;
+	graph_sp_workspace_set_mark(ws, r, TRUE);
+	circular_buffer_push_back(stack, &r);
+
+	unsigned index = 0;
+	graph_compressed_iter_t it;
+	while (circular_buffer_size(stack) != 0) {
+		int vertex;
+		circular_buffer_pop_back(stack, &vertex);
+		values[index++] = vertex;
+		unsigned count = 0;
+		graph_compressed_neighbours(g, vertex, &it);
+		while (graph_compressed_next(&it)) {
+			if (graph_sp_workspace_get_mark(ws, it.to))
+				continue;
+			// Vertices are marked when pushed so that the stack never holds
+			// more than nb_vert vertices
+			graph_sp_workspace_set_mark(ws, it.to, TRUE);
+			if (father != NULL)
+				father[it.to] = vertex;
+			successors[count++] = it.to;
+		}
+		while (count != 0)
+			circular_buffer_push_back(stack, &successors[--count]);
+	}
+	return index;
+}
+
+int graph_compressed_preorder_dfs(graph_compressed_t* g,
+								  unsigned r,
+								  int* values,
+								  int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_compressed_preorder_dfs_ws(g, r, values, father, ws))
+}
+
+int graph_compressed_dijkstra_ws(graph_compressed_t* g,
+								 unsigned r,
+								 graph_weight_t* distance,
+								 int* father,
+								 graph_sp_workspace_t* ws) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_false_ret(r < g->nb_vert, -ERROR_INVALID_PARAM2);
+	when_null_ret(distance, -ERROR_INVALID_PARAM3);
+	when_null_ret(ws, -ERROR_INVALID_PARAM5);
+	when_false_ret(g->nb_vert <= ws->nb_vert, -ERROR_INVALID_PARAM5);
+	for (unsigned i = 0; i < g->nb_vert; i++)
+		distance[i] = GRAPH_WEIGHT_INF;
+	if (father) {
+		for (unsigned i = 0; i < g->nb_vert; i++)
+			father[i] = -1;
+	}
+	distance[r] = 0;
+	graph_sp_workspace_reset(ws);
+
+	heap_view_t* heap = graph_sp_workspace_heap(ws, g->nb_vert, r, distance);
+
+	unsigned number = 0;
+	int pivot;
+	graph_compressed_iter_t it;
+	while ((pivot = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (distance[pivot] == GRAPH_WEIGHT_INF)
+			break;
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
+		number++;
+
+		graph_compressed_neighbours(g, pivot, &it);
+		while (graph_compressed_next(&it)) {
+			if (graph_sp_workspace_get_mark(ws, it.to))
+				continue;
+			graph_weight_t d =
+				weight_add_truncate_overflow(distance[pivot], it.w);
+			if (d < distance[it.to]) {
+				weight_heap_update_up(heap, it.to, d);
+				if (father != NULL)
+					father[it.to] = pivot;
+			}
+		}
+	}
+	return number;
+}
+
+int graph_compressed_dijkstra(graph_compressed_t* g,
+							  unsigned r,
+							  graph_weight_t* distance,
+							  int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_compressed_dijkstra_ws(g, r, distance, father, ws))
+}
@@ -0,0 +1,35 @@
+#include "graph/graph_csr.h"
+#include <stdlib.h>
+#include "test_macros.h"
+
+graph_csr_t* create_graph_csr(unsigned nb_vert,
+							  size_t nb_edges,
+							  BOOL is_weighted) {
+	graph_csr_t* ret;
+	when_true_ret(nb_vert == 0, NULL);
+	graph_csr_t* g = calloc(1, sizeof(graph_csr_t));
+	when_null_ret(g, NULL);
+	g->nb_vert = nb_vert;
+	g->nb_edges = nb_edges;
+	g->offset = malloc((nb_vert + 1) * sizeof(size_t));
+	// The arrays are never empty so that NULL always means a failure
+	g->to = malloc((nb_edges ? nb_edges : 1) * sizeof(unsigned));
+	when_true_jmp(g->offset == NULL || g->to == NULL, NULL, error);
+	if (is_weighted) {
+		g->weights = malloc((nb_edges ? nb_edges : 1) * sizeof(graph_weight_t));
+		when_null_jmp(g->weights, NULL, error);
+	}
+	return g;
+error:
+	free_graph_csr(g);
+	return ret;
+}
+
+void free_graph_csr(graph_csr_t* g) {
+	if (g == NULL)
+		return;
+	free(g->offset);
+	free(g->to);
+	free(g->weights);
+	free(g);
+}
@@ -0,0 +1,179 @@
+#include "graph/graph_dynamic_sp.h"
+#include <stdlib.h>
+#include "errors.h"
+#include "graph_list_private.h"
+#include "heap_view.h"
+#include "test_macros.h"
+#include "weight_type.h"
+
+#define AFFECTED 1
+
+graph_dynamic_sp_t* create_graph_dynamic_sp(graph_list_t* g, unsigned r) {
+	graph_dynamic_sp_t* ret;
+	when_null_ret(g, NULL);
+	when_false_ret(r < g->nb_vert, NULL);
+	graph_dynamic_sp_t* dsp = calloc(1, sizeof(graph_dynamic_sp_t));
+	when_null_ret(dsp, NULL);
+
+	const unsigned n = g->nb_vert;
+	dsp->g = g;
+	dsp->root = r;
+	dsp->reverse = create_graph_list(n, g->is_weighted);
+	dsp->distance = malloc(n * sizeof(graph_weight_t));
+	dsp->father = malloc(n * sizeof(int));
+	dsp->ws = create_graph_sp_workspace(n);
+	when_true_jmp(dsp->reverse == NULL || dsp->distance == NULL ||
+					  dsp->father == NULL || dsp->ws == NULL,
+				  NULL, error);
+
+	for (unsigned i = 0; i < n; i++) {
+		foreach_node(&g->neighbours[i], e, graph_list_edge_t) {
+			when_false_jmp(graph_list_add_edge_noverif(dsp->reverse, e->to, i,
+													   e->w) == 0,
+						   NULL, error);
+		}
+	}
+
+	when_false_jmp(
+		graph_list_dijkstra_ws(g, r, dsp->distance, dsp->father, dsp->ws) >= 0,
+		NULL, error);
+	return dsp;
+error:
+	free_graph_dynamic_sp(dsp);
+	return ret;
+}
+
+void free_graph_dynamic_sp(graph_dynamic_sp_t* dsp) {
+	if (dsp == NULL)
+		return;
+	free_graph_list(dsp->reverse);
+	free(dsp->distance);
+	free(dsp->father);
+	free_graph_sp_workspace(dsp->ws);
+	free(dsp);
+}
+
+/**
+ * Settles the vertices of the heap in order of distance. If only_affected is
+ * TRUE, the distances are only propagated to the affected vertices.
+ */
+static unsigned propagate(graph_dynamic_sp_t* dsp,
+						  heap_view_t* heap,
+						  BOOL only_affected) {
+	unsigned count = 0;
+	int v;
+	while ((v = weight_heap_get_root(heap)) >= 0) {
+		count++;
+		foreach_node(&dsp->g->neighbours[v], e, graph_list_edge_t) {
+			if (only_affected &&
+				graph_sp_workspace_get_mark(dsp->ws, e->to) != AFFECTED)
+				continue;
+			const graph_weight_t d =
+				weight_add_truncate_overflow(dsp->distance[v], e->w);
+			if (d < dsp->distance[e->to]) {
+				dsp->father[e->to] = v;
+				weight_heap_push_vertex(heap, e->to, d);
+			}
+		}
+	}
+	return count;
+}
+
+static unsigned repair_decrease(graph_dynamic_sp_t* dsp,
+								unsigned a,
+								unsigned b,
+								graph_weight_t w) {
+	const graph_weight_t d = weight_add_truncate_overflow(dsp->distance[a], w);
+	if (d >= dsp->distance[b])
+		return 0;
+	heap_view_t* heap = dsp->ws->heap;
+	heap->data = dsp->distance;
+	heap->size = 0;
+	dsp->father[b] = a;
+	weight_heap_push_vertex(heap, b, d);
+	return propagate(dsp, heap, FALSE);
+}
+
+static unsigned repair_increase(graph_dynamic_sp_t* dsp, unsigned b) {
+	graph_sp_workspace_t* ws = dsp->ws;
+	graph_sp_workspace_reset(ws);
+
+	// Collects the subtree of b in the shortest path tree
+	unsigned* affected = ws->num;
+	unsigned count = 0;
+	affected[count++] = b;
+	graph_sp_workspace_set_mark(ws, b, AFFECTED);
+	for (unsigned i = 0; i < count; i++) {
+		const unsigned v = affected[i];
+		foreach_node(&dsp->g->neighbours[v], e, graph_list_edge_t) {
+			if (dsp->father[e->to] == (int)v &&
+				graph_sp_workspace_get_mark(ws, e->to) != AFFECTED) {
+				graph_sp_workspace_set_mark(ws, e->to, AFFECTED);
+				affected[count++] = e->to;
+			}
+		}
+	}
+	for (unsigned i = 0; i < count; i++) {
+		dsp->distance[affected[i]] = GRAPH_WEIGHT_INF;
+		dsp->father[affected[i]] = -1;
+	}
+
+	// Each affected vertex is reached through its best predecessor outside
+	// of the subtree
+	heap_view_t* heap = ws->heap;
+	heap->data = dsp->distance;
+	heap->size = 0;
+	for (unsigned i = 0; i < count; i++) {
+		const unsigned v = affected[i];
+		graph_weight_t best = GRAPH_WEIGHT_INF;
+		foreach_node(&dsp->reverse->neighbours[v], e, graph_list_edge_t) {
+			if (graph_sp_workspace_get_mark(ws, e->to) == AFFECTED)
+				continue;
+			const graph_weight_t d =
+				weight_add_truncate_overflow(dsp->distance[e->to], e->w);
+			if (d < best) {
+				best = d;
+				dsp->father[v] = e->to;
+			}
+		}
+		if (best != GRAPH_WEIGHT_INF)
+			weight_heap_push_vertex(heap, v, best);
+	}
+	propagate(dsp, heap, TRUE);
+	return count;
+}
+
+int graph_dynamic_sp_set_edge(graph_dynamic_sp_t* dsp,
+							  unsigned a,
+							  unsigned b,
+							  BOOL val,
+							  graph_weight_t weight,
+							  BOOL reverse) {
+	when_null_ret(dsp, -ERROR_INVALID_PARAM1);
+	when_false_ret(a < dsp->g->nb_vert, -ERROR_INVALID_PARAM2);
+	when_false_ret(b < dsp->g->nb_vert, -ERROR_INVALID_PARAM3);
+	if (dsp->g->is_weighted == FALSE)
+		weight = 1;
+	when_true_ret(val && weight < 0, -ERROR_INVALID_PARAM5);
+
+	int count = 0;
+	if (reverse) {
+		count = graph_dynamic_sp_set_edge(dsp, b, a, val, weight, FALSE);
+		when_true_ret(count < 0, count);
+	}
+
+	graph_list_edge_t* old = graph_list_get_edge(dsp->g, a, b);
+	if (old == NULL && val == FALSE)
+		return count;
+	const BOOL decrease = val && (old == NULL || weight < old->w);
+	const BOOL increase = old != NULL && (val == FALSE || weight > old->w);
+
+	graph_list_set_edge(dsp->g, a, b, val, weight, FALSE);
+	graph_list_set_edge(dsp->reverse, b, a, val, weight, FALSE);
+
+	if (decrease)
+		count += repair_decrease(dsp, a, b, weight);
+	else if (increase && dsp->father[b] == (int)a)
+		count += repair_increase(dsp, b);
+	return count;
+}
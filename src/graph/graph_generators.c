@@ -0,0 +1,332 @@
+#include "graph/graph_generators.h"
+#include <math.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "graph_list_private.h"
+#include "prng.h"
+#include "test_macros.h"
+
+/**
+ * Edge array being generated, the edges are appended with push_edge()
+ */
+typedef struct generator {
+	graph_edge_array_t* array;
+	size_t capacity;
+	graph_weight_t max_weight;
+	prng_t rng;
+} generator_t;
+
+static int init_generator(generator_t* gen,
+						  unsigned n,
+						  size_t capacity,
+						  graph_weight_t max_weight,
+						  uint64_t seed) {
+	gen->array = malloc(sizeof(graph_edge_array_t));
+	when_null_ret(gen->array, -ERROR_ALLOCATION_FAILED);
+	gen->capacity = capacity ? capacity : 1;
+	gen->array->edges = malloc(gen->capacity * sizeof(graph_edge_t));
+	if (gen->array->edges == NULL) {
+		free(gen->array);
+		return -ERROR_ALLOCATION_FAILED;
+	}
+	gen->array->nb_vert = n;
+	gen->array->nb_edges = 0;
+	gen->array->is_weighted = max_weight > 0;
+	gen->max_weight = max_weight;
+	prng_seed(&gen->rng, seed);
+	return -ERROR_NO_ERROR;
+}
+
+static graph_weight_t draw_weight(generator_t* gen) {
+	if (gen->max_weight <= 0)
+		return 1;
+	const uint64_t bound = gen->max_weight;
+	// Rejects the lowest 2^64 % bound draws so that every weight is as likely
+	const uint64_t threshold = -bound % bound;
+	uint64_t r;
+	do
+		r = prng_next(&gen->rng);
+	while (r < threshold);
+	return 1 + r % bound;
+}
+
+static int push_edge(generator_t* gen, unsigned from, unsigned to) {
+	graph_edge_array_t* array = gen->array;
+	if (array->nb_edges == gen->capacity) {
+		graph_edge_t* edges =
+			realloc(array->edges, 2 * gen->capacity * sizeof(graph_edge_t));
+		when_null_ret(edges, -ERROR_ALLOCATION_FAILED);
+		array->edges = edges;
+		gen->capacity *= 2;
+	}
+	array->edges[array->nb_edges++] =
+		(graph_edge_t){from, to, draw_weight(gen)};
+	return -ERROR_NO_ERROR;
+}
+
+/**
+ * Random permutation of [0, n[ (Fisher-Yates shuffle)
+ */
+static unsigned* random_permutation(prng_t* rng, unsigned n) {
+	unsigned* perm = malloc((n ? n : 1) * sizeof(unsigned));
+	when_null_ret(perm, NULL);
+	for (unsigned i = 0; i < n; i++)
+		perm[i] = i;
+	for (unsigned i = n; i > 1; i--) {
+		const unsigned j = prng_bounded(rng, i);
+		const unsigned tmp = perm[i - 1];
+		perm[i - 1] = perm[j];
+		perm[j] = tmp;
+	}
+	return perm;
+}
+
+/**
+ * Number of trials to skip before the next success of a Bernoulli process of
+ * parameter p, log_q = log1p(-p)
+ */
+static uint64_t geometric_skip(prng_t* rng, double log_q) {
+	const double skip = floor(log1p(-prng_double(rng)) / log_q);
+	return skip >= (double)UINT64_MAX ? UINT64_MAX : (uint64_t)skip;
+}
+
+/**
+ * Sorts the edges by origin then destination with two counting sorts, in
+ * O(V + E)
+ */
+static int sort_edges(graph_edge_array_t* array) {
+	const unsigned n = array->nb_vert;
+	graph_edge_t* tmp = malloc((array->nb_edges + 1) * sizeof(graph_edge_t));
+	size_t* count = malloc((n + 1) * sizeof(size_t));
+	if (tmp == NULL || count == NULL) {
+		free(tmp);
+		free(count);
+		return -ERROR_ALLOCATION_FAILED;
+	}
+	graph_edge_t* from = array->edges;
+	graph_edge_t* to = tmp;
+	for (unsigned pass = 0; pass < 2; pass++) {
+		// The first pass sorts by destination, the second one (stable) by
+		// origin
+		for (unsigned i = 0; i <= n; i++)
+			count[i] = 0;
+		for (size_t i = 0; i < array->nb_edges; i++)
+			count[(pass == 0 ? from[i].to : from[i].from) + 1]++;
+		for (unsigned i = 0; i < n; i++)
+			count[i + 1] += count[i];
+		for (size_t i = 0; i < array->nb_edges; i++) {
+			const unsigned key = pass == 0 ? from[i].to : from[i].from;
+			to[count[key]++] = from[i];
+		}
+		graph_edge_t* swap = from;
+		from = to;
+		to = swap;
+	}
+	// After an even number of passes the edges are back in array->edges
+	free(tmp);
+	free(count);
+	return -ERROR_NO_ERROR;
+}
+
+void free_graph_edge_array(graph_edge_array_t* edges) {
+	if (edges == NULL)
+		return;
+	free(edges->edges);
+	free(edges);
+}
+
+graph_list_t* graph_edge_array_to_graph_list(const graph_edge_array_t* edges) {
+	graph_list_t* ret;
+	when_null_ret(edges, NULL);
+	graph_list_t* g = create_graph_list(edges->nb_vert, edges->is_weighted);
+	when_null_ret(g, NULL);
+	for (size_t i = 0; i < edges->nb_edges; i++) {
+		const graph_edge_t* e = &edges->edges[i];
+		when_false_jmp(graph_list_add_edge_noverif(g, e->from, e->to, e->w) ==
+						   ERROR_NO_ERROR,
+					   NULL, error);
+	}
+	return g;
+error:
+	free_graph_list(g);
+	return ret;
+}
+
+graph_mat_t* graph_edge_array_to_graph_mat(const graph_edge_array_t* edges) {
+	when_null_ret(edges, NULL);
+	graph_mat_t* g = create_graph_mat(edges->nb_vert, edges->is_weighted);
+	when_null_ret(g, NULL);
+	for (size_t i = 0; i < edges->nb_edges; i++) {
+		const graph_edge_t* e = &edges->edges[i];
+		graph_mat_set_edge(g, e->from, e->to, TRUE, e->w, FALSE);
+	}
+	return g;
+}
+
+graph_edge_array_t* graph_generate_rmat(unsigned scale,
+										size_t nb_edges,
+										double a,
+										double b,
+										double c,
+										graph_weight_t max_weight,
+										uint64_t seed) {
+	graph_edge_array_t* ret;
+	when_false_ret(scale < 32, NULL);
+	when_false_ret(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1, NULL);
+	const unsigned n = 1u << scale;
+	generator_t gen;
+	when_false_ret(init_generator(&gen, n, nb_edges, max_weight, seed) ==
+					   ERROR_NO_ERROR,
+				   NULL);
+	graph_edge_array_t* array = gen.array;
+
+	// The vertices are shuffled so that the high degree ones are not all
+	// packed at the beginning
+	unsigned* perm = random_permutation(&gen.rng, n);
+	when_null_jmp(perm, NULL, error);
+
+	for (size_t i = 0; i < nb_edges; i++) {
+		unsigned from = 0, to = 0;
+		for (unsigned bit = n >> 1; bit != 0; bit >>= 1) {
+			const double r = prng_double(&gen.rng);
+			if (r >= a + b + c) {
+				from |= bit;
+				to |= bit;
+			} else if (r >= a + b)
+				from |= bit;
+			else if (r >= a)
+				to |= bit;
+		}
+		if (from != to)
+			array->edges[array->nb_edges++] =
+				(graph_edge_t){perm[from], perm[to], 0};
+	}
+	free(perm);
+
+	when_false_jmp(sort_edges(array) == ERROR_NO_ERROR, NULL, error);
+	// Removes the duplicated edges then draws the weights
+	size_t size = 0;
+	for (size_t i = 0; i < array->nb_edges; i++) {
+		if (size != 0 && array->edges[size - 1].from == array->edges[i].from &&
+			array->edges[size - 1].to == array->edges[i].to)
+			continue;
+		array->edges[size] = array->edges[i];
+		array->edges[size++].w = draw_weight(&gen);
+	}
+	array->nb_edges = size;
+	return array;
+error:
+	free_graph_edge_array(array);
+	return ret;
+}
+
+graph_edge_array_t* graph_generate_grid(unsigned rows,
+										unsigned cols,
+										graph_weight_t max_weight,
+										uint64_t seed) {
+	when_true_ret(rows == 0 || cols == 0, NULL);
+	const size_t capacity = 2 * ((size_t)(rows - 1) * cols +
+								 (size_t)rows * (cols - 1));
+	generator_t gen;
+	when_false_ret(init_generator(&gen, rows * cols, capacity, max_weight,
+								  seed) == ERROR_NO_ERROR,
+				   NULL);
+
+	for (unsigned i = 0; i < rows; i++) {
+		for (unsigned j = 0; j < cols; j++) {
+			const unsigned v = i * cols + j;
+			// The neighbours are pushed by increasing index
+			if (i > 0)
+				push_edge(&gen, v, v - cols);
+			if (j > 0)
+				push_edge(&gen, v, v - 1);
+			if (j + 1 < cols)
+				push_edge(&gen, v, v + 1);
+			if (i + 1 < rows)
+				push_edge(&gen, v, v + cols);
+		}
+	}
+	return gen.array;
+}
+
+graph_edge_array_t* graph_generate_gnp(unsigned n,
+									   double p,
+									   graph_weight_t max_weight,
+									   uint64_t seed) {
+	graph_edge_array_t* ret;
+	when_true_ret(n == 0 || p < 0 || p > 1, NULL);
+	const uint64_t total = (uint64_t)n * (n - 1);
+	generator_t gen;
+	when_false_ret(init_generator(&gen, n, total * p + 1, max_weight, seed) ==
+					   ERROR_NO_ERROR,
+				   NULL);
+	if (p == 0)
+		return gen.array;
+
+	// log1p keeps the precision of log(1 - p) for small p
+	const double log_q = log1p(-p);
+	// The k-th trial is the edge (k / (n - 1), k % (n - 1)) with the
+	// destinations after the origin shifted to skip the self loop
+	uint64_t k = p == 1 ? 0 : geometric_skip(&gen.rng, log_q);
+	while (k < total) {
+		const unsigned from = k / (n - 1);
+		unsigned to = k % (n - 1);
+		if (to >= from)
+			to++;
+		when_false_jmp(push_edge(&gen, from, to) == ERROR_NO_ERROR, NULL,
+					   error);
+		const uint64_t skip = p == 1 ? 0 : geometric_skip(&gen.rng, log_q);
+		if (skip >= total - k)
+			break;
+		k += skip + 1;
+	}
+	return gen.array;
+error:
+	free_graph_edge_array(gen.array);
+	return ret;
+}
+
+graph_edge_array_t* graph_generate_dag(unsigned n,
+									   double p,
+									   graph_weight_t max_weight,
+									   uint64_t seed) {
+	graph_edge_array_t* ret;
+	when_true_ret(n == 0 || p < 0 || p > 1, NULL);
+	const uint64_t total = (uint64_t)n * (n - 1) / 2;
+	generator_t gen;
+	when_false_ret(init_generator(&gen, n, total * p + 1, max_weight, seed) ==
+					   ERROR_NO_ERROR,
+				   NULL);
+	unsigned* order = random_permutation(&gen.rng, n);
+	when_null_jmp(order, NULL, error);
+	if (p == 0) {
+		free(order);
+		return gen.array;
+	}
+
+	const double log_q = log1p(-p);
+	// The trials are the pairs (i, j) with i < j in lexicographic order, the
+	// row i starts at the trial row_start and has n - 1 - i trials
+	unsigned i = 0;
+	uint64_t row_start = 0;
+	uint64_t k = p == 1 ? 0 : geometric_skip(&gen.rng, log_q);
+	while (k < total) {
+		while (k >= row_start + (n - 1 - i)) {
+			row_start += n - 1 - i;
+			i++;
+		}
+		const unsigned j = i + 1 + (k - row_start);
+		when_false_jmp(push_edge(&gen, order[i], order[j]) == ERROR_NO_ERROR,
+					   NULL, error);
+		const uint64_t skip = p == 1 ? 0 : geometric_skip(&gen.rng, log_q);
+		if (skip >= total - k)
+			break;
+		k += skip + 1;
+	}
+	free(order);
+	return gen.array;
+error:
+	free(order);
+	free_graph_edge_array(gen.array);
+	return ret;
+}
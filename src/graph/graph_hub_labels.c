@@ -0,0 +1,421 @@
+#include "graph/graph_hub_labels.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dynarray.h"
+#include "errors.h"
+#include "graph/graph_workspace.h"
+#include "graph_list_private.h"
+#include "heap_view.h"
+#include "test_macros.h"
+
+static const char magic[4] = {'P', 'L', 'L', '1'};
+
+typedef struct label_entry {
+	unsigned hub;
+	graph_weight_t d;
+} label_entry_t;
+
+typedef struct ranked_vertex {
+	unsigned degree;
+	unsigned v;
+} ranked_vertex_t;
+
+/**
+ * State of the construction. The search from the hub of rank k reads the
+ * labels of the side "src" of the hub and extends the labels of the side
+ * "dst" of the vertices it reaches.
+ */
+typedef struct pll_builder {
+	unsigned nb_vert;
+	dynarray_t** in;
+	dynarray_t** out;
+	graph_weight_t* hub_dist;
+	/**< Distances to or from the hubs of the current vertex, by rank */
+	graph_sp_workspace_t* ws;
+} pll_builder_t;
+
+static int compare_ranked_vertex(const void* a, const void* b) {
+	const ranked_vertex_t* x = a;
+	const ranked_vertex_t* y = b;
+	if (x->degree != y->degree)
+		return x->degree < y->degree ? 1 : -1;
+	return (x->v > y->v) - (x->v < y->v);
+}
+
+static unsigned* degree_order(graph_list_t* g) {
+	const unsigned n = g->nb_vert;
+	ranked_vertex_t* rv = calloc(n, sizeof(ranked_vertex_t));
+	when_null_ret(rv, NULL);
+	for (unsigned i = 0; i < n; i++) {
+		rv[i].v = i;
+		foreach_node(&g->neighbours[i], e, graph_list_edge_t) {
+			rv[i].degree++;
+			rv[e->to].degree++;
+		}
+	}
+	qsort(rv, n, sizeof(ranked_vertex_t), compare_ranked_vertex);
+	unsigned* order = malloc(n * sizeof(unsigned));
+	if (order != NULL) {
+		for (unsigned i = 0; i < n; i++)
+			order[i] = rv[i].v;
+	}
+	free(rv);
+	return order;
+}
+
+/**
+ * Returns TRUE if the labels built so far give a path of length at most d
+ * between the current hub and v (the hub_dist array is loaded with the
+ * labels of the hub).
+ */
+static BOOL is_covered(const pll_builder_t* b,
+					   const dynarray_t* label,
+					   graph_weight_t d) {
+	const label_entry_t* entries = (const label_entry_t*)label->data;
+	for (unsigned i = 0; i < label->size; i++) {
+		const graph_weight_t hd = b->hub_dist[entries[i].hub];
+		if (hd != GRAPH_WEIGHT_INF &&
+			weight_add_truncate_overflow(hd, entries[i].d) <= d)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+static void load_hub(pll_builder_t* b, const dynarray_t* label, BOOL reset) {
+	const label_entry_t* entries = (const label_entry_t*)label->data;
+	for (unsigned i = 0; i < label->size; i++)
+		b->hub_dist[entries[i].hub] = reset ? GRAPH_WEIGHT_INF : entries[i].d;
+}
+
+/**
+ * Pruned search from the hub h of rank k in g. The reached vertices are
+ * recorded in ws->num so that their distances can be reset to infinity.
+ */
+static int pruned_search(pll_builder_t* b,
+						 graph_list_t* g,
+						 unsigned k,
+						 unsigned h,
+						 dynarray_t** src,
+						 dynarray_t** dst) {
+	graph_sp_workspace_t* ws = b->ws;
+	graph_weight_t* distance = ws->distance;
+	unsigned* visited = ws->num;
+	unsigned nb_visited = 0;
+	int ret = -ERROR_NO_ERROR;
+
+	load_hub(b, src[h], FALSE);
+	distance[h] = 0;
+	visited[nb_visited++] = h;
+	if (g->is_weighted) {
+		heap_view_t* heap = ws->heap;
+		heap->data = distance;
+		heap->size = 0;
+		weight_heap_push_vertex(heap, h, 0);
+		int v;
+		while ((v = weight_heap_get_root(heap)) >= 0) {
+			const graph_weight_t d = distance[v];
+			if (is_covered(b, dst[v], d))
+				continue;
+			label_entry_t entry = {k, d};
+			if (dynarray_push_back(dst[v], &entry) == NULL) {
+				ret = -ERROR_ALLOCATION_FAILED;
+				heap->size = 0;
+				break;
+			}
+			foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+				const graph_weight_t nd = weight_add_truncate_overflow(d, e->w);
+				if (nd >= distance[e->to])
+					continue;
+				if (distance[e->to] == GRAPH_WEIGHT_INF)
+					visited[nb_visited++] = e->to;
+				weight_heap_push_vertex(heap, e->to, nd);
+			}
+		}
+	} else {
+		// The visited vertices are the BFS queue
+		for (unsigned head = 0; head < nb_visited; head++) {
+			const unsigned v = visited[head];
+			const graph_weight_t d = distance[v];
+			if (is_covered(b, dst[v], d))
+				continue;
+			label_entry_t entry = {k, d};
+			if (dynarray_push_back(dst[v], &entry) == NULL) {
+				ret = -ERROR_ALLOCATION_FAILED;
+				break;
+			}
+			foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+				if (distance[e->to] != GRAPH_WEIGHT_INF)
+					continue;
+				distance[e->to] = d + 1;
+				visited[nb_visited++] = e->to;
+			}
+		}
+	}
+	for (unsigned i = 0; i < nb_visited; i++)
+		distance[visited[i]] = GRAPH_WEIGHT_INF;
+	load_hub(b, src[h], TRUE);
+	return ret;
+}
+
+static void free_labels(dynarray_t** labels, unsigned n) {
+	if (labels == NULL)
+		return;
+	for (unsigned i = 0; i < n; i++)
+		free_dynarray(labels[i]);
+	free(labels);
+}
+
+static dynarray_t** create_labels(unsigned n) {
+	dynarray_t** labels = calloc(n, sizeof(dynarray_t*));
+	when_null_ret(labels, NULL);
+	for (unsigned i = 0; i < n; i++) {
+		labels[i] = create_dynarray(sizeof(label_entry_t));
+		if (labels[i] == NULL) {
+			free_labels(labels, n);
+			return NULL;
+		}
+	}
+	return labels;
+}
+
+static graph_hub_labels_t* alloc_hub_labels(unsigned n,
+											size_t nb_in,
+											size_t nb_out) {
+	graph_hub_labels_t* ret;
+	graph_hub_labels_t* labels = calloc(1, sizeof(graph_hub_labels_t));
+	when_null_ret(labels, NULL);
+	labels->nb_vert = n;
+	labels->in_offset = malloc((n + 1) * sizeof(size_t));
+	labels->out_offset = malloc((n + 1) * sizeof(size_t));
+	// The arrays are never empty so that NULL always means a failure
+	labels->in_hub = malloc((nb_in ? nb_in : 1) * sizeof(unsigned));
+	labels->in_dist = malloc((nb_in ? nb_in : 1) * sizeof(graph_weight_t));
+	labels->out_hub = malloc((nb_out ? nb_out : 1) * sizeof(unsigned));
+	labels->out_dist = malloc((nb_out ? nb_out : 1) * sizeof(graph_weight_t));
+	when_true_jmp(labels->in_offset == NULL || labels->out_offset == NULL ||
+					  labels->in_hub == NULL || labels->in_dist == NULL ||
+					  labels->out_hub == NULL || labels->out_dist == NULL,
+				  NULL, error);
+	return labels;
+error:
+	free_graph_hub_labels(labels);
+	return ret;
+}
+
+static size_t count_entries(dynarray_t** labels, unsigned n) {
+	size_t count = 0;
+	for (unsigned i = 0; i < n; i++)
+		count += labels[i]->size;
+	return count;
+}
+
+static void pack_labels(dynarray_t** labels,
+						unsigned n,
+						size_t* offset,
+						unsigned* hub,
+						graph_weight_t* dist) {
+	offset[0] = 0;
+	for (unsigned i = 0; i < n; i++) {
+		const label_entry_t* entries = (const label_entry_t*)labels[i]->data;
+		size_t o = offset[i];
+		for (unsigned j = 0; j < labels[i]->size; j++, o++) {
+			hub[o] = entries[j].hub;
+			dist[o] = entries[j].d;
+		}
+		offset[i + 1] = o;
+	}
+}
+
+graph_hub_labels_t* create_graph_hub_labels(graph_list_t* g) {
+	graph_hub_labels_t* ret;
+	when_null_ret(g, NULL);
+	const unsigned n = g->nb_vert;
+	graph_hub_labels_t* labels = NULL;
+	pll_builder_t b = {n, NULL, NULL, NULL, NULL};
+	graph_list_t* reverse = create_graph_list(n, g->is_weighted);
+	unsigned* order = degree_order(g);
+	b.in = create_labels(n);
+	b.out = create_labels(n);
+	b.hub_dist = malloc(n * sizeof(graph_weight_t));
+	b.ws = create_graph_sp_workspace(n);
+	when_true_jmp(reverse == NULL || order == NULL || b.in == NULL ||
+					  b.out == NULL || b.hub_dist == NULL || b.ws == NULL,
+				  NULL, end);
+
+	for (unsigned i = 0; i < n; i++) {
+		b.hub_dist[i] = GRAPH_WEIGHT_INF;
+		b.ws->distance[i] = GRAPH_WEIGHT_INF;
+		foreach_node(&g->neighbours[i], e, graph_list_edge_t) {
+			when_false_jmp(
+				graph_list_add_edge_noverif(reverse, e->to, i, e->w) == 0, NULL,
+				end);
+		}
+	}
+
+	for (unsigned k = 0; k < n; k++) {
+		const unsigned h = order[k];
+		when_false_jmp(pruned_search(&b, g, k, h, b.out, b.in) == 0, NULL, end);
+		when_false_jmp(pruned_search(&b, reverse, k, h, b.in, b.out) == 0, NULL,
+					   end);
+	}
+
+	labels = alloc_hub_labels(n, count_entries(b.in, n),
+							  count_entries(b.out, n));
+	when_null_jmp(labels, NULL, end);
+	pack_labels(b.in, n, labels->in_offset, labels->in_hub, labels->in_dist);
+	pack_labels(b.out, n, labels->out_offset, labels->out_hub,
+				labels->out_dist);
+	ret = labels;
+end:
+	free_graph_list(reverse);
+	free(order);
+	free_labels(b.in, n);
+	free_labels(b.out, n);
+	free(b.hub_dist);
+	free_graph_sp_workspace(b.ws);
+	return ret;
+}
+
+void free_graph_hub_labels(graph_hub_labels_t* labels) {
+	if (labels == NULL)
+		return;
+	free(labels->in_offset);
+	free(labels->in_hub);
+	free(labels->in_dist);
+	free(labels->out_offset);
+	free(labels->out_hub);
+	free(labels->out_dist);
+	free(labels);
+}
+
+graph_weight_t graph_hub_labels_distance(const graph_hub_labels_t* labels,
+										 unsigned s,
+										 unsigned t) {
+	size_t i = labels->out_offset[s];
+	size_t j = labels->in_offset[t];
+	const size_t i_end = labels->out_offset[s + 1];
+	const size_t j_end = labels->in_offset[t + 1];
+	graph_weight_t best = GRAPH_WEIGHT_INF;
+	while (i < i_end && j < j_end) {
+		const unsigned a = labels->out_hub[i];
+		const unsigned b = labels->in_hub[j];
+		if (a == b) {
+			const graph_weight_t d = weight_add_truncate_overflow(
+				labels->out_dist[i], labels->in_dist[j]);
+			best = MIN(best, d);
+		}
+		i += a <= b;
+		j += b <= a;
+	}
+	return best;
+}
+
+size_t graph_hub_labels_size(const graph_hub_labels_t* labels) {
+	return labels->in_offset[labels->nb_vert] +
+		   labels->out_offset[labels->nb_vert];
+}
+
+static BOOL write_offsets(FILE* file, unsigned n, const size_t* offset) {
+	for (unsigned i = 0; i <= n; i++) {
+		const uint64_t o = offset[i];
+		if (fwrite(&o, sizeof(o), 1, file) != 1)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static BOOL write_entries(FILE* file,
+						  size_t count,
+						  const unsigned* hub,
+						  const graph_weight_t* dist) {
+	for (size_t i = 0; i < count; i++) {
+		const uint32_t h = hub[i];
+		if (fwrite(&h, sizeof(h), 1, file) != 1)
+			return FALSE;
+	}
+	return fwrite(dist, sizeof(graph_weight_t), count, file) == count;
+}
+
+int graph_hub_labels_save(const graph_hub_labels_t* labels, FILE* file) {
+	when_null_ret(labels, -ERROR_INVALID_PARAM1);
+	when_null_ret(file, -ERROR_INVALID_PARAM2);
+	const unsigned n = labels->nb_vert;
+	const uint32_t header[2] = {sizeof(graph_weight_t), n};
+	if (fwrite(magic, sizeof(magic), 1, file) != 1 ||
+		fwrite(header, sizeof(header), 1, file) != 1 ||
+		!write_offsets(file, n, labels->in_offset) ||
+		!write_offsets(file, n, labels->out_offset) ||
+		!write_entries(file, labels->in_offset[n], labels->in_hub,
+					   labels->in_dist) ||
+		!write_entries(file, labels->out_offset[n], labels->out_hub,
+					   labels->out_dist))
+		return -ERROR_IO;
+	return fflush(file) == 0 ? -ERROR_NO_ERROR : -ERROR_IO;
+}
+
+/**
+ * Reads the offsets of one side and returns the number of entries, or
+ * SIZE_MAX if the offsets are not increasing from 0.
+ */
+static size_t read_offsets(FILE* file, unsigned n, size_t* offset) {
+	for (unsigned i = 0; i <= n; i++) {
+		uint64_t o;
+		if (fread(&o, sizeof(o), 1, file) != 1 || o > SIZE_MAX / 2 ||
+			(i == 0 && o != 0) || (i > 0 && o < offset[i - 1]))
+			return SIZE_MAX;
+		offset[i] = o;
+	}
+	return offset[n];
+}
+
+static BOOL read_entries(FILE* file,
+						 unsigned n,
+						 size_t count,
+						 unsigned* hub,
+						 graph_weight_t* dist) {
+	for (size_t i = 0; i < count; i++) {
+		uint32_t h;
+		if (fread(&h, sizeof(h), 1, file) != 1 || h >= n)
+			return FALSE;
+		hub[i] = h;
+	}
+	return fread(dist, sizeof(graph_weight_t), count, file) == count;
+}
+
+graph_hub_labels_t* graph_hub_labels_load(FILE* file) {
+	when_null_ret(file, NULL);
+	char m[sizeof(magic)];
+	uint32_t header[2];
+	if (fread(m, sizeof(m), 1, file) != 1 ||
+		memcmp(m, magic, sizeof(magic)) != 0 ||
+		fread(header, sizeof(header), 1, file) != 1 ||
+		header[0] != sizeof(graph_weight_t) || header[1] == 0)
+		return NULL;
+	const unsigned n = header[1];
+
+	// The offsets come first so that the arrays can be sized
+	size_t* offset = malloc(2 * (n + 1) * sizeof(size_t));
+	if (offset == NULL)
+		return NULL;
+	const size_t nb_in = read_offsets(file, n, offset);
+	size_t nb_out = SIZE_MAX;
+	if (nb_in != SIZE_MAX)
+		nb_out = read_offsets(file, n, offset + n + 1);
+	graph_hub_labels_t* labels = NULL;
+	if (nb_out != SIZE_MAX)
+		labels = alloc_hub_labels(n, nb_in, nb_out);
+	if (labels != NULL) {
+		memcpy(labels->in_offset, offset, (n + 1) * sizeof(size_t));
+		memcpy(labels->out_offset, offset + n + 1, (n + 1) * sizeof(size_t));
+	}
+	free(offset);
+	if (labels == NULL)
+		return NULL;
+	if (!read_entries(file, n, nb_in, labels->in_hub, labels->in_dist) ||
+		!read_entries(file, n, nb_out, labels->out_hub, labels->out_dist)) {
+		free_graph_hub_labels(labels);
+		return NULL;
+	}
+	return labels;
+}
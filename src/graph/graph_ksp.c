@@ -0,0 +1,369 @@
+#include "graph/graph_ksp.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compare.h"
+#include "dynarray.h"
+#include "errors.h"
+#include "heap_view.h"
+#include "priority_queue.h"
+#include "test_macros.h"
+
+DEFINE_COMPARE_MIN_SCALAR(graph_weight_t)
+
+/**
+ * Dijkstra buffers shared by every spur path search. A vertex v is removed
+ * from the graph if banned[v] == stamp, and the edge (spur, v) if
+ * banned_next[v] == stamp.
+ */
+typedef struct spur_search {
+	graph_weight_t* distance;
+	int* father;
+	unsigned* banned;
+	unsigned* banned_next;
+	unsigned stamp;
+	heap_view_t* heap;
+} spur_search_t;
+
+/**
+ * A candidate path, its vertices are stored in candidates#vertices from offset
+ * to offset + length
+ */
+typedef struct candidate {
+	graph_weight_t cost;
+	unsigned offset;
+	unsigned length;
+	uint64_t hash;
+} candidate_t;
+
+/**
+ * Entry of the priority queue of the candidates not accepted yet
+ */
+typedef struct candidate_key {
+	graph_weight_t cost;
+	unsigned index;
+} candidate_key_t;
+
+/**
+ * Candidate paths. Every candidate ever added is kept in list to detect the
+ * duplicates: table is an open addressing hash set of the indexes (plus one,
+ * 0 being an empty bucket) of the candidates in list.
+ */
+typedef struct candidates {
+	dynarray_t* vertices;
+	dynarray_t* list;
+	priority_queue_t* queue;
+	unsigned* table;
+	unsigned table_size;
+} candidates_t;
+
+static void free_spur_search(spur_search_t* s) {
+	free(s->distance);
+	free(s->father);
+	free(s->banned);
+	free_heap(s->heap);
+}
+
+static int init_spur_search(spur_search_t* s, unsigned n) {
+	s->distance = malloc(n * sizeof(graph_weight_t));
+	s->father = malloc(n * sizeof(int));
+	s->banned = calloc(2 * n, sizeof(unsigned));
+	s->banned_next = s->banned ? s->banned + n : NULL;
+	s->stamp = 0;
+	s->heap = s->distance ? create_heap(n, sizeof(graph_weight_t), s->distance,
+										compare_min_graph_weight_t)
+						  : NULL;
+	if (s->father == NULL || s->banned == NULL || s->heap == NULL) {
+		free_spur_search(s);
+		return -ERROR_ALLOCATION_FAILED;
+	}
+	return -ERROR_NO_ERROR;
+}
+
+static void next_stamp(spur_search_t* s, unsigned n) {
+	if (++s->stamp == 0) {
+		memset(s->banned, 0, 2 * n * sizeof(unsigned));
+		s->stamp = 1;
+	}
+}
+
+/**
+ * Dijkstra from src which stops as soon as dst is reached, ignoring the banned
+ * vertices and the banned edges going out of src
+ */
+static BOOL spur_dijkstra(graph_list_t* g,
+						  spur_search_t* s,
+						  unsigned src,
+						  unsigned dst) {
+	heap_view_t* heap = s->heap;
+	heap->size = g->nb_vert;
+	for (unsigned i = 0; i < g->nb_vert; i++) {
+		s->distance[i] = GRAPH_WEIGHT_INF;
+		s->father[i] = -1;
+		heap->idx_to_pos[i] = i;
+		heap->pos_to_idx[i] = i;
+	}
+	// We put src at the root of (index, distance) which makes it a heap
+	s->distance[src] = 0;
+	heap->idx_to_pos[src] = 0;
+	heap->idx_to_pos[0] = src;
+	heap->pos_to_idx[src] = 0;
+	heap->pos_to_idx[0] = src;
+
+	int pivot;
+	while ((pivot = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (s->distance[pivot] == GRAPH_WEIGHT_INF)
+			break;
+		if ((unsigned)pivot == dst)
+			return TRUE;
+		foreach_node(&g->neighbours[pivot], e, graph_list_edge_t) {
+			// Vertices already popped are outside of the heap
+			if (heap->idx_to_pos[e->to] >= heap->size ||
+				s->banned[e->to] == s->stamp)
+				continue;
+			if ((unsigned)pivot == src && s->banned_next[e->to] == s->stamp)
+				continue;
+			graph_weight_t d =
+				weight_add_truncate_overflow(s->distance[pivot], e->w);
+			if (d < s->distance[e->to]) {
+				weight_heap_update_up(heap, e->to, d);
+				s->father[e->to] = pivot;
+			}
+		}
+	}
+	return FALSE;
+}
+
+static void free_candidates(candidates_t* c) {
+	if (c->vertices)
+		free_dynarray(c->vertices);
+	if (c->list)
+		free_dynarray(c->list);
+	free_priority_queue(c->queue);
+	free(c->table);
+}
+
+/**
+ * Lowest cost first, then the first candidate found
+ */
+static int compare_candidate_key(void* a, void* b) {
+	const candidate_key_t* x = a;
+	const candidate_key_t* y = b;
+	if (x->cost != y->cost)
+		return (x->cost < y->cost) - (x->cost > y->cost);
+	return (x->index < y->index) - (x->index > y->index);
+}
+
+#define CANDIDATES_TABLE_MIN_SIZE 64
+
+static int init_candidates(candidates_t* c) {
+	c->vertices = create_dynarray(sizeof(unsigned));
+	c->list = create_dynarray(sizeof(candidate_t));
+	c->queue =
+		create_priority_queue(sizeof(candidate_key_t), compare_candidate_key);
+	c->table_size = CANDIDATES_TABLE_MIN_SIZE;
+	c->table = calloc(c->table_size, sizeof(unsigned));
+	if (c->vertices == NULL || c->list == NULL || c->queue == NULL ||
+		c->table == NULL) {
+		free_candidates(c);
+		return -ERROR_ALLOCATION_FAILED;
+	}
+	return -ERROR_NO_ERROR;
+}
+
+static candidate_t* get_candidate(candidates_t* c, unsigned i) {
+	return get_dynarray_ref(c->list, i, candidate_t);
+}
+
+static unsigned* candidate_vertices(candidates_t* c, unsigned i) {
+	return get_dynarray_ref(c->vertices, get_candidate(c, i)->offset,
+							unsigned);
+}
+
+/**
+ * FNV-1a hash of the cost, the length and the vertices of a path
+ */
+static uint64_t hash_path(const unsigned* path,
+						  unsigned length,
+						  graph_weight_t cost) {
+	uint64_t h = 0xcbf29ce484222325ull;
+	h = (h ^ (uint64_t)cost) * 0x100000001b3ull;
+	h = (h ^ length) * 0x100000001b3ull;
+	for (unsigned i = 0; i < length; i++)
+		h = (h ^ path[i]) * 0x100000001b3ull;
+	return h;
+}
+
+/**
+ * Bucket of the candidate equal to the path or empty bucket where to put it
+ */
+static unsigned* find_bucket(candidates_t* c,
+							 const unsigned* path,
+							 unsigned length,
+							 graph_weight_t cost,
+							 uint64_t hash) {
+	const unsigned mask = c->table_size - 1;
+	for (unsigned b = hash & mask;; b = (b + 1) & mask) {
+		if (c->table[b] == 0)
+			return &c->table[b];
+		const candidate_t* other = get_candidate(c, c->table[b] - 1);
+		if (other->hash == hash && other->cost == cost &&
+			other->length == length &&
+			memcmp(candidate_vertices(c, c->table[b] - 1), path,
+				   length * sizeof(unsigned)) == 0)
+			return &c->table[b];
+	}
+}
+
+/**
+ * Doubles the size of the hash set, which is kept at most half full
+ */
+static int grow_table(candidates_t* c) {
+	const unsigned size = 2 * c->table_size;
+	unsigned* table = calloc(size, sizeof(unsigned));
+	if (table == NULL)
+		return -ERROR_ALLOCATION_FAILED;
+	for (unsigned i = 0; i < c->list->size; i++) {
+		unsigned b = get_candidate(c, i)->hash & (size - 1);
+		while (table[b] != 0)
+			b = (b + 1) & (size - 1);
+		table[b] = i + 1;
+	}
+	free(c->table);
+	c->table = table;
+	c->table_size = size;
+	return -ERROR_NO_ERROR;
+}
+
+/**
+ * Adds the candidate made of the root path (the first spur_index + 1 vertices
+ * of root) followed by the spur path found by spur_dijkstra
+ */
+static int add_candidate(candidates_t* c,
+						 spur_search_t* s,
+						 const unsigned* root,
+						 unsigned spur_index,
+						 graph_weight_t root_cost,
+						 unsigned dst,
+						 unsigned* buffer) {
+	unsigned spur_length = 0;
+	for (int v = dst; v != -1; v = s->father[v])
+		spur_length++;
+	const unsigned length = spur_index + spur_length;
+	if (spur_index > 0)
+		memcpy(buffer, root, spur_index * sizeof(unsigned));
+	unsigned i = length;
+	for (int v = dst; v != -1; v = s->father[v])
+		buffer[--i] = v;
+	const graph_weight_t cost =
+		weight_add_truncate_overflow(root_cost, s->distance[dst]);
+
+	if (2 * (c->list->size + 1) > c->table_size && grow_table(c) < 0)
+		return -ERROR_ALLOCATION_FAILED;
+	const uint64_t hash = hash_path(buffer, length, cost);
+	unsigned* bucket = find_bucket(c, buffer, length, cost, hash);
+	if (*bucket != 0)
+		return -ERROR_NO_ERROR;
+	candidate_t candidate = {cost, c->vertices->size, length, hash};
+	candidate_key_t key = {cost, c->list->size};
+	for (i = 0; i < length; i++) {
+		if (dynarray_push_back(c->vertices, &buffer[i]) == NULL)
+			return -ERROR_ALLOCATION_FAILED;
+	}
+	if (dynarray_push_back(c->list, &candidate) == NULL ||
+		priority_queue_push(c->queue, &key) < 0)
+		return -ERROR_ALLOCATION_FAILED;
+	*bucket = key.index + 1;
+	return -ERROR_NO_ERROR;
+}
+
+int graph_list_yen(graph_list_t* g,
+				   unsigned src,
+				   unsigned dst,
+				   unsigned k,
+				   unsigned* paths,
+				   unsigned* lengths,
+				   graph_weight_t* costs) {
+	int ret;
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_false_ret(src < g->nb_vert, -ERROR_INVALID_PARAM2);
+	when_false_ret(dst < g->nb_vert, -ERROR_INVALID_PARAM3);
+	when_null_ret(paths, -ERROR_INVALID_PARAM5);
+	when_null_ret(lengths, -ERROR_INVALID_PARAM6);
+	if (k == 0)
+		return 0;
+
+	const unsigned n = g->nb_vert;
+	spur_search_t s;
+	candidates_t c;
+	ret = init_spur_search(&s, n);
+	when_false_ret(ret == -ERROR_NO_ERROR, ret);
+	ret = init_candidates(&c);
+	when_false_jmp(ret == -ERROR_NO_ERROR, ret, exit_search);
+	// buffer for a candidate path and prefix costs of the previous path
+	unsigned* buffer = malloc(n * sizeof(unsigned));
+	graph_weight_t* prefix = malloc(n * sizeof(graph_weight_t));
+	when_true_jmp(buffer == NULL || prefix == NULL, -ERROR_ALLOCATION_FAILED,
+				  exit);
+
+	// The first path is the shortest path
+	next_stamp(&s, n);
+	ret = 0;
+	if (spur_dijkstra(g, &s, src, dst) == FALSE)
+		goto exit;
+	when_true_jmp(add_candidate(&c, &s, NULL, 0, 0, dst, buffer) < 0,
+				  -ERROR_ALLOCATION_FAILED, exit);
+
+	for (unsigned found = 0; found < k; found++) {
+		// The best candidate becomes the next path
+		candidate_key_t best;
+		if (priority_queue_pop(c.queue, &best) == -ERROR_IS_EMPTY)
+			break;
+		unsigned* path = paths + (size_t)found * n;
+		const unsigned length = get_candidate(&c, best.index)->length;
+		memcpy(path, candidate_vertices(&c, best.index),
+			   length * sizeof(unsigned));
+		lengths[found] = length;
+		if (costs != NULL)
+			costs[found] = best.cost;
+		ret = found + 1;
+		if (found + 1 == k)
+			break;
+
+		prefix[0] = 0;
+		for (unsigned j = 1; j < length; j++) {
+			graph_list_edge_t* e = graph_list_get_edge(g, path[j - 1], path[j]);
+			prefix[j] = weight_add_truncate_overflow(prefix[j - 1], e->w);
+		}
+
+		// Each vertex of the path but dst is the start of a spur path
+		for (unsigned j = 0; j + 1 < length; j++) {
+			next_stamp(&s, n);
+			// Removes the edges (path[j], x) of the accepted paths which share
+			// the same root path
+			for (unsigned p = 0; p <= found; p++) {
+				const unsigned* other = paths + (size_t)p * n;
+				if (lengths[p] > j + 1 &&
+					memcmp(other, path, (j + 1) * sizeof(unsigned)) == 0)
+					s.banned_next[other[j + 1]] = s.stamp;
+			}
+			// Removes the vertices of the root path but the spur vertex
+			for (unsigned r = 0; r < j; r++)
+				s.banned[path[r]] = s.stamp;
+
+			if (spur_dijkstra(g, &s, path[j], dst) == TRUE &&
+				add_candidate(&c, &s, path, j, prefix[j], dst, buffer) < 0) {
+				ret = -ERROR_ALLOCATION_FAILED;
+				goto exit;
+			}
+		}
+	}
+
+exit:
+	free(prefix);
+	free(buffer);
+	free_candidates(&c);
+exit_search:
+	free_spur_search(&s);
+	return ret;
+}
@@ -2,47 +2,21 @@
 #include <stdlib.h>
 #include "config.h"
 #include "errors.h"
-#include "fixed_xifo_view.h"
+#include "graph/graph_workspace.h"
+#include "graph_list_private.h"
+#include "graph_template.h"
 #include "list_ref/list_ref.h"
 #include "test_macros.h"
+#include "workspace_wrap.h"
 #include "weight_type.h"
 
-graph_list_t* create_graph_list(unsigned size, BOOL is_weighted) {
-	graph_list_t* ret;
-	when_true_ret(size == 0, NULL);
-
-	graph_list_t* g = malloc(sizeof(graph_list_t));
-	when_null_ret(g, NULL);
-
-	g->nb_vert = size;
-	g->neighbours = malloc(size * sizeof(list_ref_t));
-	when_null_jmp(g->neighbours, NULL, error);
-	g->is_weighted = is_weighted;
-
-	for (unsigned i = 0; i < size; i++) {
-		g->neighbours[i].begin = NULL;
-		g->neighbours[i].end = NULL;
-		g->neighbours[i].size = sizeof(graph_list_edge_t);
-		g->neighbours[i].free_element = free;
-	}
-
-	return g;
-error:
-	free(g);
-	return ret;
-}
+DEFINE_GRAPH_LIST_BASE(graph_list, graph_weight_t)
 
 int graph_list_add_edge_noverif(graph_list_t* g,
 								unsigned int a,
 								unsigned int b,
 								long long weight) {
-	list_ref_t* neighbours = &g->neighbours[a];
-	graph_list_edge_t* e = malloc(sizeof(graph_list_edge_t));
-	when_null_ret(e, -ERROR_ALLOCATION_FAILED);
-	*e = (graph_list_edge_t){weight, b};
-	push_back_list(neighbours, e);
-
-	return 0;
+	return graph_list_push_edge(g, a, b, weight);
 }
 
 graph_list_t* create_graph_list_from_predecessors(unsigned size, int* father) {
@@ -56,100 +30,29 @@ graph_list_t* create_graph_list_from_predecessors(unsigned size, int* father) {
 	return ret;
 }
 
-#ifdef STRUCT_RECURSIVE_IMPL
-static node_list_ref_t* find_edge_rec(node_list_ref_t* node, unsigned int b) {
-	if (node == NULL)
-		return NULL;
-	graph_list_edge_t* e = node->p;
-	if (e->to == b)
-		return node;
-	return find_edge_rec(node->next, b);
-}
-
-static node_list_ref_t* find_edge(graph_list_t* g,
-								  unsigned int a,
-								  unsigned int b) {
-	list_ref_t* neighbours = &g->neighbours[a];
-	node_list_ref_t* node = neighbours->begin;
-
-	return find_edge_rec(node, b);
-}
-#else
-static node_list_ref_t* find_edge(graph_list_t* g,
-								  unsigned int a,
-								  unsigned int b) {
-	list_ref_t* neighbours = &g->neighbours[a];
-	node_list_ref_t* node = neighbours->begin;
-
-	graph_list_edge_t* e = NULL;
-	while (node) {
-		e = node->p;
-		if (e->to == b)
-			return node;
-		node = node->next;
-	}
-	return NULL;
-}
-#endif
-
-graph_list_edge_t* graph_list_get_edge(graph_list_t* g,
-									   unsigned int a,
-									   unsigned int b) {
-	node_list_ref_t* node = find_edge(g, a, b);
-	return node == NULL ? NULL : node->p;
-}
-
-void graph_list_set_edge(graph_list_t* g,
-						 unsigned int a,
-						 unsigned int b,
-						 BOOL val,
-						 graph_weight_t weight,
-						 BOOL reverse) {
-	if (g->is_weighted == FALSE)
-		weight = 1;
-	node_list_ref_t* node = find_edge(g, a, b);
-	if (node && !val)
-		remove_list(&g->neighbours[a], node, NULL);
-	if (node && val)
-		((graph_list_edge_t*)node->p)->w = weight;
-	if (!node && val)
-		graph_list_add_edge_noverif(g, a, b, weight);
-	if (reverse)
-		graph_list_set_edge(g, b, a, val, weight, FALSE);
-}
-
-void free_graph_list(graph_list_t* g) {
-	if (g) {
-		for (unsigned i = 0; i < g->nb_vert; i++)
-			clean_list(&g->neighbours[i]);
-		free(g->neighbours);
-		free(g);
-	}
-}
-
-int mark_and_examine_traversal_list(graph_list_t* g,
-									unsigned r,
-									int* tab,
-									int* father,
-									LIST_STRUCT queue_or_stack) {
+static int mark_and_examine_traversal_list_ws(graph_list_t* g,
+											  unsigned r,
+											  int* tab,
+											  int* father,
+											  LIST_STRUCT queue_or_stack,
+											  graph_sp_workspace_t* ws) {
 	when_null_ret(tab, -ERROR_INVALID_PARAM3);
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
 	if (father)
 		father[r] = -1;
 
-	char* mark = calloc(g->nb_vert, sizeof(BOOL));
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);
-	mark[r] = 1;  // Marquer r
+	graph_sp_workspace_set_mark(ws, r, TRUE);  // Marquer r
 
 	// We create a queue an put the root inside
-	fixed_xifo_view_t* waiting_list =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	fixed_xifo_copy_push_back(waiting_list, &r);
+	circular_buffer_t* waiting_list = ws->waiting_list;
+	circular_buffer_push_back(waiting_list, &r);
 
 	unsigned index = 0;
 
-	while (!empty_fixed_xifo(waiting_list)) {
+	while (circular_buffer_size(waiting_list) != 0) {
 		int vertex;
-		fixed_xifo_copy_pop_front(waiting_list, (void*)&vertex);
+		circular_buffer_pop_front(waiting_list, (void*)&vertex);
 		if (tab != NULL)
 			tab[index] = vertex;
 		index++;
@@ -158,52 +61,58 @@ int mark_and_examine_traversal_list(graph_list_t* g,
 		graph_list_edge_t* e = NULL;
 		while (node) {
 			e = node->p;
-			if (!mark[e->to]) {
-				mark[e->to] = TRUE;
+			if (!graph_sp_workspace_get_mark(ws, e->to)) {
+				graph_sp_workspace_set_mark(ws, e->to, TRUE);
 				if (father)
 					father[e->to] = vertex;
 				if (queue_or_stack == STACK)
-					fixed_xifo_copy_push_front(waiting_list, &e->to);
+					circular_buffer_push_front(waiting_list, &e->to);
 				else
-					fixed_xifo_copy_push_back(waiting_list, &e->to);
+					circular_buffer_push_back(waiting_list, &e->to);
 			}
 			node = node->next;
 		}
 	}
-	free(mark);
-	free_fixed_xifo(waiting_list);
 	return index;
 }
 
-#define DFS_INIT_MARK(type)                                \
+int mark_and_examine_traversal_list(graph_list_t* g,
+									unsigned r,
+									int* tab,
+									int* father,
+									LIST_STRUCT queue_or_stack) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   mark_and_examine_traversal_list_ws(g, r, tab, father,
+													  queue_or_stack, ws))
+}
+
+#define DFS_INIT_MARK                                      \
 	unsigned index = 0;                                    \
 	when_null_ret(g, -ERROR_INVALID_PARAM1);               \
 	when_false_ret(r < g->nb_vert, -ERROR_INVALID_PARAM2); \
-	type* mark = calloc(g->nb_vert, sizeof(type));         \
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);         \
+	WORKSPACE_CHECK(5)                                     \
+	graph_sp_workspace_reset(ws);                          \
 	if (father != NULL)                                    \
 		father[r] = -1;
 
-#define DFS_DEINIT_MARK free(mark);
-
 #ifdef STRUCT_RECURSIVE_IMPL
 static void graph_list_preorder_dfs_impl(graph_list_t* g,
 										 unsigned current,
 										 int* tab,
 										 int* father,
-										 char* mark,
+										 graph_sp_workspace_t* ws,
 										 unsigned* index) {
-	mark[current] = TRUE;
+	graph_sp_workspace_set_mark(ws, current, TRUE);
 	tab[*index] = current;
 	*index += 1;
 	node_list_ref_t* node = g->neighbours[current].begin;
 	graph_list_edge_t* e = NULL;
 	while (node) {
 		e = node->p;
-		if (!mark[e->to]) {
+		if (!graph_sp_workspace_get_mark(ws, e->to)) {
 			if (father)
 				father[e->to] = current;
-			graph_list_preorder_dfs_impl(g, e->to, tab, father, mark, index);
+			graph_list_preorder_dfs_impl(g, e->to, tab, father, ws, index);
 		}
 		node = node->next;
 	}
@@ -213,17 +122,17 @@ static void graph_list_postorder_dfs_impl(graph_list_t* g,
 										  unsigned current,
 										  int* tab,
 										  int* father,
-										  char* mark,
+										  graph_sp_workspace_t* ws,
 										  unsigned* index) {
-	mark[current] = TRUE;
+	graph_sp_workspace_set_mark(ws, current, TRUE);
 	node_list_ref_t* node = g->neighbours[current].begin;
 	graph_list_edge_t* e = NULL;
 	while (node) {
 		e = node->p;
-		if (!mark[e->to]) {
+		if (!graph_sp_workspace_get_mark(ws, e->to)) {
 			if (father)
 				father[e->to] = current;
-			graph_list_postorder_dfs_impl(g, e->to, tab, father, mark, index);
+			graph_list_postorder_dfs_impl(g, e->to, tab, father, ws, index);
 		}
 		node = node->next;
 	}
@@ -231,96 +140,116 @@ static void graph_list_postorder_dfs_impl(graph_list_t* g,
 	*index += 1;
 }
 
-int graph_list_preorder_dfs(graph_list_t* g,
-							unsigned r,
-							int* tab,
-							int* father) {
-	DFS_INIT_MARK(char)
-	graph_list_preorder_dfs_impl(g, r, tab, father, mark, &index);
-	DFS_DEINIT_MARK
+int graph_list_preorder_dfs_ws(graph_list_t* g,
+							   unsigned r,
+							   int* tab,
+							   int* father,
+							   graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	graph_list_preorder_dfs_impl(g, r, tab, father, ws, &index);
 	return index;
 }
 
-int graph_list_postorder_dfs(graph_list_t* g,
-							 unsigned r,
-							 int* tab,
-							 int* father) {
-	DFS_INIT_MARK(char)
-	graph_list_postorder_dfs_impl(g, r, tab, father, mark, &index);
-	DFS_DEINIT_MARK
+int graph_list_postorder_dfs_ws(graph_list_t* g,
+								unsigned r,
+								int* tab,
+								int* father,
+								graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	graph_list_postorder_dfs_impl(g, r, tab, father, ws, &index);
 	return index;
 }
 #else
-int graph_list_preorder_dfs(graph_list_t* g,
-							unsigned r,
-							int* tab,
-							int* father) {
-	DFS_INIT_MARK(char)
-	fixed_xifo_view_t* waiting_list =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	when_null_ret(waiting_list, -ERROR_ALLOCATION_FAILED);
+int graph_list_preorder_dfs_ws(graph_list_t* g,
+							   unsigned r,
+							   int* tab,
+							   int* father,
+							   graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	circular_buffer_t* waiting_list = ws->waiting_list;
 
 	int pivot = r;
-	fixed_xifo_copy_push_back(waiting_list, &pivot);
+	graph_sp_workspace_set_mark(ws, pivot, TRUE);
+	circular_buffer_push_back(waiting_list, &pivot);
 	do {
-		fixed_xifo_copy_pop_back(waiting_list, &pivot);
-		mark[pivot] = TRUE;
+		circular_buffer_pop_back(waiting_list, &pivot);
 		tab[index++] = pivot;
 		foreach_node_rev(&g->neighbours[pivot], e, graph_list_edge_t) {
-			if (mark[e->to] == FALSE) {
-				fixed_xifo_copy_push_back(waiting_list, &e->to);
+			// Vertices are marked when pushed so that the stack never holds
+			// more than nb_vert vertices
+			if (graph_sp_workspace_get_mark(ws, e->to) == FALSE) {
+				graph_sp_workspace_set_mark(ws, e->to, TRUE);
+				circular_buffer_push_back(waiting_list, &e->to);
 				if (father != NULL)
 					father[e->to] = pivot;
 			}
 		}
 
-	} while (empty_fixed_xifo(waiting_list) == FALSE);
-	free_fixed_xifo(waiting_list);
-	DFS_DEINIT_MARK
+	} while (circular_buffer_size(waiting_list) != 0);
 	return index;
 }
 
 typedef enum dfs_status { UNVISITED, VISITED, SUBTREEDONE } dfs_status_t;
 
-int graph_list_postorder_dfs(graph_list_t* g,
-							 unsigned r,
-							 int* tab,
-							 int* father) {
-	DFS_INIT_MARK(dfs_status_t)
-	fixed_xifo_view_t* waiting_list =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	when_null_ret(waiting_list, -ERROR_ALLOCATION_FAILED);
+int graph_list_postorder_dfs_ws(graph_list_t* g,
+								unsigned r,
+								int* tab,
+								int* father,
+								graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	circular_buffer_t* waiting_list = ws->waiting_list;
 
 	int pivot = r;
-	fixed_xifo_copy_push_back(waiting_list, &pivot);
-	mark[pivot] = VISITED;
+	circular_buffer_push_back(waiting_list, &pivot);
+	graph_sp_workspace_set_mark(ws, pivot, VISITED);
 	do {
-		/* fixed_xifo_copy_pop_back(waiting_list, &pivot); */
-		pivot = fixed_xifo_copy_back(waiting_list, int);
-		if (mark[pivot] == SUBTREEDONE) {
+		pivot = *get_buffer_last(waiting_list, int);
+		if (graph_sp_workspace_get_mark(ws, pivot) == SUBTREEDONE) {
 			if (tab != NULL)
 				tab[index] = pivot;
 			index++;
-			fixed_xifo_copy_pop_back(waiting_list, NULL);
+			circular_buffer_pop_back(waiting_list, NULL);
 			continue;
 		}
 		foreach_node_rev(&g->neighbours[pivot], e, graph_list_edge_t) {
-			if (mark[e->to] == UNVISITED) {
-				fixed_xifo_copy_push_back(waiting_list, &e->to);
-				mark[e->to] = VISITED;
+			if (graph_sp_workspace_get_mark(ws, e->to) == UNVISITED) {
+				circular_buffer_push_back(waiting_list, &e->to);
+				graph_sp_workspace_set_mark(ws, e->to, VISITED);
 				if (father != NULL)
 					father[e->to] = pivot;
 			}
 		}
-		mark[pivot] = SUBTREEDONE;
+		graph_sp_workspace_set_mark(ws, pivot, SUBTREEDONE);
 
-	} while (empty_fixed_xifo(waiting_list) == FALSE);
-	free_fixed_xifo(waiting_list);
-	DFS_DEINIT_MARK
+	} while (circular_buffer_size(waiting_list) != 0);
 	return index;
 }
 #endif	// STRUCT_RECURSIVE_IMPL
 
+int graph_list_preorder_dfs(graph_list_t* g,
+							unsigned r,
+							int* tab,
+							int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_list_preorder_dfs_ws(g, r, tab, father, ws))
+}
+
+int graph_list_postorder_dfs(graph_list_t* g,
+							 unsigned r,
+							 int* tab,
+							 int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_list_postorder_dfs_ws(g, r, tab, father, ws))
+}
+
+int graph_list_bfs_ws(graph_list_t* g,
+					  unsigned r,
+					  int* values,
+					  int* father,
+					  graph_sp_workspace_t* ws) {
+	return mark_and_examine_traversal_list_ws(g, r, values, father, QUEUE, ws);
+}
+
 int graph_list_bfs(graph_list_t* g, unsigned r, int* values, int* father) {
 	return mark_and_examine_traversal_list(g, r, values, father, QUEUE);
 }
@@ -403,15 +332,15 @@ int graph_list_bfs(graph_list_t* g, unsigned r, int* values, int* father) {
 	distance[r] = 0;
 
 #ifndef DIJKSTRA_HEAP_IMPL
-int graph_list_dijkstra(graph_list_t* g,
-						unsigned r,
-						graph_weight_t* distance,
-						int* father) {
+int graph_list_dijkstra_ws(graph_list_t* g,
+						   unsigned r,
+						   graph_weight_t* distance,
+						   int* father,
+						   graph_sp_workspace_t* ws) {
 	SSSHORTESTPATH_INIT
-
-	BOOL* mark = calloc(g->nb_vert, sizeof(BOOL));
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);
-	mark[r] = TRUE;
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
+	graph_sp_workspace_set_mark(ws, r, TRUE);
 
 	unsigned pivot = r;
 	unsigned count = 1;	 // count of vertices reached by the algorithm
@@ -421,7 +350,7 @@ int graph_list_dijkstra(graph_list_t* g,
 		/* graph_list_edge_t* e = NULL; */
 		// For each successor of pivot
 		foreach_node(&g->neighbours[pivot], e, graph_list_edge_t) {
-			if (mark[e->to] == TRUE)
+			if (graph_sp_workspace_get_mark(ws, e->to))
 				continue;
 
 			graph_weight_t d =
@@ -438,7 +367,8 @@ int graph_list_dijkstra(graph_list_t* g,
 		graph_weight_t min = GRAPH_WEIGHT_INF;
 		int jmin = -1;
 		for (unsigned j = 0; j < g->nb_vert; j++) {	 // For each vertex j
-			if (mark[j] == FALSE && distance[j] >= 0 && distance[j] < min) {
+			if (!graph_sp_workspace_get_mark(ws, j) && distance[j] >= 0 &&
+				distance[j] < min) {
 				min = distance[j];
 				jmin = j;
 			}
@@ -447,71 +377,100 @@ int graph_list_dijkstra(graph_list_t* g,
 		if (jmin == -1)
 			break;
 		pivot = jmin;
-		mark[pivot] = TRUE;
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
 		count++;
 	}
-	free(mark);
 
 	return count;
 }
-#else
-#include "compare.h"
-#include "heap_view.h"
-
-DEFINE_COMPARE_MIN_SCALAR(graph_weight_t)
-
-int graph_list_dijkstra(graph_list_t* g,
-						unsigned r,
-						graph_weight_t* distance,
-						int* father) {
+#elif defined(DIJKSTRA_DARY_HEAP_ARITY)
+int graph_list_dijkstra_ws(graph_list_t* g,
+						   unsigned r,
+						   graph_weight_t* distance,
+						   int* father,
+						   graph_sp_workspace_t* ws) {
 	SSSHORTESTPATH_INIT
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
+
+	// Only the reached vertices are inserted in the heap, with their distance
+	dary_heap_t* heap = ws->dary_heap;
+	dary_heap_clear(heap);
+	dary_heap_decrease_key(heap, r, 0);
 
-	heap_view_t* heap =
-		create_heap_no_check(g->nb_vert, sizeof(graph_weight_t), distance,
-							 compare_min_graph_weight_t);
+	// Number of vertices reached by the algorithm
+	unsigned number = 0;
+	int pivot;
+	while ((pivot = dary_heap_pop(heap, NULL)) != -ERROR_IS_EMPTY) {
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
+		number++;
+		foreach_node(&g->neighbours[pivot], e, graph_list_edge_t) {
+			if (graph_sp_workspace_get_mark(ws, e->to))
+				continue;
+			const graph_weight_t d =
+				weight_add_truncate_overflow(distance[pivot], e->w);
+			if (d < distance[e->to]) {
+				distance[e->to] = d;
+				dary_heap_decrease_key(heap, e->to, d);
+				if (father != NULL)
+					father[e->to] = pivot;
+			}
+		}
+	}
 
-	// We put r at the root of (index, distance) which makes it a heap
-	heap->idx_to_pos[r] = 0;
-	heap->idx_to_pos[0] = r;
-	heap->pos_to_idx[r] = 0;
-	heap->pos_to_idx[0] = r;
+	return number;
+}
+#else
+int graph_list_dijkstra_ws(graph_list_t* g,
+						   unsigned r,
+						   graph_weight_t* distance,
+						   int* father,
+						   graph_sp_workspace_t* ws) {
+	SSSHORTESTPATH_INIT
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
 
-	BOOL* mark = calloc(g->nb_vert, sizeof(BOOL));
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);
+	heap_view_t* heap = graph_sp_workspace_heap(ws, g->nb_vert, r, distance);
 
 	// Number of vertices reached by the algorithm
 	unsigned number = 0;
 	int pivot;
 
 	// While there is a vertex left in the heap
-	while ((pivot = heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+	while ((pivot = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
 		// Take the root of the heap (which is the non-marked vertex with the
 		// lowest distance to the root)
 		if (distance[pivot] == GRAPH_WEIGHT_INF)
 			break;
-		mark[pivot] = TRUE;
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
 		number++;
 
 		// For each successor of pivot
 		foreach_node(&g->neighbours[pivot], e, graph_list_edge_t) {
-			if (mark[e->to] == TRUE)
+			if (graph_sp_workspace_get_mark(ws, e->to))
 				continue;
 			graph_weight_t d =
 				weight_add_truncate_overflow(distance[pivot], e->w);
 			if (d < distance[e->to]) {
-				heap_update_up(heap, e->to, &d);
+				weight_heap_update_up(heap, e->to, d);
 				if (father != NULL)
 					father[e->to] = pivot;
 			}
 		}
 	}
-	free_heap(heap);
-	free(mark);
 
 	return number;
 }
 #endif	// DIJKSTRA_HEAP_IMPL
 
+int graph_list_dijkstra(graph_list_t* g,
+						unsigned r,
+						graph_weight_t* distance,
+						int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_list_dijkstra_ws(g, r, distance, father, ws))
+}
+
 unsigned int graph_list_indegree(graph_list_t* g, unsigned vertex) {
 	unsigned degree = 0;
 	for (unsigned i = 0; i < g->nb_vert; i++) {
@@ -526,56 +485,62 @@ unsigned int graph_list_outdegree(graph_list_t* g, unsigned vertex) {
 	return length_list(&g->neighbours[vertex]);
 }
 
-int graph_list_topological_ordering(graph_list_t* g,
-									unsigned* num,
-									unsigned* denum) {
-	int ret = -ERROR_GRAPH_SHOULDBE_DAG;
+int graph_list_topological_ordering_ws(graph_list_t* g,
+									   unsigned* num,
+									   unsigned* denum,
+									   graph_sp_workspace_t* ws) {
 	when_true_ret(g->nb_vert == 0, -ERROR_GRAPH_HAS_NO_NODE);
 	when_null_ret(num, -ERROR_INVALID_PARAM2);
+	WORKSPACE_CHECK(4)
+	graph_sp_workspace_reset(ws);
 
 	int number = g->nb_vert;
 
-	fixed_xifo_view_t* stack =
-		create_fixed_xifo_copy(sizeof(unsigned), g->nb_vert);
+	circular_buffer_t* stack = ws->waiting_list;
 
-	unsigned degre[g->nb_vert];
+	unsigned* degre = ws->degree;
 	for (unsigned i = 0; i < g->nb_vert; i++) {
 		degre[i] = graph_list_outdegree(g, i);
 		if (degre[i] == 0)
-			fixed_xifo_copy_push_front(stack, &i);
+			circular_buffer_push_front(stack, &i);
 	}
-	if (empty_fixed_xifo(stack) == TRUE)
-		goto exit;
+	if (circular_buffer_size(stack) == 0)
+		return -ERROR_GRAPH_SHOULDBE_DAG;
 	do {
 		unsigned s;
-		fixed_xifo_copy_pop_front(stack, &s);
+		circular_buffer_pop_front(stack, &s);
 		num[s] = --number;
 		if (denum)
 			denum[number] = s;
 		for (unsigned t = 0; t < g->nb_vert; t++) {
 			if (graph_list_get_edge(g, t, s) != NULL && --degre[t] == 0)
-				fixed_xifo_copy_push_front(stack, &t);
+				circular_buffer_push_front(stack, &t);
 		}
-	} while (empty_fixed_xifo(stack) == FALSE);
+	} while (circular_buffer_size(stack) != 0);
 	if (number != 0)
-		goto exit;
-	ret = -ERROR_NO_ERROR;
-exit:
-	free_fixed_xifo(stack);
-	return ret;
+		return -ERROR_GRAPH_SHOULDBE_DAG;
+	return -ERROR_NO_ERROR;
 }
 
-int graph_list_bellman(graph_list_t* g,
-					   unsigned r,
-					   graph_weight_t* distance,
-					   int* father) {
+int graph_list_topological_ordering(graph_list_t* g,
+									unsigned* num,
+									unsigned* denum) {
+	WITH_WORKSPACE(-ERROR_GRAPH_HAS_NO_NODE,
+				   graph_list_topological_ordering_ws(g, num, denum, ws))
+}
+
+int graph_list_bellman_ws(graph_list_t* g,
+						  unsigned r,
+						  graph_weight_t* distance,
+						  int* father,
+						  graph_sp_workspace_t* ws) {
 	SSSHORTESTPATH_INIT
+	WORKSPACE_CHECK(5)
 
-	unsigned* num = malloc(2 * g->nb_vert * sizeof(unsigned int));
-	when_null_ret(num, -ERROR_ALLOCATION_FAILED);
+	unsigned* num = ws->num;
 	unsigned* denum = num + g->nb_vert;
-	int ret = graph_list_topological_ordering(g, num, denum);
-	when_false_jmp(ret == ERROR_NO_ERROR, ret, exit);
+	int ret = graph_list_topological_ordering_ws(g, num, denum, ws);
+	when_false_ret(ret == ERROR_NO_ERROR, ret);
 
 	for (unsigned i = num[r]; i < g->nb_vert - 1; i++) {
 		const unsigned x = denum[i];
@@ -590,11 +555,17 @@ int graph_list_bellman(graph_list_t* g,
 		}
 	}
 
-exit:
-	free(num);
 	return ret;
 }
 
+int graph_list_bellman(graph_list_t* g,
+					   unsigned r,
+					   graph_weight_t* distance,
+					   int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_list_bellman_ws(g, r, distance, father, ws))
+}
+
 /* int graph_list_bellman(graph_list_t* g, */
 /* 					   unsigned r, */
 /* 					   graph_weight_t* distance, */
@@ -666,6 +637,16 @@ int graph_list_ford(graph_list_t* g,
 	return -ERROR_NO_ERROR;
 }
 
+int graph_list_ford_ws(graph_list_t* g,
+					   unsigned r,
+					   graph_weight_t* distance,
+					   int* father,
+					   graph_sp_workspace_t* ws) {
+	// Ford algorithm doesn't need any temporary buffer
+	(void)ws;
+	return graph_list_ford(g, r, distance, father);
+}
+
 static BOOL test_if_edge_create_cycle(int* father, int a, int b) {
 	int current = a;
 	while (current != -1) {
@@ -676,17 +657,17 @@ static BOOL test_if_edge_create_cycle(int* father, int a, int b) {
 	return FALSE;
 }
 
-int graph_list_ford_dantzig(graph_list_t* g,
-							unsigned r,
-							graph_weight_t* distance,
-							int* father,
-							int* cycle) {
+int graph_list_ford_dantzig_ws(graph_list_t* g,
+							   unsigned r,
+							   graph_weight_t* distance,
+							   int* father,
+							   int* cycle,
+							   graph_sp_workspace_t* ws) {
 	when_null_ret(father, -ERROR_INVALID_PARAM4);
-	int ret = graph_list_dijkstra(g, r, distance, father);
+	WORKSPACE_CHECK(6)
+	int ret = graph_list_dijkstra_ws(g, r, distance, father, ws);
 	when_false_ret(ret >= 0, ret);
-	fixed_xifo_view_t* update_queue =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	when_null_ret(update_queue, -ERROR_ALLOCATION_FAILED);
+	circular_buffer_t* update_queue = ws->waiting_list;
 
 	while (TRUE) {
 		BOOL found = FALSE;
@@ -709,24 +690,126 @@ int graph_list_ford_dantzig(graph_list_t* g,
 		father[y] = x;
 		if (test_if_edge_create_cycle(father, x, y) == TRUE) {
 			*cycle = x;
-			ret = -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT;
-			goto exit;
+			return -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT;
 		}
-		fixed_xifo_copy_push_back(update_queue, &y);
+		circular_buffer_push_back(update_queue, &y);
 
 		do {
-			fixed_xifo_copy_pop_front(update_queue, &x);
+			circular_buffer_pop_front(update_queue, &x);
 			foreach_node(&g->neighbours[x], e, graph_list_edge_t) {
 				if (father[e->to] == x) {
 					d = weight_add_truncate_overflow(distance[x], e->w);
 					distance[e->to] = d;
-					fixed_xifo_copy_push_back(update_queue, &e->to);
+					circular_buffer_push_back(update_queue, &e->to);
 				}
 			}
-		} while (empty_fixed_xifo(update_queue) == FALSE);
+		} while (circular_buffer_size(update_queue) != 0);
 	}
 
-exit:
-	free_fixed_xifo(update_queue);
 	return ret;
 }
+
+int graph_list_ford_dantzig(graph_list_t* g,
+							unsigned r,
+							graph_weight_t* distance,
+							int* father,
+							int* cycle) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_list_ford_dantzig_ws(g, r, distance, father, cycle,
+											  ws))
+}
+
+int graph_list_dag_longest_path_multi(graph_list_t* g,
+									  const unsigned* denum,
+									  const unsigned* sources,
+									  unsigned nb_sources,
+									  graph_weight_t* distance,
+									  int* father) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_null_ret(denum, -ERROR_INVALID_PARAM2);
+	when_null_ret(sources, -ERROR_INVALID_PARAM3);
+	when_null_ret(distance, -ERROR_INVALID_PARAM5);
+
+	for (unsigned i = 0; i < g->nb_vert; i++)
+		distance[i] = -GRAPH_WEIGHT_INF;
+	if (father) {
+		for (unsigned i = 0; i < g->nb_vert; i++)
+			father[i] = -1;
+	}
+	for (unsigned i = 0; i < nb_sources; i++) {
+		when_false_ret(sources[i] < g->nb_vert, -ERROR_INVALID_PARAM3);
+		distance[sources[i]] = 0;
+	}
+
+	// Every predecessor of x comes before x in the topological order, so
+	// distance[x] is final when x is reached
+	unsigned number = 0;
+	for (unsigned i = 0; i < g->nb_vert; i++) {
+		const unsigned x = denum[i];
+		if (distance[x] == -GRAPH_WEIGHT_INF)
+			continue;
+		number++;
+		foreach_node(&g->neighbours[x], e, graph_list_edge_t) {
+			const graph_weight_t d =
+				weight_add_truncate_overflow(distance[x], e->w);
+			if (d > distance[e->to]) {
+				distance[e->to] = d;
+				if (father != NULL)
+					father[e->to] = x;
+			}
+		}
+	}
+	return number;
+}
+
+int graph_list_dag_longest_path(graph_list_t* g,
+								const unsigned* denum,
+								unsigned r,
+								graph_weight_t* distance,
+								int* father) {
+	return graph_list_dag_longest_path_multi(g, denum, &r, 1, distance,
+											 father);
+}
+
+int graph_list_critical_path(graph_list_t* g,
+							 const unsigned* denum,
+							 graph_weight_t* earliest,
+							 graph_weight_t* latest,
+							 graph_weight_t* slack) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_null_ret(denum, -ERROR_INVALID_PARAM2);
+	when_null_ret(earliest, -ERROR_INVALID_PARAM3);
+	when_null_ret(latest, -ERROR_INVALID_PARAM4);
+
+	for (unsigned i = 0; i < g->nb_vert; i++)
+		earliest[i] = 0;
+
+	// Forward pass: earliest start times in topological order
+	graph_weight_t length = 0;
+	for (unsigned i = 0; i < g->nb_vert; i++) {
+		const unsigned x = denum[i];
+		length = MAX(length, earliest[x]);
+		foreach_node(&g->neighbours[x], e, graph_list_edge_t) {
+			const graph_weight_t d =
+				weight_add_truncate_overflow(earliest[x], e->w);
+			if (d > earliest[e->to])
+				earliest[e->to] = d;
+		}
+	}
+
+	// Backward pass: latest start times in reverse topological order, the
+	// successors of x have already been processed when x is reached
+	for (unsigned i = g->nb_vert; i-- > 0;) {
+		const unsigned x = denum[i];
+		latest[x] = length;
+		foreach_node(&g->neighbours[x], e, graph_list_edge_t) {
+			const graph_weight_t d =
+				weight_add_truncate_overflow(latest[e->to], -e->w);
+			if (d < latest[x])
+				latest[x] = d;
+		}
+		if (slack != NULL)
+			slack[x] = latest[x] - earliest[x];
+	}
+	return -ERROR_NO_ERROR;
+}
@@ -0,0 +1,20 @@
+#ifndef GRAPH_LIST_PRIVATE_H
+#define GRAPH_LIST_PRIVATE_H
+
+#include "graph/graph_list.h"
+
+/*
+ * Private functions of graph_list.c used by the other graph implementations
+ */
+
+/**
+ * Appends the edge (a, b) to the successors of a without checking if it
+ * already exists, returns -ERROR_ALLOCATION_FAILED if the edge could not be
+ * allocated
+ */
+int graph_list_add_edge_noverif(graph_list_t* g,
+								unsigned int a,
+								unsigned int b,
+								long long weight);
+
+#endif	// !GRAPH_LIST_PRIVATE_H
@@ -1,102 +1,50 @@
 #include "graph/graph_mat.h"
 #include <stdlib.h>
 #include "errors.h"
-#include "fixed_xifo_view.h"
+#include "graph/graph_workspace.h"
+#include "graph_template.h"
 #include "structures.h"
 #include "test_macros.h"
+#include "workspace_wrap.h"
 #include "weight_type.h"
 
-graph_mat_t* create_graph_mat(unsigned size, BOOL is_weighted) {
-	graph_mat_t* ret;
-	if (size == 0)
-		return NULL;
-	graph_mat_t* g = malloc(sizeof(graph_mat_t));
-	when_null_ret(g, NULL);
-	g->nb_vert = size;
-
-	g->edges = calloc(size * size, sizeof(BOOL));
-	when_null_jmp(g->edges, NULL, error);
-	if (is_weighted) {
-		g->weights = calloc(size * size, sizeof(graph_weight_t));
-		when_null_jmp(g->weights, NULL, error2);
-	} else
-		g->weights = NULL;
-	return g;
-error2:
-	free(g->edges);
-error:
-	free(g);
-	return ret;
-}
-
-void free_graph_mat(graph_mat_t* g) {
-	free(g->edges);
-	if (g->weights)
-		free(g->weights);
-	free(g);
-}
+DEFINE_GRAPH_MAT_BASE(graph_mat, graph_weight_t)
 
-void graph_mat_set_edge(graph_mat_t* g,
-						unsigned int a,
-						unsigned int b,
-						BOOL val,
-						graph_weight_t weight,
-						BOOL reverse) {
-	g->edges[a * g->nb_vert + b] = val;
-	if (g->weights)
-		g->weights[a * g->nb_vert + b] = weight;
-	if (reverse) {
-		g->edges[b * g->nb_vert + a] = val;
-		if (g->weights)
-			g->weights[b * g->nb_vert + a] = weight;
-	}
-}
-
-BOOL graph_mat_get_edge(graph_mat_t* g, unsigned int a, unsigned b) {
-	return g->edges[a * g->nb_vert + b];
-}
-
-graph_weight_t graph_mat_get_weight(graph_mat_t* g,
-									unsigned int a,
-									unsigned b) {
-	return g->weights ? g->weights[a * g->nb_vert + b] : 1;
-}
-
-#define DFS_INIT_MARK(type)                                \
+#define DFS_INIT_MARK                                      \
 	unsigned index = 0;                                    \
 	when_null_ret(g, -ERROR_INVALID_PARAM1);               \
 	when_false_ret(r < g->nb_vert, -ERROR_INVALID_PARAM2); \
-	type* mark = calloc(g->nb_vert, sizeof(type));         \
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);         \
+	WORKSPACE_CHECK(5)                                     \
+	graph_sp_workspace_reset(ws);                          \
 	if (father != NULL)                                    \
 		father[r] = -1;
-#define DFS_DEINIT_MARK free(mark);
 
 #ifdef STRUCT_RECURSIVE_IMPL
 static void graph_mat_preorder_dfs_rec(graph_mat_t* g,
 									   unsigned current,
 									   int* values,
 									   int* father,
-									   BOOL* mark,
+									   graph_sp_workspace_t* ws,
 									   unsigned* index) {
-	mark[current] = 1;
+	graph_sp_workspace_set_mark(ws, current, TRUE);
 	values[*index] = current;
 	*index += 1;
 	for (unsigned i = 0; i < g->nb_vert; i++) {
-		if (graph_mat_get_edge(g, current, i) && !mark[i]) {
+		if (graph_mat_get_edge(g, current, i) &&
+			!graph_sp_workspace_get_mark(ws, i)) {
 			father[i] = current;
-			graph_mat_preorder_dfs_rec(g, i, values, father, mark, index);
+			graph_mat_preorder_dfs_rec(g, i, values, father, ws, index);
 		}
 	}
 }
 
-int graph_mat_preorder_dfs(graph_mat_t* g,
-						   unsigned r,
-						   int* values,
-						   int* father) {
-	DFS_INIT_MARK(BOOL)
-	graph_mat_preorder_dfs_rec(g, r, values, father, mark, &index);
-	DFS_DEINIT_MARK
+int graph_mat_preorder_dfs_ws(graph_mat_t* g,
+							  unsigned r,
+							  int* values,
+							  int* father,
+							  graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	graph_mat_preorder_dfs_rec(g, r, values, father, ws, &index);
 	return index;
 }
 
@@ -104,12 +52,13 @@ static void graph_mat_postorder_dfs_rec(graph_mat_t* g,
 										unsigned current,
 										int* values,
 										int* father,
-										BOOL* mark,
+										graph_sp_workspace_t* ws,
 										unsigned* index) {
-	mark[current] = 1;
+	graph_sp_workspace_set_mark(ws, current, TRUE);
 	for (unsigned i = 0; i < g->nb_vert; i++) {
-		if (graph_mat_get_edge(g, current, i) && !mark[i]) {
-			graph_mat_postorder_dfs_rec(g, i, values, father, mark, index);
+		if (graph_mat_get_edge(g, current, i) &&
+			!graph_sp_workspace_get_mark(ws, i)) {
+			graph_mat_postorder_dfs_rec(g, i, values, father, ws, index);
 			if (father != NULL)
 				father[i] = current;
 		}
@@ -119,136 +68,155 @@ static void graph_mat_postorder_dfs_rec(graph_mat_t* g,
 	*index += 1;
 }
 
-int graph_mat_postorder_dfs(graph_mat_t* g,
-							unsigned r,
-							int* values,
-							int* father) {
-	DFS_INIT_MARK(BOOL)
-	graph_mat_postorder_dfs_rec(g, r, values, father, mark, &index);
-	DFS_DEINIT_MARK
+int graph_mat_postorder_dfs_ws(graph_mat_t* g,
+							   unsigned r,
+							   int* values,
+							   int* father,
+							   graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	graph_mat_postorder_dfs_rec(g, r, values, father, ws, &index);
 	return index;
 }
 #else
-int graph_mat_preorder_dfs(graph_mat_t* g,
-						   unsigned r,
-						   int* values,
-						   int* father) {
-	DFS_INIT_MARK(char)
-	mark[r] = TRUE;
+int graph_mat_preorder_dfs_ws(graph_mat_t* g,
+							  unsigned r,
+							  int* values,
+							  int* father,
+							  graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	graph_sp_workspace_set_mark(ws, r, TRUE);
 
-	fixed_xifo_view_t* waiting_list =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	fixed_xifo_copy_push_back(waiting_list, &r);
+	circular_buffer_t* waiting_list = ws->waiting_list;
+	circular_buffer_push_back(waiting_list, &r);
 
 	unsigned current;
 	do {
-		fixed_xifo_copy_pop_back(waiting_list, &current);
+		circular_buffer_pop_back(waiting_list, &current);
 		if (values != NULL)
 			values[index] = current;
 		index++;
 		for (unsigned i = 0; i < g->nb_vert; i++) {
 			int neighbour = g->nb_vert - i - 1;
-			if (graph_mat_get_edge(g, current, neighbour) && !mark[neighbour]) {
-				mark[neighbour] = TRUE;
-				fixed_xifo_copy_push_back(waiting_list, &neighbour);
+			if (graph_mat_get_edge(g, current, neighbour) &&
+				!graph_sp_workspace_get_mark(ws, neighbour)) {
+				graph_sp_workspace_set_mark(ws, neighbour, TRUE);
+				circular_buffer_push_back(waiting_list, &neighbour);
 				if (father != NULL)
 					father[neighbour] = current;
 			}
 		}
-	} while (empty_fixed_xifo(waiting_list) == FALSE);
+	} while (circular_buffer_size(waiting_list) != 0);
 
-	free_fixed_xifo(waiting_list);
-	DFS_DEINIT_MARK
 	return index;
 }
 
 typedef enum dfs_status { UNVISITED, VISITED, SUBTREEDONE } dfs_status_t;
 
-int graph_mat_postorder_dfs(graph_mat_t* g,
-							unsigned r,
-							int* values,
-							int* father) {
-	DFS_INIT_MARK(dfs_status_t)
-	mark[r] = VISITED;
+int graph_mat_postorder_dfs_ws(graph_mat_t* g,
+							   unsigned r,
+							   int* values,
+							   int* father,
+							   graph_sp_workspace_t* ws) {
+	DFS_INIT_MARK
+	graph_sp_workspace_set_mark(ws, r, VISITED);
 
-	fixed_xifo_view_t* waiting_list =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	when_null_ret(waiting_list, -ERROR_ALLOCATION_FAILED);
-	fixed_xifo_copy_push_back(waiting_list, &r);
+	circular_buffer_t* waiting_list = ws->waiting_list;
+	circular_buffer_push_back(waiting_list, &r);
 
 	unsigned current;
 	do {
-		current = fixed_xifo_copy_back(waiting_list, int);
-		if (mark[current] == SUBTREEDONE) {
+		current = *get_buffer_last(waiting_list, int);
+		if (graph_sp_workspace_get_mark(ws, current) == SUBTREEDONE) {
 			if (values != NULL)
 				values[index] = current;
 			index++;
-			fixed_xifo_copy_pop_back(waiting_list, NULL);
+			circular_buffer_pop_back(waiting_list, NULL);
 			continue;
 		}
-		/* circular_buffer_pop_back(stack, &current); */
 		for (unsigned i = 0; i < g->nb_vert; i++) {
 			int neighbour = g->nb_vert - i - 1;
 			if (graph_mat_get_edge(g, current, neighbour) &&
-				mark[neighbour] == UNVISITED) {
-				mark[neighbour] = VISITED;
-				fixed_xifo_copy_push_back(waiting_list, &neighbour);
+				graph_sp_workspace_get_mark(ws, neighbour) == UNVISITED) {
+				graph_sp_workspace_set_mark(ws, neighbour, VISITED);
+				circular_buffer_push_back(waiting_list, &neighbour);
 				if (father != NULL)
 					father[neighbour] = current;
 			}
 		}
-		mark[current] = SUBTREEDONE;
-	} while (empty_fixed_xifo(waiting_list) == FALSE);
+		graph_sp_workspace_set_mark(ws, current, SUBTREEDONE);
+	} while (circular_buffer_size(waiting_list) != 0);
 
-	free_fixed_xifo(waiting_list);
-	DFS_DEINIT_MARK
 	return index;
 }
 #endif /* ifdef STRUCT_RECURSIVE_IMPL */
 
+int graph_mat_preorder_dfs(graph_mat_t* g,
+						   unsigned r,
+						   int* values,
+						   int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_mat_preorder_dfs_ws(g, r, values, father, ws))
+}
+
+int graph_mat_postorder_dfs(graph_mat_t* g,
+							unsigned r,
+							int* values,
+							int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_mat_postorder_dfs_ws(g, r, values, father, ws))
+}
+
 static int mark_and_examine_traversal_mat(graph_mat_t* g,
 										  unsigned r,
 										  int* tab,
 										  int* father,
-										  LIST_STRUCT queue_or_stack) {
-	BOOL* mark = calloc(g->nb_vert, sizeof(BOOL));
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);
-	mark[r] = TRUE;	 // Marquer r
+										  LIST_STRUCT queue_or_stack,
+										  graph_sp_workspace_t* ws) {
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
+	graph_sp_workspace_set_mark(ws, r, TRUE);  // Marquer r
 	father[r] = -1;
 
-	fixed_xifo_view_t* waiting_list =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
+	circular_buffer_t* waiting_list = ws->waiting_list;
 	// Add the root element to the waiting list
-	fixed_xifo_copy_push_back(waiting_list, &r);
+	circular_buffer_push_back(waiting_list, &r);
 
 	unsigned index = 0;
 
-	while (empty_fixed_xifo(waiting_list) == FALSE) {
+	while (circular_buffer_size(waiting_list) != 0) {
 		int vertex;
-		fixed_xifo_copy_pop_front(waiting_list, (void*)&vertex);
+		circular_buffer_pop_front(waiting_list, (void*)&vertex);
 		if (tab != NULL)
 			tab[index] = vertex;
 		index++;
 
 		for (unsigned i = 0; i < g->nb_vert; i++) {
-			if (mark[i] == TRUE || graph_mat_get_edge(g, vertex, i) == FALSE)
+			if (graph_sp_workspace_get_mark(ws, i) ||
+				graph_mat_get_edge(g, vertex, i) == FALSE)
 				continue;
-			mark[i] = TRUE;
+			graph_sp_workspace_set_mark(ws, i, TRUE);
 			if (father)
 				father[i] = vertex;
 			if (queue_or_stack == STACK)
-				fixed_xifo_copy_push_front(waiting_list, &i);
+				circular_buffer_push_front(waiting_list, &i);
 			else
-				fixed_xifo_copy_push_back(waiting_list, &i);
+				circular_buffer_push_back(waiting_list, &i);
 		}
 	}
-	free_fixed_xifo(waiting_list);
-	free(mark);
 	return index;
 }
 
+int graph_mat_bfs_ws(graph_mat_t* g,
+					 unsigned r,
+					 int* values,
+					 int* father,
+					 graph_sp_workspace_t* ws) {
+	return mark_and_examine_traversal_mat(g, r, values, father, QUEUE, ws);
+}
+
 int graph_mat_bfs(graph_mat_t* g, unsigned r, int* values, int* father) {
-	return mark_and_examine_traversal_mat(g, r, values, father, QUEUE);
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_mat_bfs_ws(g, r, values, father, ws))
 }
 
 #define SSSHORTESTPATH_INIT                                \
@@ -264,15 +232,15 @@ int graph_mat_bfs(graph_mat_t* g, unsigned r, int* values, int* father) {
 	distance[r] = 0;
 
 #ifndef DIJKSTRA_HEAP_IMPL
-int graph_mat_dijkstra(graph_mat_t* g,
-					   unsigned r,
-					   graph_weight_t* distance,
-					   int* father) {
+int graph_mat_dijkstra_ws(graph_mat_t* g,
+						  unsigned r,
+						  graph_weight_t* distance,
+						  int* father,
+						  graph_sp_workspace_t* ws) {
 	SSSHORTESTPATH_INIT
-
-	BOOL* mark = calloc(g->nb_vert, sizeof(BOOL));
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);
-	mark[r] = TRUE;
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
+	graph_sp_workspace_set_mark(ws, r, TRUE);
 
 	unsigned pivot = r;
 	unsigned count = 1;	 // count of vertices reached by the algorithm
@@ -280,7 +248,8 @@ int graph_mat_dijkstra(graph_mat_t* g,
 		// Updates the distance of all the pivots's neighbours
 		for (unsigned j = 0; j < g->nb_vert; j++) {	 // For each vertex j
 			// which is a successor of pivot and haven't been marked
-			if (mark[j] == TRUE || graph_mat_get_edge(g, pivot, j) == FALSE)
+			if (graph_sp_workspace_get_mark(ws, j) ||
+				graph_mat_get_edge(g, pivot, j) == FALSE)
 				continue;
 			const graph_weight_t w = graph_mat_get_weight(g, pivot, j);
 			const graph_weight_t d =
@@ -297,7 +266,8 @@ int graph_mat_dijkstra(graph_mat_t* g,
 		graph_weight_t min = GRAPH_WEIGHT_INF;
 		int jmin = -1;
 		for (unsigned j = 0; j < g->nb_vert; j++) {	 // For each vertex j
-			if (mark[j] == FALSE && distance[j] >= 0 && distance[j] < min) {
+			if (!graph_sp_workspace_get_mark(ws, j) && distance[j] >= 0 &&
+				distance[j] < min) {
 				min = distance[j];
 				jmin = j;
 			}
@@ -306,75 +276,106 @@ int graph_mat_dijkstra(graph_mat_t* g,
 		if (jmin == -1)
 			break;
 		pivot = jmin;
-		mark[pivot] = TRUE;
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
 		count++;
 	}
-	free(mark);
 
 	return count;
 }
 
-#else
-#include "compare.h"
-#include "heap_view.h"
-
-DEFINE_COMPARE_MIN_SCALAR(graph_weight_t)
-
-int graph_mat_dijkstra(graph_mat_t* g,
-					   unsigned r,
-					   graph_weight_t* distance,
-					   int* father) {
+#elif defined(DIJKSTRA_DARY_HEAP_ARITY)
+int graph_mat_dijkstra_ws(graph_mat_t* g,
+						  unsigned r,
+						  graph_weight_t* distance,
+						  int* father,
+						  graph_sp_workspace_t* ws) {
 	SSSHORTESTPATH_INIT
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
+
+	// Only the reached vertices are inserted in the heap, with their distance
+	dary_heap_t* heap = ws->dary_heap;
+	dary_heap_clear(heap);
+	dary_heap_decrease_key(heap, r, 0);
 
-	heap_view_t* heap =
-		create_heap_no_check(g->nb_vert, sizeof(graph_weight_t), distance,
-							 compare_min_graph_weight_t);
-	when_null_ret(heap, -ERROR_ALLOCATION_FAILED);
+	// Number of vertices reached by the algorithm
+	unsigned number = 0;
+	int pivot;
+	while ((pivot = dary_heap_pop(heap, NULL)) != -ERROR_IS_EMPTY) {
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
+		number++;
+		for (unsigned j = 0; j < g->nb_vert; j++) {
+			if (graph_sp_workspace_get_mark(ws, j) ||
+				graph_mat_get_edge(g, pivot, j) == FALSE)
+				continue;
+			const graph_weight_t w = graph_mat_get_weight(g, pivot, j);
+			const graph_weight_t d =
+				weight_add_truncate_overflow(distance[pivot], w);
+			if (d < distance[j]) {
+				distance[j] = d;
+				dary_heap_decrease_key(heap, j, d);
+				if (father != NULL)
+					father[j] = pivot;
+			}
+		}
+	}
 
-	// We put r at the root of (index, distance) which makes it a heap
-	heap->idx_to_pos[r] = 0;
-	heap->idx_to_pos[0] = r;
-	heap->pos_to_idx[r] = 0;
-	heap->pos_to_idx[0] = r;
+	return number;
+}
+#else
+int graph_mat_dijkstra_ws(graph_mat_t* g,
+						  unsigned r,
+						  graph_weight_t* distance,
+						  int* father,
+						  graph_sp_workspace_t* ws) {
+	SSSHORTESTPATH_INIT
+	WORKSPACE_CHECK(5)
+	graph_sp_workspace_reset(ws);
 
-	BOOL* mark = calloc(g->nb_vert, sizeof(BOOL));
-	when_null_ret(mark, -ERROR_ALLOCATION_FAILED);
+	heap_view_t* heap = graph_sp_workspace_heap(ws, g->nb_vert, r, distance);
 
 	// Number of vertices reached by the algorithm
 	unsigned number = 0;
 	int pivot;
 
 	// While there is a vertex left in the heap
-	while ((pivot = heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+	while ((pivot = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
 		// Take the root of the heap (which is the non-marked vertex with the
 		// lowest distance to the root)
 		if (distance[pivot] == GRAPH_WEIGHT_INF)
 			break;
-		mark[pivot] = TRUE;
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
 		number++;
 
 		// Updates the distance of all the pivots's neighbours
 		for (unsigned j = 0; j < g->nb_vert; j++) {	 // For each vertex j
 			// which is a successor of pivot and haven't been marked
-			if (mark[j] == TRUE || graph_mat_get_edge(g, pivot, j) == FALSE)
+			if (graph_sp_workspace_get_mark(ws, j) ||
+				graph_mat_get_edge(g, pivot, j) == FALSE)
 				continue;
 			const graph_weight_t w = graph_mat_get_weight(g, pivot, j);
 			const graph_weight_t d =
 				weight_add_truncate_overflow(distance[pivot], w);
 			if (d < distance[j]) {
-				heap_update_up(heap, j, (void*)&d);
+				weight_heap_update_up(heap, j, d);
 				if (father != NULL)
 					father[j] = pivot;
 			}
 		}
 	}
-	free_heap(heap);
-	free(mark);
 
 	return number;
 }
 #endif	// DIJKSTRA_HEAP_IMPL
 
+int graph_mat_dijkstra(graph_mat_t* g,
+					   unsigned r,
+					   graph_weight_t* distance,
+					   int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_mat_dijkstra_ws(g, r, distance, father, ws))
+}
+
 unsigned int graph_mat_indegree(graph_mat_t* g, unsigned vertex) {
 	unsigned int degree = 0;
 	for (unsigned j = 0; j < g->nb_vert; j++) {
@@ -393,57 +394,62 @@ unsigned int graph_mat_outdegree(graph_mat_t* g, unsigned vertex) {
 	return degree;
 }
 
-int graph_mat_topological_ordering(graph_mat_t* g,
-								   unsigned* num,
-								   unsigned* denum) {
-	int ret = -ERROR_GRAPH_SHOULDBE_DAG;
+int graph_mat_topological_ordering_ws(graph_mat_t* g,
+									  unsigned* num,
+									  unsigned* denum,
+									  graph_sp_workspace_t* ws) {
 	when_true_ret(g->nb_vert == 0, -ERROR_GRAPH_HAS_NO_NODE);
 	when_null_ret(num, -ERROR_INVALID_PARAM2);
+	WORKSPACE_CHECK(4)
+	graph_sp_workspace_reset(ws);
 
 	int number = g->nb_vert;
 
-	fixed_xifo_view_t* stack =
-		create_fixed_xifo_copy(sizeof(unsigned), g->nb_vert);
-	when_null_ret(stack, -ERROR_ALLOCATION_FAILED);
+	circular_buffer_t* stack = ws->waiting_list;
 
-	unsigned degre[g->nb_vert];
+	unsigned* degre = ws->degree;
 	for (unsigned i = 0; i < g->nb_vert; i++) {
 		degre[i] = graph_mat_outdegree(g, i);
 		if (degre[i] == 0)
-			fixed_xifo_copy_push_front(stack, &i);
+			circular_buffer_push_front(stack, &i);
 	}
-	if (empty_fixed_xifo(stack) == TRUE)
-		goto exit;
+	if (circular_buffer_size(stack) == 0)
+		return -ERROR_GRAPH_SHOULDBE_DAG;
 	do {
 		unsigned s;
-		fixed_xifo_copy_pop_front(stack, (void*)&s);
+		circular_buffer_pop_front(stack, (void*)&s);
 		num[s] = --number;
 		if (denum)
 			denum[number] = s;
 		for (unsigned t = 0; t < g->nb_vert; t++) {
 			if (graph_mat_get_edge(g, t, s) && --degre[t] == 0)
-				fixed_xifo_copy_push_front(stack, &t);
+				circular_buffer_push_front(stack, &t);
 		}
-	} while (empty_fixed_xifo(stack) == FALSE);
+	} while (circular_buffer_size(stack) != 0);
 	if (number != 0)
-		goto exit;
-	ret = -ERROR_NO_ERROR;
-exit:
-	free_fixed_xifo(stack);
-	return ret;
+		return -ERROR_GRAPH_SHOULDBE_DAG;
+	return -ERROR_NO_ERROR;
 }
 
-int graph_mat_bellman(graph_mat_t* g,
-					  unsigned r,
-					  graph_weight_t* distance,
-					  int* father) {
+int graph_mat_topological_ordering(graph_mat_t* g,
+								   unsigned* num,
+								   unsigned* denum) {
+	WITH_WORKSPACE(-ERROR_GRAPH_HAS_NO_NODE,
+				   graph_mat_topological_ordering_ws(g, num, denum, ws))
+}
+
+int graph_mat_bellman_ws(graph_mat_t* g,
+						 unsigned r,
+						 graph_weight_t* distance,
+						 int* father,
+						 graph_sp_workspace_t* ws) {
 	SSSHORTESTPATH_INIT
+	WORKSPACE_CHECK(5)
 
-	unsigned* num = malloc(2 * g->nb_vert * sizeof(unsigned int));
-	when_null_ret(num, -ERROR_ALLOCATION_FAILED);
+	unsigned* num = ws->num;
 	unsigned* denum = num + g->nb_vert;
-	int ret = graph_mat_topological_ordering(g, num, denum);
-	when_false_jmp(ret == ERROR_NO_ERROR, ret, exit);
+	int ret = graph_mat_topological_ordering_ws(g, num, denum, ws);
+	when_false_ret(ret == ERROR_NO_ERROR, ret);
 
 	for (unsigned i = num[r] + 1; i < g->nb_vert; i++) {
 		graph_weight_t min = GRAPH_WEIGHT_INF;
@@ -468,11 +474,17 @@ int graph_mat_bellman(graph_mat_t* g,
 		}
 	}
 
-exit:
-	free(num);
 	return ret;
 }
 
+int graph_mat_bellman(graph_mat_t* g,
+					  unsigned r,
+					  graph_weight_t* distance,
+					  int* father) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_mat_bellman_ws(g, r, distance, father, ws))
+}
+
 int graph_mat_ford(graph_mat_t* g,
 				   unsigned r,
 				   graph_weight_t* distance,
@@ -512,6 +524,16 @@ int graph_mat_ford(graph_mat_t* g,
 	return -ERROR_NO_ERROR;
 }
 
+int graph_mat_ford_ws(graph_mat_t* g,
+					  unsigned r,
+					  graph_weight_t* distance,
+					  int* father,
+					  graph_sp_workspace_t* ws) {
+	// Ford algorithm doesn't need any temporary buffer
+	(void)ws;
+	return graph_mat_ford(g, r, distance, father);
+}
+
 static BOOL test_if_edge_create_cycle(int* father, int a, int b) {
 	int current = a;
 	while (current != -1) {
@@ -522,17 +544,17 @@ static BOOL test_if_edge_create_cycle(int* father, int a, int b) {
 	return FALSE;
 }
 
-int graph_mat_ford_dantzig(graph_mat_t* g,
-						   unsigned r,
-						   graph_weight_t* distance,
-						   int* father,
-						   int* cycle) {
+int graph_mat_ford_dantzig_ws(graph_mat_t* g,
+							  unsigned r,
+							  graph_weight_t* distance,
+							  int* father,
+							  int* cycle,
+							  graph_sp_workspace_t* ws) {
 	when_null_ret(father, -ERROR_INVALID_PARAM4);
-	int ret = graph_mat_dijkstra(g, r, distance, father);
+	WORKSPACE_CHECK(6)
+	int ret = graph_mat_dijkstra_ws(g, r, distance, father, ws);
 	when_false_ret(ret >= 0, ret);
-	fixed_xifo_view_t* update_queue =
-		create_fixed_xifo_copy(sizeof(int), g->nb_vert);
-	when_null_ret(update_queue, -ERROR_ALLOCATION_FAILED);
+	circular_buffer_t* update_queue = ws->waiting_list;
 
 	while (TRUE) {
 		BOOL found = FALSE;
@@ -560,25 +582,31 @@ int graph_mat_ford_dantzig(graph_mat_t* g,
 		father[y] = x;
 		if (test_if_edge_create_cycle(father, x, y) == TRUE) {
 			*cycle = x;
-			ret = -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT;
-			goto exit;
+			return -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT;
 		}
-		fixed_xifo_copy_push_back(update_queue, &y);
+		circular_buffer_push_back(update_queue, &y);
 
 		do {
-			fixed_xifo_copy_pop_front(update_queue, &x);
+			circular_buffer_pop_front(update_queue, &x);
 			for (unsigned y = 0; y < g->nb_vert; y++) {
 				if (father[y] == x) {
-					const graph_weight_t w = graph_mat_get_weight(g, y, x);
+					const graph_weight_t w = graph_mat_get_weight(g, x, y);
 					d = weight_add_truncate_overflow(distance[x], w);
 					distance[y] = d;
-					fixed_xifo_copy_push_back(update_queue, &y);
+					circular_buffer_push_back(update_queue, &y);
 				}
 			}
-		} while (empty_fixed_xifo(update_queue) == FALSE);
+		} while (circular_buffer_size(update_queue) != 0);
 	}
 
-exit:
-	free_fixed_xifo(update_queue);
 	return ret;
 }
+
+int graph_mat_ford_dantzig(graph_mat_t* g,
+						   unsigned r,
+						   graph_weight_t* distance,
+						   int* father,
+						   int* cycle) {
+	WITH_WORKSPACE(-ERROR_INVALID_PARAM2,
+				   graph_mat_ford_dantzig_ws(g, r, distance, father, cycle, ws))
+}
@@ -0,0 +1,104 @@
+#include "graph/graph_msbfs.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "errors.h"
+#include "test_macros.h"
+
+#define W GRAPH_MSBFS_WORDS
+
+static inline unsigned lowest_bit(uint64_t x) {
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#else
+	unsigned n = 0;
+	while ((x & 1) == 0) {
+		x >>= 1;
+		n++;
+	}
+	return n;
+#endif
+}
+
+static void msbfs_batch(graph_list_t* g,
+						const unsigned* sources,
+						unsigned nb_sources,
+						int* distance,
+						uint64_t* seen,
+						uint64_t* visit,
+						uint64_t* next) {
+	const unsigned n = g->nb_vert;
+	memset(seen, 0, (size_t)n * W * sizeof(uint64_t));
+	memset(visit, 0, (size_t)n * W * sizeof(uint64_t));
+	memset(next, 0, (size_t)n * W * sizeof(uint64_t));
+	for (size_t i = 0; i < (size_t)nb_sources * n; i++)
+		distance[i] = -1;
+
+	for (unsigned s = 0; s < nb_sources; s++) {
+		const uint64_t bit = (uint64_t)1 << (s & 63);
+		seen[sources[s] * W + s / 64] |= bit;
+		visit[sources[s] * W + s / 64] |= bit;
+		distance[(size_t)s * n + sources[s]] = 0;
+	}
+
+	BOOL active = TRUE;
+	for (int level = 1; active == TRUE; level++) {
+		// Every vertex of the frontier sends its sources to its neighbours
+		for (unsigned v = 0; v < n; v++) {
+			uint64_t any = 0;
+			for (unsigned k = 0; k < W; k++)
+				any |= visit[v * W + k];
+			if (any == 0)
+				continue;
+			foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+				for (unsigned k = 0; k < W; k++)
+					next[e->to * W + k] |= visit[v * W + k];
+			}
+		}
+
+		// Keeps only the sources which reach a vertex for the first time
+		active = FALSE;
+		for (unsigned v = 0; v < n; v++) {
+			for (unsigned k = 0; k < W; k++) {
+				uint64_t discovered = next[v * W + k] & ~seen[v * W + k];
+				next[v * W + k] = 0;
+				visit[v * W + k] = discovered;
+				if (discovered == 0)
+					continue;
+				active = TRUE;
+				seen[v * W + k] |= discovered;
+				do {
+					const unsigned s = k * 64 + lowest_bit(discovered);
+					distance[(size_t)s * n + v] = level;
+					discovered &= discovered - 1;
+				} while (discovered);
+			}
+		}
+	}
+}
+
+int graph_list_msbfs(graph_list_t* g,
+					 const unsigned* sources,
+					 unsigned nb_sources,
+					 int* distance) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_null_ret(sources, -ERROR_INVALID_PARAM2);
+	when_null_ret(distance, -ERROR_INVALID_PARAM4);
+	for (unsigned s = 0; s < nb_sources; s++)
+		when_false_ret(sources[s] < g->nb_vert, -ERROR_INVALID_PARAM2);
+
+	// seen, visit and next frontiers are stored contiguously
+	const size_t frontier = (size_t)g->nb_vert * W;
+	uint64_t* seen = malloc(3 * frontier * sizeof(uint64_t));
+	when_null_ret(seen, -ERROR_ALLOCATION_FAILED);
+
+	for (unsigned first = 0; first < nb_sources; first += GRAPH_MSBFS_BATCH) {
+		const unsigned count = MIN(GRAPH_MSBFS_BATCH, nb_sources - first);
+		msbfs_batch(g, sources + first, count,
+					distance + (size_t)first * g->nb_vert, seen,
+					seen + frontier, seen + 2 * frontier);
+	}
+
+	free(seen);
+	return -ERROR_NO_ERROR;
+}
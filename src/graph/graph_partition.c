@@ -0,0 +1,533 @@
+#include "graph/graph_partition.h"
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "graph_list_private.h"
+#include "prng.h"
+#include "test_macros.h"
+
+/** The coarsening stops under this number of vertices per part */
+#define COARSEST_VERTICES_PER_PART 16
+/** Or when a matching removes less than 1 / COARSENING_MIN_RATIO vertices */
+#define COARSENING_MIN_RATIO 20
+#define REFINEMENT_PASSES 8
+#define NO_VERTEX UINT_MAX
+
+/**
+ * Undirected weighted graph in CSR form, the edges of v are adj[xadj[v]] to
+ * adj[xadj[v + 1] - 1]
+ */
+typedef struct part_graph {
+	unsigned nb_vert;
+	size_t* xadj;
+	unsigned* adj;
+	unsigned* adjw;
+	/**< Weights of the edges */
+	unsigned* vw;
+	/**< Weights of the vertices */
+	unsigned* cmap;
+	/**< Vertex of the coarser graph each vertex is merged into */
+} part_graph_t;
+
+/**
+ * Scratch arrays of the partitioner, sized for the finest graph
+ */
+typedef struct partitioner {
+	unsigned k;
+	unsigned max_weight;
+	/**< Maximum weight of a part */
+	prng_t rng;
+	unsigned* part_weight;
+	/**< Array of size k */
+	unsigned* conn;
+	/**< Array of size k of the connectivity of a vertex to each part */
+	unsigned* touched;
+	/**< Parts whose connectivity is not 0 */
+} partitioner_t;
+
+static void free_part_graph(part_graph_t* g) {
+	if (g == NULL)
+		return;
+	free(g->xadj);
+	free(g->adj);
+	free(g->adjw);
+	free(g->vw);
+	free(g->cmap);
+	free(g);
+}
+
+static part_graph_t* create_part_graph(unsigned nb_vert, size_t nb_edges) {
+	part_graph_t* ret;
+	part_graph_t* g = calloc(1, sizeof(part_graph_t));
+	when_null_ret(g, NULL);
+	g->nb_vert = nb_vert;
+	g->xadj = malloc((nb_vert + 1) * sizeof(size_t));
+	g->adj = malloc((nb_edges ? nb_edges : 1) * sizeof(unsigned));
+	g->adjw = malloc((nb_edges ? nb_edges : 1) * sizeof(unsigned));
+	g->vw = malloc(nb_vert * sizeof(unsigned));
+	when_true_jmp(g->xadj == NULL || g->adj == NULL || g->adjw == NULL ||
+					  g->vw == NULL,
+				  NULL, error);
+	return g;
+error:
+	free_part_graph(g);
+	return ret;
+}
+
+/**
+ * Symmetrizes the graph: both directions of every edge are listed then the
+ * duplicates are merged, adding their weights. Self loops are dropped.
+ */
+static part_graph_t* symmetrize(graph_list_t* g) {
+	part_graph_t* ret;
+	const unsigned n = g->nb_vert;
+	size_t* degree = calloc(n + 1, sizeof(size_t));
+	when_null_ret(degree, NULL);
+	for (unsigned i = 0; i < n; i++) {
+		foreach_node(&g->neighbours[i], e, graph_list_edge_t) {
+			if (e->to == i)
+				continue;
+			degree[i]++;
+			degree[e->to]++;
+		}
+	}
+	size_t nb_edges = 0;
+	for (unsigned i = 0; i < n; i++)
+		nb_edges += degree[i];
+	part_graph_t* pg = create_part_graph(n, nb_edges);
+	size_t* pos = malloc(n * sizeof(size_t));
+	when_true_jmp(pg == NULL || pos == NULL, NULL, error);
+
+	// degree becomes the insertion cursor of each vertex
+	size_t offset = 0;
+	for (unsigned i = 0; i < n; i++) {
+		const size_t d = degree[i];
+		degree[i] = offset;
+		offset += d;
+	}
+	for (unsigned i = 0; i < n; i++) {
+		foreach_node(&g->neighbours[i], e, graph_list_edge_t) {
+			if (e->to == i)
+				continue;
+			pg->adj[degree[i]++] = e->to;
+			pg->adj[degree[e->to]++] = i;
+		}
+	}
+
+	// Merges the duplicates, pos[v] is the position of v in the current list
+	for (unsigned i = 0; i < n; i++)
+		pos[i] = SIZE_MAX;
+	size_t begin = 0, w = 0;
+	for (unsigned i = 0; i < n; i++) {
+		const size_t start = w;
+		pg->xadj[i] = start;
+		pg->vw[i] = 1;
+		for (size_t j = begin; j < degree[i]; j++) {
+			const unsigned v = pg->adj[j];
+			if (pos[v] != SIZE_MAX) {
+				pg->adjw[pos[v]]++;
+				continue;
+			}
+			pos[v] = w;
+			pg->adj[w] = v;
+			pg->adjw[w++] = 1;
+		}
+		for (size_t j = start; j < w; j++)
+			pos[pg->adj[j]] = SIZE_MAX;
+		begin = degree[i];
+	}
+	pg->xadj[n] = w;
+	ret = pg;
+	pg = NULL;
+error:
+	free_part_graph(pg);
+	free(pos);
+	free(degree);
+	return ret;
+}
+
+/**
+ * Contracts a heavy edge matching of g and fills g->cmap
+ */
+static part_graph_t* coarsen(part_graph_t* g, prng_t* rng) {
+	part_graph_t* ret = NULL;
+	const unsigned n = g->nb_vert;
+	unsigned* match = malloc(n * sizeof(unsigned));
+	unsigned* perm = malloc(n * sizeof(unsigned));
+	size_t* pos = NULL;
+	part_graph_t* c = NULL;
+	g->cmap = malloc(n * sizeof(unsigned));
+	when_true_jmp(match == NULL || perm == NULL || g->cmap == NULL, NULL,
+				  end);
+
+	for (unsigned i = 0; i < n; i++) {
+		const unsigned j = prng_bounded(rng, i + 1);
+		perm[i] = perm[j];
+		perm[j] = i;
+		match[i] = NO_VERTEX;
+	}
+	for (unsigned i = 0; i < n; i++) {
+		const unsigned v = perm[i];
+		if (match[v] != NO_VERTEX)
+			continue;
+		unsigned best = v, best_weight = 0;
+		for (size_t j = g->xadj[v]; j < g->xadj[v + 1]; j++) {
+			if (match[g->adj[j]] == NO_VERTEX && g->adjw[j] > best_weight) {
+				best = g->adj[j];
+				best_weight = g->adjw[j];
+			}
+		}
+		match[v] = best;
+		match[best] = v;
+	}
+	unsigned cn = 0;
+	for (unsigned v = 0; v < n; v++) {
+		if (v <= match[v])
+			g->cmap[v] = g->cmap[match[v]] = cn++;
+	}
+
+	c = create_part_graph(cn, g->xadj[n]);
+	pos = malloc(cn * sizeof(size_t));
+	when_true_jmp(c == NULL || pos == NULL, NULL, end);
+	for (unsigned i = 0; i < cn; i++)
+		pos[i] = SIZE_MAX;
+	size_t w = 0;
+	for (unsigned v = 0; v < n; v++) {
+		if (v > match[v])
+			continue;
+		const unsigned cv = g->cmap[v];
+		const size_t start = w;
+		const unsigned merged[2] = {v, match[v]};
+		c->xadj[cv] = start;
+		c->vw[cv] = 0;
+		for (unsigned m = 0; m < (v == match[v] ? 1u : 2u); m++) {
+			const unsigned u = merged[m];
+			c->vw[cv] += g->vw[u];
+			for (size_t j = g->xadj[u]; j < g->xadj[u + 1]; j++) {
+				const unsigned cu = g->cmap[g->adj[j]];
+				if (cu == cv)
+					continue;
+				if (pos[cu] != SIZE_MAX) {
+					c->adjw[pos[cu]] += g->adjw[j];
+					continue;
+				}
+				pos[cu] = w;
+				c->adj[w] = cu;
+				c->adjw[w++] = g->adjw[j];
+			}
+		}
+		for (size_t j = start; j < w; j++)
+			pos[c->adj[j]] = SIZE_MAX;
+	}
+	c->xadj[cn] = w;
+	ret = c;
+	c = NULL;
+end:
+	free_part_graph(c);
+	free(pos);
+	free(perm);
+	free(match);
+	return ret;
+}
+
+/**
+ * Grows the parts one after the other: the vertex the most connected to the
+ * current part is added until the part weighs its share of the remaining
+ * weight. conn and frontier are arrays of size g->nb_vert.
+ */
+static void initial_partition(part_graph_t* g,
+							  partitioner_t* p,
+							  unsigned* part,
+							  unsigned* conn,
+							  unsigned* frontier) {
+	const unsigned n = g->nb_vert;
+	unsigned long long remaining = 0;
+	for (unsigned v = 0; v < n; v++) {
+		remaining += g->vw[v];
+		part[v] = NO_VERTEX;
+		conn[v] = 0;
+	}
+	unsigned nb_unassigned = n, seed = 0;
+	for (unsigned k = 0; k + 1 < p->k; k++) {
+		const unsigned long long target = remaining / (p->k - k);
+		unsigned long long weight = 0;
+		unsigned nb_frontier = 0;
+		// Leaves at least one vertex to each of the next parts
+		while (weight < target && nb_unassigned > p->k - k - 1) {
+			unsigned v = NO_VERTEX, best = 0;
+			for (unsigned i = 0; i < nb_frontier;) {
+				const unsigned u = frontier[i];
+				if (part[u] != NO_VERTEX) {
+					frontier[i] = frontier[--nb_frontier];
+					continue;
+				}
+				if (conn[u] > best) {
+					best = conn[u];
+					v = u;
+				}
+				i++;
+			}
+			if (v == NO_VERTEX) {
+				while (part[seed] != NO_VERTEX)
+					seed++;
+				v = seed;
+			}
+			// Stops if adding v overshoots more than it fills
+			if (weight > 0 && weight + g->vw[v] > target &&
+				weight + g->vw[v] - target > target - weight)
+				break;
+			part[v] = k;
+			weight += g->vw[v];
+			nb_unassigned--;
+			for (size_t j = g->xadj[v]; j < g->xadj[v + 1]; j++) {
+				const unsigned u = g->adj[j];
+				if (part[u] != NO_VERTEX)
+					continue;
+				if (conn[u] == 0)
+					frontier[nb_frontier++] = u;
+				conn[u] += g->adjw[j];
+			}
+		}
+		for (unsigned i = 0; i < nb_frontier; i++)
+			conn[frontier[i]] = 0;
+		remaining -= weight;
+	}
+	for (unsigned v = 0; v < n; v++) {
+		if (part[v] == NO_VERTEX)
+			part[v] = p->k - 1;
+	}
+}
+
+/**
+ * Moves a vertex to the neighbouring part with the largest gain, i.e. the
+ * largest decrease of the edge cut, if it is positive. A vertex of an
+ * overweight part is moved even with a negative gain, to the lightest part if
+ * no neighbouring part can receive it. Returns TRUE if v was moved.
+ */
+static BOOL refine_vertex(part_graph_t* g,
+						  partitioner_t* p,
+						  unsigned* part,
+						  unsigned v) {
+	const unsigned own = part[v];
+	const unsigned vw = g->vw[v];
+	const BOOL overweight = p->part_weight[own] > p->max_weight;
+	unsigned nb_touched = 0;
+	for (size_t j = g->xadj[v]; j < g->xadj[v + 1]; j++) {
+		const unsigned q = part[g->adj[j]];
+		if (p->conn[q] == 0)
+			p->touched[nb_touched++] = q;
+		p->conn[q] += g->adjw[j];
+	}
+
+	const long long internal = p->conn[own];
+	unsigned best = own;
+	long long best_gain = 0;
+	for (unsigned i = 0; i < nb_touched; i++) {
+		const unsigned q = p->touched[i];
+		if (q == own || p->part_weight[q] + vw > p->max_weight)
+			continue;
+		const long long gain = (long long)p->conn[q] - internal;
+		if ((overweight && best == own) || gain > best_gain ||
+			// Equal gains are used to improve the balance
+			(gain == best_gain &&
+			 p->part_weight[q] + vw < p->part_weight[best])) {
+			best = q;
+			best_gain = gain;
+		}
+	}
+	for (unsigned i = 0; i < nb_touched; i++)
+		p->conn[p->touched[i]] = 0;
+
+	if (overweight && best == own) {
+		for (unsigned q = 0; q < p->k; q++) {
+			if (p->part_weight[q] < p->part_weight[best])
+				best = q;
+		}
+		if (p->part_weight[best] + vw > p->max_weight)
+			best = own;
+	}
+	if (best == own)
+		return FALSE;
+	p->part_weight[own] -= vw;
+	p->part_weight[best] += vw;
+	part[v] = best;
+	return TRUE;
+}
+
+static void refine(part_graph_t* g, partitioner_t* p, unsigned* part) {
+	for (unsigned q = 0; q < p->k; q++)
+		p->part_weight[q] = 0;
+	for (unsigned v = 0; v < g->nb_vert; v++)
+		p->part_weight[part[v]] += g->vw[v];
+	for (unsigned pass = 0; pass < REFINEMENT_PASSES; pass++) {
+		unsigned moved = 0;
+		for (unsigned v = 0; v < g->nb_vert; v++)
+			moved += refine_vertex(g, p, part, v);
+		if (moved == 0)
+			break;
+	}
+}
+
+/**
+ * Partitions g in part (array of size g->nb_vert), coarsening it recursively
+ */
+static int multilevel(part_graph_t* g, partitioner_t* p, unsigned* part) {
+	const unsigned n = g->nb_vert;
+	part_graph_t* c = NULL;
+	if (n > COARSEST_VERTICES_PER_PART * p->k) {
+		c = coarsen(g, &p->rng);
+		when_null_ret(c, -ERROR_ALLOCATION_FAILED);
+		if (n - c->nb_vert < n / COARSENING_MIN_RATIO) {
+			free_part_graph(c);
+			c = NULL;
+		}
+	}
+
+	if (c == NULL) {
+		unsigned* conn = malloc(n * sizeof(unsigned));
+		unsigned* frontier = malloc(n * sizeof(unsigned));
+		const BOOL allocated = conn != NULL && frontier != NULL;
+		if (allocated)
+			initial_partition(g, p, part, conn, frontier);
+		free(conn);
+		free(frontier);
+		when_false_ret(allocated, -ERROR_ALLOCATION_FAILED);
+	} else {
+		unsigned* coarse_part = malloc(c->nb_vert * sizeof(unsigned));
+		int error = -ERROR_ALLOCATION_FAILED;
+		if (coarse_part != NULL)
+			error = multilevel(c, p, coarse_part);
+		if (error == -ERROR_NO_ERROR) {
+			for (unsigned v = 0; v < n; v++)
+				part[v] = coarse_part[g->cmap[v]];
+		}
+		free(coarse_part);
+		free_part_graph(c);
+		when_false_ret(error == -ERROR_NO_ERROR, error);
+	}
+	refine(g, p, part);
+	return -ERROR_NO_ERROR;
+}
+
+int graph_list_partition(graph_list_t* g,
+						 unsigned k,
+						 double imbalance,
+						 uint64_t seed,
+						 unsigned* part) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_true_ret(k == 0 || k > g->nb_vert, -ERROR_INVALID_PARAM2);
+	when_true_ret(imbalance < 0, -ERROR_INVALID_PARAM3);
+	when_null_ret(part, -ERROR_INVALID_PARAM5);
+
+	const double max_weight = ceil((1 + imbalance) * g->nb_vert / k);
+	partitioner_t p;
+	p.k = k;
+	p.max_weight = max_weight < UINT_MAX ? (unsigned)max_weight : UINT_MAX;
+	prng_seed(&p.rng, seed);
+	p.part_weight = malloc(k * sizeof(unsigned));
+	p.conn = calloc(k, sizeof(unsigned));
+	p.touched = malloc(k * sizeof(unsigned));
+	part_graph_t* pg = symmetrize(g);
+	int ret = -ERROR_ALLOCATION_FAILED;
+	if (p.part_weight != NULL && p.conn != NULL && p.touched != NULL &&
+		pg != NULL)
+		ret = multilevel(pg, &p, part);
+	free_part_graph(pg);
+	free(p.part_weight);
+	free(p.conn);
+	free(p.touched);
+	return ret;
+}
+
+size_t graph_list_edge_cut(graph_list_t* g, const unsigned* part) {
+	size_t cut = 0;
+	for (unsigned i = 0; i < g->nb_vert; i++) {
+		foreach_node(&g->neighbours[i], e, graph_list_edge_t) {
+			cut += part[i] != part[e->to];
+		}
+	}
+	return cut;
+}
+
+graph_subgraph_t* graph_list_split(graph_list_t* g,
+								   const unsigned* part,
+								   unsigned k) {
+	graph_subgraph_t* ret;
+	when_null_ret(g, NULL);
+	when_null_ret(part, NULL);
+	when_true_ret(k == 0, NULL);
+	const unsigned n = g->nb_vert;
+	graph_subgraph_t* subgraphs = calloc(k, sizeof(graph_subgraph_t));
+	// Vertices sorted by part, first[q] is the first vertex of the part q
+	unsigned* first = calloc(k + 1, sizeof(unsigned));
+	unsigned* order = malloc(n * sizeof(unsigned));
+	// Index of each vertex in its part then in the part it is a ghost of
+	unsigned* local = malloc(n * sizeof(unsigned));
+	unsigned* ghost = malloc(n * sizeof(unsigned));
+	unsigned* ghost_of = malloc(n * sizeof(unsigned));
+	when_true_jmp(subgraphs == NULL || first == NULL || order == NULL ||
+					  local == NULL || ghost == NULL || ghost_of == NULL,
+				  NULL, error);
+
+	for (unsigned v = 0; v < n; v++) {
+		when_false_jmp(part[v] < k, NULL, error);
+		local[v] = first[part[v] + 1]++;
+		ghost_of[v] = NO_VERTEX;
+	}
+	for (unsigned q = 0; q < k; q++)
+		first[q + 1] += first[q];
+	for (unsigned v = 0; v < n; v++)
+		order[first[part[v]] + local[v]] = v;
+
+	for (unsigned q = 0; q < k; q++) {
+		graph_subgraph_t* s = &subgraphs[q];
+		s->nb_owned = first[q + 1] - first[q];
+		unsigned size = s->nb_owned;
+		for (unsigned i = first[q]; i < first[q + 1]; i++) {
+			foreach_node(&g->neighbours[order[i]], e, graph_list_edge_t) {
+				if (part[e->to] == q || ghost_of[e->to] == q)
+					continue;
+				ghost_of[e->to] = q;
+				ghost[e->to] = size++;
+			}
+		}
+		if (size == 0)
+			continue;
+		s->g = create_graph_list(size, g->is_weighted);
+		s->global = malloc(size * sizeof(unsigned));
+		when_true_jmp(s->g == NULL || s->global == NULL, NULL, error);
+		for (unsigned i = first[q]; i < first[q + 1]; i++) {
+			const unsigned v = order[i];
+			s->global[local[v]] = v;
+			foreach_node(&g->neighbours[v], e, graph_list_edge_t) {
+				const unsigned to = part[e->to] == q ? local[e->to]
+													 : ghost[e->to];
+				s->global[to] = e->to;
+				when_false_jmp(graph_list_add_edge_noverif(s->g, local[v], to,
+														   e->w) == 0,
+							   NULL, error);
+			}
+		}
+	}
+	ret = subgraphs;
+	subgraphs = NULL;
+error:
+	free_graph_subgraphs(subgraphs, k);
+	free(first);
+	free(order);
+	free(local);
+	free(ghost);
+	free(ghost_of);
+	return ret;
+}
+
+void free_graph_subgraphs(graph_subgraph_t* subgraphs, unsigned k) {
+	if (subgraphs == NULL)
+		return;
+	for (unsigned q = 0; q < k; q++) {
+		free_graph_list(subgraphs[q].g);
+		free(subgraphs[q].global);
+	}
+	free(subgraphs);
+}
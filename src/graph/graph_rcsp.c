@@ -0,0 +1,288 @@
+#include "graph/graph_rcsp.h"
+#include <limits.h>
+#include <stdlib.h>
+#include "dynarray.h"
+#include "errors.h"
+#include "graph/graph_workspace.h"
+#include "heap_view.h"
+#include "test_macros.h"
+
+#define NO_LABEL UINT_MAX
+
+typedef struct rcsp_label {
+	graph_weight_t cost;
+	graph_weight_t res;
+	unsigned vertex;
+	unsigned length;
+	/**< Number of vertices of the path */
+	unsigned pred;
+	/**< Label the path extends, NO_LABEL for the source */
+	unsigned next;
+	/**< Next label of the Pareto set of the vertex */
+	BOOL dead;
+	/**< TRUE if the label was dominated or evicted */
+} rcsp_label_t;
+
+typedef struct rcsp_search {
+	const graph_csr_t* g;
+	const graph_weight_t* resource;
+	graph_weight_t budget;
+	unsigned max_labels;
+	graph_weight_t* lower_bound;
+	/**< Minimum resource from each vertex to the destination */
+	dynarray_t* pool;
+	/**< Every label created */
+	dynarray_t* queue;
+	/**< Binary heap of the indexes of the labels to settle */
+	unsigned* head;
+	/**< First label of the Pareto set of each vertex */
+	unsigned* count;
+	/**< Number of labels of the Pareto set of each vertex */
+} rcsp_search_t;
+
+#define LABEL(search, i) (((rcsp_label_t*)(search)->pool->data)[i])
+#define QUEUE(search) ((unsigned*)(search)->queue->data)
+
+/**
+ * Minimum resource from every vertex to dst (Dijkstra on the reversed graph)
+ */
+static int resource_lower_bound(rcsp_search_t* search, unsigned dst) {
+	const graph_csr_t* g = search->g;
+	const unsigned n = g->nb_vert;
+	graph_csr_t* reverse = create_graph_csr(n, g->nb_edges, TRUE);
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(n);
+	int ret = -ERROR_ALLOCATION_FAILED;
+	if (reverse == NULL || ws == NULL)
+		goto end;
+
+	for (unsigned v = 0; v <= n; v++)
+		reverse->offset[v] = 0;
+	for (size_t i = 0; i < g->nb_edges; i++)
+		reverse->offset[g->to[i] + 1]++;
+	for (unsigned v = 0; v < n; v++)
+		reverse->offset[v + 1] += reverse->offset[v];
+	// offset[v] is used as the insertion cursor then shifted back
+	for (unsigned v = 0; v < n; v++) {
+		for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+			const size_t j = reverse->offset[g->to[i]]++;
+			reverse->to[j] = v;
+			reverse->weights[j] = search->resource[i];
+		}
+	}
+	for (unsigned v = n; v > 0; v--)
+		reverse->offset[v] = reverse->offset[v - 1];
+	reverse->offset[0] = 0;
+
+	graph_weight_t* bound = search->lower_bound;
+	for (unsigned v = 0; v < n; v++)
+		bound[v] = GRAPH_WEIGHT_INF;
+	bound[dst] = 0;
+	graph_sp_workspace_reset(ws);
+	heap_view_t* heap = graph_sp_workspace_heap(ws, n, dst, bound);
+	int v;
+	while ((v = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (bound[v] == GRAPH_WEIGHT_INF)
+			break;
+		graph_sp_workspace_set_mark(ws, v, TRUE);
+		for (size_t i = reverse->offset[v]; i < reverse->offset[v + 1]; i++) {
+			const unsigned u = reverse->to[i];
+			if (graph_sp_workspace_get_mark(ws, u))
+				continue;
+			graph_weight_t d =
+				weight_add_truncate_overflow(bound[v], reverse->weights[i]);
+			if (d < bound[u])
+				weight_heap_update_up(heap, u, d);
+		}
+	}
+	ret = -ERROR_NO_ERROR;
+end:
+	free_graph_csr(reverse);
+	free_graph_sp_workspace(ws);
+	return ret;
+}
+
+static BOOL label_less(rcsp_search_t* search, unsigned a, unsigned b) {
+	const rcsp_label_t* x = &LABEL(search, a);
+	const rcsp_label_t* y = &LABEL(search, b);
+	return x->cost < y->cost || (x->cost == y->cost && x->res < y->res);
+}
+
+static int queue_push(rcsp_search_t* search, unsigned label) {
+	if (dynarray_push_back(search->queue, &label) == NULL)
+		return -ERROR_ALLOCATION_FAILED;
+	unsigned* q = QUEUE(search);
+	unsigned i = search->queue->size - 1;
+	while (i > 0 && label_less(search, label, q[(i - 1) / 2])) {
+		q[i] = q[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	q[i] = label;
+	return -ERROR_NO_ERROR;
+}
+
+static unsigned queue_pop(rcsp_search_t* search) {
+	unsigned* q = QUEUE(search);
+	const unsigned root = q[0];
+	const unsigned last = q[--search->queue->size];
+	const unsigned size = search->queue->size;
+	unsigned i = 0;
+	while (2 * i + 1 < size) {
+		unsigned child = 2 * i + 1;
+		if (child + 1 < size && label_less(search, q[child + 1], q[child]))
+			child++;
+		if (!label_less(search, q[child], last))
+			break;
+		q[i] = q[child];
+		i = child;
+	}
+	if (size > 0)
+		q[i] = last;
+	return root;
+}
+
+/**
+ * Adds the label (cost, res) to the Pareto set of v unless it is dominated,
+ * removing the labels it dominates
+ */
+static int add_label(rcsp_search_t* search,
+					 unsigned v,
+					 graph_weight_t cost,
+					 graph_weight_t res,
+					 unsigned pred) {
+	unsigned* link = &search->head[v];
+	unsigned worst = NO_LABEL;
+	while (*link != NO_LABEL) {
+		rcsp_label_t* l = &LABEL(search, *link);
+		if (l->cost <= cost && l->res <= res)
+			return -ERROR_NO_ERROR;
+		if (cost <= l->cost && res <= l->res) {
+			l->dead = TRUE;
+			search->count[v]--;
+			*link = l->next;
+			continue;
+		}
+		if (worst == NO_LABEL || l->res > LABEL(search, worst).res)
+			worst = *link;
+		link = &l->next;
+	}
+	if (search->max_labels > 0 && search->count[v] >= search->max_labels) {
+		if (LABEL(search, worst).res <= res)
+			return -ERROR_NO_ERROR;
+		// Evicts the label using the most resource
+		LABEL(search, worst).dead = TRUE;
+		search->count[v]--;
+		for (link = &search->head[v]; *link != worst;)
+			link = &LABEL(search, *link).next;
+		*link = LABEL(search, worst).next;
+	}
+
+	const unsigned length =
+		pred == NO_LABEL ? 1 : LABEL(search, pred).length + 1;
+	rcsp_label_t label = {cost, res, v, length, pred, search->head[v], FALSE};
+	if (dynarray_push_back(search->pool, &label) == NULL)
+		return -ERROR_ALLOCATION_FAILED;
+	const unsigned index = search->pool->size - 1;
+	search->head[v] = index;
+	search->count[v]++;
+	return queue_push(search, index);
+}
+
+/**
+ * Settles the labels by increasing cost, returns the first label of dst or
+ * NO_LABEL
+ */
+static unsigned settle(rcsp_search_t* search, unsigned dst, int* error) {
+	const graph_csr_t* g = search->g;
+	while (search->queue->size > 0) {
+		const unsigned index = queue_pop(search);
+		const rcsp_label_t label = LABEL(search, index);
+		if (label.dead)
+			continue;
+		if (label.vertex == dst)
+			return index;
+		// A longer path goes twice through a vertex
+		if (label.length == g->nb_vert)
+			continue;
+		const unsigned v = label.vertex;
+		for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+			const unsigned to = g->to[i];
+			const graph_weight_t res =
+				weight_add_truncate_overflow(label.res, search->resource[i]);
+			if (search->lower_bound[to] == GRAPH_WEIGHT_INF ||
+				weight_add_truncate_overflow(res, search->lower_bound[to]) >
+					search->budget)
+				continue;
+			const graph_weight_t w = g->weights != NULL ? g->weights[i] : 1;
+			*error = add_label(search, to,
+							   weight_add_truncate_overflow(label.cost, w),
+							   res, index);
+			if (*error < 0)
+				return NO_LABEL;
+		}
+	}
+	return NO_LABEL;
+}
+
+int graph_csr_rcsp(const graph_csr_t* g,
+				   const graph_weight_t* resource,
+				   unsigned src,
+				   unsigned dst,
+				   graph_weight_t budget,
+				   unsigned max_labels,
+				   unsigned* path,
+				   graph_weight_t* cost,
+				   graph_weight_t* used) {
+	when_null_ret(g, -ERROR_INVALID_PARAM1);
+	when_null_ret(resource, -ERROR_INVALID_PARAM2);
+	when_false_ret(src < g->nb_vert, -ERROR_INVALID_PARAM3);
+	when_false_ret(dst < g->nb_vert, -ERROR_INVALID_PARAM4);
+	when_null_ret(path, -ERROR_INVALID_PARAM7);
+
+	const unsigned n = g->nb_vert;
+	rcsp_search_t search = {.g = g,
+							.resource = resource,
+							.budget = budget,
+							.max_labels = max_labels};
+	search.lower_bound = malloc(n * sizeof(graph_weight_t));
+	search.pool = create_dynarray(sizeof(rcsp_label_t));
+	search.queue = create_dynarray(sizeof(unsigned));
+	search.head = malloc(n * sizeof(unsigned));
+	search.count = calloc(n, sizeof(unsigned));
+	int ret = -ERROR_ALLOCATION_FAILED;
+	if (search.lower_bound == NULL || search.pool == NULL ||
+		search.queue == NULL || search.head == NULL || search.count == NULL)
+		goto end;
+	ret = resource_lower_bound(&search, dst);
+	if (ret < 0)
+		goto end;
+	if (search.lower_bound[src] > budget)
+		goto end;
+
+	for (unsigned v = 0; v < n; v++)
+		search.head[v] = NO_LABEL;
+	ret = add_label(&search, src, 0, 0, NO_LABEL);
+	if (ret < 0)
+		goto end;
+	const unsigned found = settle(&search, dst, &ret);
+	if (ret < 0 || found == NO_LABEL)
+		goto end;
+
+	const rcsp_label_t* label = &LABEL(&search, found);
+	if (cost != NULL)
+		*cost = label->cost;
+	if (used != NULL)
+		*used = label->res;
+	ret = label->length;
+	for (unsigned i = label->length; i > 0; i--) {
+		path[i - 1] = label->vertex;
+		if (label->pred != NO_LABEL)
+			label = &LABEL(&search, label->pred);
+	}
+end:
+	free(search.lower_bound);
+	free_dynarray(search.pool);
+	free_dynarray(search.queue);
+	free(search.head);
+	free(search.count);
+	return ret;
+}
@@ -0,0 +1,339 @@
+#include "graph/graph_snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include "errors.h"
+#include "heap_view.h"
+#include "test_macros.h"
+
+/** Distance in uint64_t between two reader slots, one cache line */
+#define SLOT_STRIDE 8
+
+#define NB_PAGES(n) \
+	(((n) + GRAPH_SNAPSHOT_PAGE_SIZE - 1) / GRAPH_SNAPSHOT_PAGE_SIZE)
+
+static graph_snapshot_edges_t* create_edges(unsigned nb_edges) {
+	graph_snapshot_edges_t* edges = malloc(
+		sizeof(graph_snapshot_edges_t) + nb_edges * sizeof(graph_list_edge_t));
+	when_null_ret(edges, NULL);
+	edges->refcount = 1;
+	edges->nb_edges = nb_edges;
+	return edges;
+}
+
+static void release_edges(graph_snapshot_edges_t* edges) {
+	if (edges != NULL && --edges->refcount == 0)
+		free(edges);
+}
+
+static void release_page(graph_snapshot_page_t* page) {
+	if (page == NULL || --page->refcount > 0)
+		return;
+	for (unsigned i = 0; i < GRAPH_SNAPSHOT_PAGE_SIZE; i++)
+		release_edges(page->adj[i]);
+	free(page);
+}
+
+static void free_snapshot(graph_snapshot_t* s) {
+	if (s == NULL)
+		return;
+	if (s->pages != NULL) {
+		for (unsigned i = 0; i < NB_PAGES(s->nb_vert); i++)
+			release_page(s->pages[i]);
+	}
+	free(s->pages);
+	free(s);
+}
+
+static graph_snapshot_t* create_snapshot(unsigned nb_vert,
+										 BOOL is_weighted,
+										 unsigned version) {
+	graph_snapshot_t* s = calloc(1, sizeof(graph_snapshot_t));
+	when_null_ret(s, NULL);
+	s->nb_vert = nb_vert;
+	s->is_weighted = is_weighted;
+	s->version = version;
+	s->pages = calloc(NB_PAGES(nb_vert), sizeof(graph_snapshot_page_t*));
+	if (s->pages == NULL) {
+		free(s);
+		return NULL;
+	}
+	return s;
+}
+
+graph_versioned_t* create_graph_versioned(graph_list_t* g,
+										  unsigned nb_readers) {
+	graph_versioned_t* ret;
+	when_null_ret(g, NULL);
+	when_true_ret(nb_readers == 0, NULL);
+	graph_versioned_t* gv = calloc(1, sizeof(graph_versioned_t));
+	when_null_ret(gv, NULL);
+	gv->epoch = 1;
+	gv->nb_readers = nb_readers;
+	gv->slots = calloc((size_t)nb_readers * SLOT_STRIDE, sizeof(uint64_t));
+	gv->current = create_snapshot(g->nb_vert, g->is_weighted, 0);
+	when_true_jmp(gv->slots == NULL || gv->current == NULL, NULL, error);
+
+	for (unsigned p = 0; p < NB_PAGES(g->nb_vert); p++) {
+		graph_snapshot_page_t* page = calloc(1, sizeof(graph_snapshot_page_t));
+		when_null_jmp(page, NULL, error);
+		page->refcount = 1;
+		gv->current->pages[p] = page;
+		for (unsigned i = 0; i < GRAPH_SNAPSHOT_PAGE_SIZE; i++) {
+			const unsigned v = p * GRAPH_SNAPSHOT_PAGE_SIZE + i;
+			if (v >= g->nb_vert)
+				break;
+			list_ref_t* list = &g->neighbours[v];
+			unsigned count = 0;
+			foreach_node_node(list, node) {
+				count++;
+			}
+			if (count == 0)
+				continue;
+			page->adj[i] = create_edges(count);
+			when_null_jmp(page->adj[i], NULL, error);
+			count = 0;
+			foreach_node(list, e, graph_list_edge_t) {
+				page->adj[i]->edges[count++] = *e;
+			}
+		}
+	}
+	return gv;
+error:
+	free_graph_versioned(gv);
+	return ret;
+}
+
+void free_graph_versioned(graph_versioned_t* gv) {
+	if (gv == NULL)
+		return;
+	while (gv->retired != NULL) {
+		graph_snapshot_t* next = gv->retired->next_retired;
+		free_snapshot(gv->retired);
+		gv->retired = next;
+	}
+	free_snapshot(gv->pending);
+	free_snapshot(gv->current);
+	free(gv->slots);
+	free(gv);
+}
+
+/**
+ * Returns the pending version, created as a copy of the page table of the
+ * current version if there is none
+ */
+static graph_snapshot_t* get_pending(graph_versioned_t* gv) {
+	if (gv->pending != NULL)
+		return gv->pending;
+	const graph_snapshot_t* current = gv->current;
+	graph_snapshot_t* s = create_snapshot(
+		current->nb_vert, current->is_weighted, current->version + 1);
+	when_null_ret(s, NULL);
+	for (unsigned p = 0; p < NB_PAGES(s->nb_vert); p++) {
+		s->pages[p] = current->pages[p];
+		s->pages[p]->refcount++;
+	}
+	gv->pending = s;
+	return s;
+}
+
+/**
+ * Returns the page of v in the pending version, copied if it is shared with
+ * older versions
+ */
+static graph_snapshot_page_t* get_private_page(graph_snapshot_t* s,
+											   unsigned v) {
+	graph_snapshot_page_t** page = &s->pages[v / GRAPH_SNAPSHOT_PAGE_SIZE];
+	if ((*page)->version == s->version)
+		return *page;
+	graph_snapshot_page_t* copy = malloc(sizeof(graph_snapshot_page_t));
+	when_null_ret(copy, NULL);
+	memcpy(copy, *page, sizeof(graph_snapshot_page_t));
+	copy->refcount = 1;
+	copy->version = s->version;
+	for (unsigned i = 0; i < GRAPH_SNAPSHOT_PAGE_SIZE; i++) {
+		if (copy->adj[i] != NULL)
+			copy->adj[i]->refcount++;
+	}
+	release_page(*page);
+	*page = copy;
+	return copy;
+}
+
+static int set_edge(graph_snapshot_t* s,
+					unsigned a,
+					unsigned b,
+					BOOL val,
+					graph_weight_t weight) {
+	const graph_snapshot_edges_t* old = graph_snapshot_edges(s, a);
+	const unsigned count = old != NULL ? old->nb_edges : 0;
+	unsigned found = count;
+	for (unsigned i = 0; i < count; i++) {
+		if (old->edges[i].to == b) {
+			found = i;
+			break;
+		}
+	}
+	if (found == count && !val)
+		return -ERROR_NO_ERROR;
+	if (found < count && val && old->edges[found].w == weight)
+		return -ERROR_NO_ERROR;
+
+	graph_snapshot_page_t* page = get_private_page(s, a);
+	when_null_ret(page, -ERROR_ALLOCATION_FAILED);
+	const unsigned new_count = count + (found == count) - !val;
+	graph_snapshot_edges_t* edges = NULL;
+	if (new_count > 0) {
+		edges = create_edges(new_count);
+		when_null_ret(edges, -ERROR_ALLOCATION_FAILED);
+		// Copies the edges without the removed one
+		unsigned j = 0;
+		for (unsigned i = 0; i < count; i++) {
+			if (i != found || val)
+				edges->edges[j++] = old->edges[i];
+		}
+		if (found < count && val)
+			edges->edges[found].w = weight;
+		else if (val)
+			edges->edges[j] = (graph_list_edge_t){weight, b};
+	}
+	graph_snapshot_edges_t** slot = &page->adj[a % GRAPH_SNAPSHOT_PAGE_SIZE];
+	release_edges(*slot);
+	*slot = edges;
+	return -ERROR_NO_ERROR;
+}
+
+int graph_versioned_set_edge(graph_versioned_t* gv,
+							 unsigned a,
+							 unsigned b,
+							 BOOL val,
+							 graph_weight_t weight,
+							 BOOL reverse) {
+	when_null_ret(gv, -ERROR_INVALID_PARAM1);
+	when_false_ret(a < gv->current->nb_vert, -ERROR_INVALID_PARAM2);
+	when_false_ret(b < gv->current->nb_vert, -ERROR_INVALID_PARAM3);
+	graph_snapshot_t* s = get_pending(gv);
+	when_null_ret(s, -ERROR_ALLOCATION_FAILED);
+	if (s->is_weighted == FALSE)
+		weight = 1;
+	const int error = set_edge(s, a, b, val, weight);
+	if (error < 0 || !reverse)
+		return error;
+	return set_edge(s, b, a, val, weight);
+}
+
+/**
+ * Frees the retired versions which were replaced before the oldest epoch
+ * announced by a reader
+ */
+static void reclaim(graph_versioned_t* gv) {
+	uint64_t oldest = UINT64_MAX;
+	for (unsigned i = 0; i < gv->nb_readers; i++) {
+		const uint64_t e =
+			__atomic_load_n(&gv->slots[i * SLOT_STRIDE], __ATOMIC_SEQ_CST);
+		if (e != 0 && e < oldest)
+			oldest = e;
+	}
+	graph_snapshot_t** s = &gv->retired;
+	while (*s != NULL) {
+		if ((*s)->retire_epoch <= oldest) {
+			graph_snapshot_t* next = (*s)->next_retired;
+			free_snapshot(*s);
+			*s = next;
+		} else
+			s = &(*s)->next_retired;
+	}
+}
+
+int graph_versioned_publish(graph_versioned_t* gv) {
+	when_null_ret(gv, -ERROR_INVALID_PARAM1);
+	if (gv->pending != NULL) {
+		graph_snapshot_t* old = gv->current;
+		__atomic_store_n(&gv->current, gv->pending, __ATOMIC_SEQ_CST);
+		gv->pending = NULL;
+		// A reader announcing an older epoch may have loaded old
+		old->retire_epoch =
+			__atomic_add_fetch(&gv->epoch, 1, __ATOMIC_SEQ_CST);
+		old->next_retired = gv->retired;
+		gv->retired = old;
+	}
+	reclaim(gv);
+	return gv->current->version;
+}
+
+unsigned graph_versioned_nb_retired(const graph_versioned_t* gv) {
+	unsigned count = 0;
+	for (const graph_snapshot_t* s = gv->retired; s != NULL;
+		 s = s->next_retired)
+		count++;
+	return count;
+}
+
+const graph_snapshot_t* graph_versioned_acquire(graph_versioned_t* gv,
+												unsigned reader) {
+	uint64_t* slot = &gv->slots[reader * SLOT_STRIDE];
+	const uint64_t epoch = __atomic_load_n(&gv->epoch, __ATOMIC_SEQ_CST);
+	__atomic_store_n(slot, epoch, __ATOMIC_SEQ_CST);
+	return __atomic_load_n(&gv->current, __ATOMIC_SEQ_CST);
+}
+
+void graph_versioned_release(graph_versioned_t* gv, unsigned reader) {
+	__atomic_store_n(&gv->slots[reader * SLOT_STRIDE], 0, __ATOMIC_RELEASE);
+}
+
+const graph_list_edge_t* graph_snapshot_get_edge(const graph_snapshot_t* s,
+												 unsigned a,
+												 unsigned b) {
+	const graph_snapshot_edges_t* edges = graph_snapshot_edges(s, a);
+	if (edges == NULL)
+		return NULL;
+	for (unsigned i = 0; i < edges->nb_edges; i++) {
+		if (edges->edges[i].to == b)
+			return &edges->edges[i];
+	}
+	return NULL;
+}
+
+int graph_snapshot_dijkstra_ws(const graph_snapshot_t* s,
+							   unsigned r,
+							   graph_weight_t* distance,
+							   int* father,
+							   graph_sp_workspace_t* ws) {
+	when_null_ret(s, -ERROR_INVALID_PARAM1);
+	when_false_ret(r < s->nb_vert, -ERROR_INVALID_PARAM2);
+	when_null_ret(distance, -ERROR_INVALID_PARAM3);
+	when_null_ret(ws, -ERROR_INVALID_PARAM5);
+	when_false_ret(s->nb_vert <= ws->nb_vert, -ERROR_INVALID_PARAM5);
+	for (unsigned i = 0; i < s->nb_vert; i++) {
+		distance[i] = GRAPH_WEIGHT_INF;
+		if (father != NULL)
+			father[i] = -1;
+	}
+	distance[r] = 0;
+	graph_sp_workspace_reset(ws);
+	heap_view_t* heap = graph_sp_workspace_heap(ws, s->nb_vert, r, distance);
+
+	unsigned number = 0;
+	int pivot;
+	while ((pivot = weight_heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		if (distance[pivot] == GRAPH_WEIGHT_INF)
+			break;
+		graph_sp_workspace_set_mark(ws, pivot, TRUE);
+		number++;
+		const graph_snapshot_edges_t* edges = graph_snapshot_edges(s, pivot);
+		if (edges == NULL)
+			continue;
+		for (unsigned i = 0; i < edges->nb_edges; i++) {
+			const graph_list_edge_t* e = &edges->edges[i];
+			if (graph_sp_workspace_get_mark(ws, e->to))
+				continue;
+			graph_weight_t d =
+				weight_add_truncate_overflow(distance[pivot], e->w);
+			if (d < distance[e->to]) {
+				weight_heap_update_up(heap, e->to, d);
+				if (father != NULL)
+					father[e->to] = pivot;
+			}
+		}
+	}
+	return number;
+}
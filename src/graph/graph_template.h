@@ -0,0 +1,176 @@
+#ifndef GRAPH_TEMPLATE_H
+#define GRAPH_TEMPLATE_H
+
+#include <stdlib.h>
+#include "errors.h"
+#include "list_ref/list_ref.h"
+#include "structures.h"
+#include "test_macros.h"
+
+/*
+ * Private templates of the graph structures, instantiated for graph_list_t and
+ * graph_mat_t with graph_weight_t and for each weight type of
+ * graph/graph_typed.h. The structure is name##_t, the edges of a list being
+ * name##_edge_t, so that graph_list gives create_graph_list(),
+ * graph_list_set_edge()... and graph_list_f64 gives create_graph_list_f64(),
+ * graph_list_f64_set_edge()...
+ */
+
+#ifdef STRUCT_RECURSIVE_IMPL
+#define DEFINE_GRAPH_LIST_FIND_EDGE(name)                               \
+	static node_list_ref_t* name##_find_edge_rec(node_list_ref_t* node, \
+												 unsigned b) {          \
+		if (node == NULL)                                               \
+			return NULL;                                                \
+		name##_edge_t* e = node->p;                                     \
+		if (e->to == b)                                                 \
+			return node;                                                \
+		return name##_find_edge_rec(node->next, b);                     \
+	}                                                                   \
+                                                                        \
+	static node_list_ref_t* name##_find_edge(name##_t* g, unsigned a,   \
+											 unsigned b) {              \
+		return name##_find_edge_rec(g->neighbours[a].begin, b);         \
+	}
+#else
+#define DEFINE_GRAPH_LIST_FIND_EDGE(name)                             \
+	static node_list_ref_t* name##_find_edge(name##_t* g, unsigned a, \
+											 unsigned b) {            \
+		node_list_ref_t* node = g->neighbours[a].begin;               \
+		while (node) {                                                \
+			name##_edge_t* e = node->p;                               \
+			if (e->to == b)                                           \
+				return node;                                          \
+			node = node->next;                                        \
+		}                                                             \
+		return NULL;                                                  \
+	}
+#endif
+
+/**
+ * Defines create_##name(), free_##name(), name##_get_edge() and
+ * name##_set_edge() for a graph_list_t like structure whose weights are of
+ * the given type, and name##_push_edge() adding an edge without checking if
+ * it already exists
+ */
+#define DEFINE_GRAPH_LIST_BASE(name, type)                                \
+	name##_t* create_##name(unsigned size, BOOL is_weighted) {            \
+		name##_t* ret;                                                    \
+		when_true_ret(size == 0, NULL);                                   \
+                                                                          \
+		name##_t* g = malloc(sizeof(name##_t));                           \
+		when_null_ret(g, NULL);                                           \
+                                                                          \
+		g->nb_vert = size;                                                \
+		g->neighbours = malloc(size * sizeof(list_ref_t));                \
+		when_null_jmp(g->neighbours, NULL, error);                        \
+		g->is_weighted = is_weighted;                                     \
+                                                                          \
+		for (unsigned i = 0; i < size; i++) {                             \
+			g->neighbours[i].begin = NULL;                                \
+			g->neighbours[i].end = NULL;                                  \
+			g->neighbours[i].size = sizeof(name##_edge_t);                \
+			g->neighbours[i].free_element = free;                         \
+		}                                                                 \
+                                                                          \
+		return g;                                                         \
+	error:                                                                \
+		free(g);                                                          \
+		return ret;                                                       \
+	}                                                                     \
+                                                                          \
+	void free_##name(name##_t* g) {                                       \
+		if (g) {                                                          \
+			for (unsigned i = 0; i < g->nb_vert; i++)                     \
+				clean_list(&g->neighbours[i]);                            \
+			free(g->neighbours);                                          \
+			free(g);                                                      \
+		}                                                                 \
+	}                                                                     \
+                                                                          \
+	static int name##_push_edge(name##_t* g, unsigned a, unsigned b,      \
+								type weight) {                            \
+		name##_edge_t* e = malloc(sizeof(name##_edge_t));                 \
+		when_null_ret(e, -ERROR_ALLOCATION_FAILED);                       \
+		*e = (name##_edge_t){weight, b};                                  \
+		push_back_list(&g->neighbours[a], e);                             \
+		return 0;                                                         \
+	}                                                                     \
+                                                                          \
+	DEFINE_GRAPH_LIST_FIND_EDGE(name)                                     \
+                                                                          \
+	name##_edge_t* name##_get_edge(name##_t* g, unsigned a, unsigned b) { \
+		node_list_ref_t* node = name##_find_edge(g, a, b);                \
+		return node == NULL ? NULL : node->p;                             \
+	}                                                                     \
+                                                                          \
+	void name##_set_edge(name##_t* g, unsigned a, unsigned b, BOOL val,   \
+						 type weight, BOOL reverse) {                     \
+		if (g->is_weighted == FALSE)                                      \
+			weight = 1;                                                   \
+		node_list_ref_t* node = name##_find_edge(g, a, b);                \
+		if (node && !val)                                                 \
+			remove_list(&g->neighbours[a], node, NULL);                   \
+		if (node && val)                                                  \
+			((name##_edge_t*)node->p)->w = weight;                        \
+		if (!node && val)                                                 \
+			name##_push_edge(g, a, b, weight);                            \
+		if (reverse)                                                      \
+			name##_set_edge(g, b, a, val, weight, FALSE);                 \
+	}
+
+/**
+ * Defines create_##name(), free_##name(), name##_set_edge(),
+ * name##_get_edge() and name##_get_weight() for a graph_mat_t like structure
+ * whose weights are of the given type
+ */
+#define DEFINE_GRAPH_MAT_BASE(name, type)                               \
+	name##_t* create_##name(unsigned size, BOOL is_weighted) {          \
+		name##_t* ret;                                                  \
+		if (size == 0)                                                  \
+			return NULL;                                                \
+		name##_t* g = malloc(sizeof(name##_t));                         \
+		when_null_ret(g, NULL);                                         \
+		g->nb_vert = size;                                              \
+                                                                        \
+		g->edges = calloc((size_t)size * size, sizeof(BOOL));           \
+		when_null_jmp(g->edges, NULL, error);                           \
+		if (is_weighted) {                                              \
+			g->weights = calloc((size_t)size * size, sizeof(type));     \
+			when_null_jmp(g->weights, NULL, error2);                    \
+		} else                                                          \
+			g->weights = NULL;                                          \
+		return g;                                                       \
+	error2:                                                             \
+		free(g->edges);                                                 \
+	error:                                                              \
+		free(g);                                                        \
+		return ret;                                                     \
+	}                                                                   \
+                                                                        \
+	void free_##name(name##_t* g) {                                     \
+		if (g == NULL)                                                  \
+			return;                                                     \
+		free(g->edges);                                                 \
+		free(g->weights);                                               \
+		free(g);                                                        \
+	}                                                                   \
+                                                                        \
+	void name##_set_edge(name##_t* g, unsigned a, unsigned b, BOOL val, \
+						 type weight, BOOL reverse) {                   \
+		g->edges[(size_t)a * g->nb_vert + b] = val;                     \
+		if (g->weights)                                                 \
+			g->weights[(size_t)a * g->nb_vert + b] = weight;            \
+		if (reverse)                                                    \
+			name##_set_edge(g, b, a, val, weight, FALSE);               \
+	}                                                                   \
+                                                                        \
+	BOOL name##_get_edge(name##_t* g, unsigned a, unsigned b) {         \
+		return g->edges[(size_t)a * g->nb_vert + b];                    \
+	}                                                                   \
+                                                                        \
+	type name##_get_weight(name##_t* g, unsigned a, unsigned b) {       \
+		return g->weights ? g->weights[(size_t)a * g->nb_vert + b] : 1; \
+	}
+
+#endif	// !GRAPH_TEMPLATE_H
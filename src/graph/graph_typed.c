@@ -0,0 +1,316 @@
+#include "graph/graph_typed.h"
+#include <stdlib.h>
+#include "errors.h"
+#include "graph/graph_workspace.h"
+#include "graph_template.h"
+#include "heap_view.h"
+#include "test_macros.h"
+#include "workspace_wrap.h"
+
+/**
+ * Position in the successors of a vertex: the next node of its list or the
+ * next column of its row of the matrix
+ */
+typedef struct typed_cursor {
+	node_list_ref_t* node;
+	unsigned column;
+} typed_cursor_t;
+
+/**
+ * Iterates over the successors y of x and the weights w of the edges (x, y),
+ * rep being list or mat
+ */
+#define foreach_successor(rep, sfx, g, x, y, w)           \
+	for (typed_cursor_t cursor = rep##_first_##sfx(g, x); \
+		 rep##_next_##sfx(g, x, &cursor, &y, &w);)
+
+static BOOL test_if_edge_create_cycle(int* father, int a, int b) {
+	int current = a;
+	while (current != -1) {
+		if (current == b)
+			return TRUE;
+		current = father[current];
+	}
+	return FALSE;
+}
+
+#define TYPED_SSSP_INIT(sfx)                               \
+	when_null_ret(g, -ERROR_INVALID_PARAM1);               \
+	when_false_ret(r < g->nb_vert, -ERROR_INVALID_PARAM2); \
+	when_null_ret(distance, -ERROR_INVALID_PARAM3);        \
+	for (unsigned i = 0; i < g->nb_vert; i++)              \
+		distance[i] = GRAPH_WEIGHT_INF_##sfx;              \
+	if (father) {                                          \
+		for (unsigned i = 0; i < g->nb_vert; i++)          \
+			father[i] = -1;                                \
+	}                                                      \
+	distance[r] = 0;
+
+/**
+ * Cursors on the successors of a vertex for each representation
+ */
+#define DEFINE_TYPED_CURSORS(sfx, type)                                \
+	static typed_cursor_t list_first_##sfx(graph_list_##sfx##_t* g,    \
+										   unsigned x) {               \
+		return (typed_cursor_t){g->neighbours[x].begin, 0};            \
+	}                                                                  \
+                                                                       \
+	static BOOL list_next_##sfx(graph_list_##sfx##_t* g, unsigned x,   \
+								typed_cursor_t* cursor, unsigned* y,   \
+								type* w) {                             \
+		(void)g;                                                       \
+		(void)x;                                                       \
+		if (cursor->node == NULL)                                      \
+			return FALSE;                                              \
+		const graph_list_##sfx##_edge_t* e = cursor->node->p;          \
+		*y = e->to;                                                    \
+		*w = e->w;                                                     \
+		cursor->node = cursor->node->next;                             \
+		return TRUE;                                                   \
+	}                                                                  \
+                                                                       \
+	static typed_cursor_t mat_first_##sfx(graph_mat_##sfx##_t* g,      \
+										  unsigned x) {                \
+		(void)g;                                                       \
+		(void)x;                                                       \
+		return (typed_cursor_t){NULL, 0};                              \
+	}                                                                  \
+                                                                       \
+	static BOOL mat_next_##sfx(graph_mat_##sfx##_t* g, unsigned x,     \
+							   typed_cursor_t* cursor, unsigned* y,    \
+							   type* w) {                              \
+		unsigned j = cursor->column;                                   \
+		while (j < g->nb_vert && !graph_mat_##sfx##_get_edge(g, x, j)) \
+			j++;                                                       \
+		if (j == g->nb_vert)                                           \
+			return FALSE;                                              \
+		*y = j;                                                        \
+		*w = graph_mat_##sfx##_get_weight(g, x, j);                    \
+		cursor->column = j + 1;                                        \
+		return TRUE;                                                   \
+	}
+
+/**
+ * Shortest path algorithms written once on the cursors of a representation,
+ * rep being list or mat. A vertex at an infinite distance never relaxes its
+ * successors.
+ */
+#define DEFINE_TYPED_SHORTEST_PATHS(rep, sfx, type)                           \
+	/* Relaxes the edges from x, returns TRUE if a distance decreased */      \
+	static BOOL rep##_relax_##sfx(graph_##rep##_##sfx##_t* g, unsigned x,     \
+								  type* distance, int* father) {              \
+		BOOL changed = FALSE;                                                 \
+		unsigned y;                                                           \
+		type w;                                                               \
+		if (distance[x] == GRAPH_WEIGHT_INF_##sfx)                            \
+			return FALSE;                                                     \
+		foreach_successor(rep, sfx, g, x, y, w) {                             \
+			const type d = weight_add_saturate_##sfx(distance[x], w);         \
+			if (d < distance[y]) {                                            \
+				changed = TRUE;                                               \
+				distance[y] = d;                                              \
+				if (father != NULL)                                           \
+					father[y] = x;                                            \
+			}                                                                 \
+		}                                                                     \
+		return changed;                                                       \
+	}                                                                         \
+                                                                              \
+	/* Kahn's algorithm on the degree and waiting list of the workspace */    \
+	static int rep##_topological_ordering_##sfx(graph_##rep##_##sfx##_t* g,   \
+												unsigned* num,                \
+												unsigned* denum,              \
+												graph_sp_workspace_t* ws) {   \
+		unsigned* degree = ws->degree;                                        \
+		circular_buffer_t* stack = ws->waiting_list;                          \
+		unsigned y;                                                           \
+		type w;                                                               \
+		for (unsigned i = 0; i < g->nb_vert; i++)                             \
+			degree[i] = 0;                                                    \
+		for (unsigned x = 0; x < g->nb_vert; x++) {                           \
+			foreach_successor(rep, sfx, g, x, y, w) degree[y]++;              \
+		}                                                                     \
+		for (unsigned i = 0; i < g->nb_vert; i++) {                           \
+			if (degree[i] == 0)                                               \
+				circular_buffer_push_front(stack, &i);                        \
+		}                                                                     \
+		unsigned number = 0;                                                  \
+		while (circular_buffer_size(stack) != 0) {                            \
+			unsigned x;                                                       \
+			circular_buffer_pop_front(stack, &x);                             \
+			num[x] = number;                                                  \
+			denum[number++] = x;                                              \
+			foreach_successor(rep, sfx, g, x, y, w) {                         \
+				if (--degree[y] == 0)                                         \
+					circular_buffer_push_front(stack, &y);                    \
+			}                                                                 \
+		}                                                                     \
+		if (number != g->nb_vert)                                             \
+			return -ERROR_GRAPH_SHOULDBE_DAG;                                 \
+		return -ERROR_NO_ERROR;                                               \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_dijkstra_ws_##sfx(graph_##rep##_##sfx##_t* g,           \
+										unsigned r, type* distance,           \
+										int* father,                          \
+										graph_sp_workspace_t* ws) {           \
+		TYPED_SSSP_INIT(sfx)                                                  \
+		WORKSPACE_CHECK(5)                                                    \
+		graph_sp_workspace_reset(ws);                                         \
+                                                                              \
+		heap_view_t* heap =                                                   \
+			graph_sp_workspace_heap(ws, g->nb_vert, r, distance);             \
+		unsigned number = 0;                                                  \
+		int pivot;                                                            \
+		while ((pivot = weight_heap_##sfx##_get_root(heap)) !=                \
+			   -ERROR_IS_EMPTY) {                                             \
+			if (distance[pivot] == GRAPH_WEIGHT_INF_##sfx)                    \
+				break;                                                        \
+			graph_sp_workspace_set_mark(ws, pivot, TRUE);                     \
+			number++;                                                         \
+			unsigned y;                                                       \
+			type w;                                                           \
+			foreach_successor(rep, sfx, g, pivot, y, w) {                     \
+				if (graph_sp_workspace_get_mark(ws, y))                       \
+					continue;                                                 \
+				const type d = weight_add_saturate_##sfx(distance[pivot], w); \
+				if (d < distance[y]) {                                        \
+					weight_heap_##sfx##_update_up(heap, y, d);                \
+					if (father != NULL)                                       \
+						father[y] = pivot;                                    \
+				}                                                             \
+			}                                                                 \
+		}                                                                     \
+		return number;                                                        \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_dijkstra_##sfx(graph_##rep##_##sfx##_t* g, unsigned r,  \
+									 type* distance, int* father) {           \
+		WITH_WORKSPACE(-ERROR_INVALID_PARAM2,                                 \
+					   graph_##rep##_dijkstra_ws_##sfx(g, r, distance,        \
+													   father, ws))           \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_bellman_ws_##sfx(graph_##rep##_##sfx##_t* g,            \
+									   unsigned r, type* distance,            \
+									   int* father,                           \
+									   graph_sp_workspace_t* ws) {            \
+		TYPED_SSSP_INIT(sfx)                                                  \
+		WORKSPACE_CHECK(5)                                                    \
+		graph_sp_workspace_reset(ws);                                         \
+                                                                              \
+		unsigned* num = ws->num;                                              \
+		unsigned* denum = num + g->nb_vert;                                   \
+		int ret = rep##_topological_ordering_##sfx(g, num, denum, ws);        \
+		if (ret != -ERROR_NO_ERROR)                                           \
+			return ret;                                                       \
+		for (unsigned i = num[r]; i < g->nb_vert; i++)                        \
+			rep##_relax_##sfx(g, denum[i], distance, father);                 \
+		return ret;                                                           \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_bellman_##sfx(graph_##rep##_##sfx##_t* g, unsigned r,   \
+									type* distance, int* father) {            \
+		WITH_WORKSPACE(-ERROR_INVALID_PARAM2,                                 \
+					   graph_##rep##_bellman_ws_##sfx(g, r, distance,         \
+													  father, ws))            \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_ford_##sfx(graph_##rep##_##sfx##_t* g, unsigned r,      \
+								 type* distance, int* father) {               \
+		TYPED_SSSP_INIT(sfx)                                                  \
+		BOOL changed;                                                         \
+		unsigned k = 0;                                                       \
+		do {                                                                  \
+			changed = FALSE;                                                  \
+			k++;                                                              \
+			for (unsigned x = 0; x < g->nb_vert; x++)                         \
+				changed |= rep##_relax_##sfx(g, x, distance, father);         \
+		} while (k != g->nb_vert && changed == TRUE);                         \
+		if (changed == TRUE)                                                  \
+			return -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT;                        \
+		return -ERROR_NO_ERROR;                                               \
+	}                                                                         \
+                                                                              \
+	/* Finds an edge (x, y) decreasing the distance of y to d */              \
+	static BOOL rep##_find_shortcut_##sfx(graph_##rep##_##sfx##_t* g,         \
+										  const type* distance, unsigned* x,  \
+										  unsigned* y, type* d) {             \
+		unsigned j;                                                           \
+		type w;                                                               \
+		for (unsigned i = 0; i < g->nb_vert; i++) {                           \
+			if (distance[i] == GRAPH_WEIGHT_INF_##sfx)                        \
+				continue;                                                     \
+			foreach_successor(rep, sfx, g, i, j, w) {                         \
+				const type dj = weight_add_saturate_##sfx(distance[i], w);    \
+				if (dj < distance[j]) {                                       \
+					*x = i;                                                   \
+					*y = j;                                                   \
+					*d = dj;                                                  \
+					return TRUE;                                              \
+				}                                                             \
+			}                                                                 \
+		}                                                                     \
+		return FALSE;                                                         \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_ford_dantzig_ws_##sfx(graph_##rep##_##sfx##_t* g,       \
+											unsigned r, type* distance,       \
+											int* father, int* cycle,          \
+											graph_sp_workspace_t* ws) {       \
+		when_null_ret(father, -ERROR_INVALID_PARAM4);                         \
+		WORKSPACE_CHECK(6)                                                    \
+		int ret =                                                             \
+			graph_##rep##_dijkstra_ws_##sfx(g, r, distance, father, ws);      \
+		when_false_ret(ret >= 0, ret);                                        \
+		circular_buffer_t* update_queue = ws->waiting_list;                   \
+                                                                              \
+		unsigned x, y;                                                        \
+		type d, w;                                                            \
+		while (rep##_find_shortcut_##sfx(g, distance, &x, &y, &d)) {          \
+			distance[y] = d;                                                  \
+			father[y] = x;                                                    \
+			if (test_if_edge_create_cycle(father, x, y) == TRUE) {            \
+				*cycle = x;                                                   \
+				return -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT;                    \
+			}                                                                 \
+			/* Updates the descendants of y in the shortest path tree */      \
+			circular_buffer_push_back(update_queue, &y);                      \
+			do {                                                              \
+				circular_buffer_pop_front(update_queue, &x);                  \
+				foreach_successor(rep, sfx, g, x, y, w) {                     \
+					if (father[y] != (int)x)                                  \
+						continue;                                             \
+					distance[y] = weight_add_saturate_##sfx(distance[x], w);  \
+					circular_buffer_push_back(update_queue, &y);              \
+				}                                                             \
+			} while (circular_buffer_size(update_queue) != 0);                \
+		}                                                                     \
+		return ret;                                                           \
+	}                                                                         \
+                                                                              \
+	int graph_##rep##_ford_dantzig_##sfx(graph_##rep##_##sfx##_t* g,          \
+										 unsigned r, type* distance,          \
+										 int* father, int* cycle) {           \
+		WITH_WORKSPACE(-ERROR_INVALID_PARAM2,                                 \
+					   graph_##rep##_ford_dantzig_ws_##sfx(                   \
+						   g, r, distance, father, cycle, ws))                \
+	}
+
+/**
+ * The structures come from the templates of graph_list_t and graph_mat_t,
+ * the heap of the workspace being used on the typed distances through
+ * weight_heap_<sfx>
+ */
+#define DEFINE_GRAPH_TYPED(sfx, type)                \
+	DEFINE_HEAP_VIEW(weight_heap_##sfx, type, a < b) \
+	DEFINE_GRAPH_LIST_BASE(graph_list_##sfx, type)   \
+	DEFINE_GRAPH_MAT_BASE(graph_mat_##sfx, type)     \
+	DEFINE_TYPED_CURSORS(sfx, type)                  \
+	DEFINE_TYPED_SHORTEST_PATHS(list, sfx, type)     \
+	DEFINE_TYPED_SHORTEST_PATHS(mat, sfx, type)
+
+DEFINE_GRAPH_TYPED(i32, int32_t)
+DEFINE_GRAPH_TYPED(i64, int64_t)
+DEFINE_GRAPH_TYPED(f32, float)
+DEFINE_GRAPH_TYPED(f64, double)
@@ -0,0 +1,83 @@
+#include "graph/graph_workspace.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compare.h"
+#include "test_macros.h"
+
+DEFINE_COMPARE_MIN_SCALAR(graph_weight_t)
+
+graph_sp_workspace_t* create_graph_sp_workspace(unsigned nb_vert) {
+	graph_sp_workspace_t* ret;
+	when_true_ret(nb_vert == 0, NULL);
+	graph_sp_workspace_t* ws = calloc(1, sizeof(graph_sp_workspace_t));
+	when_null_ret(ws, NULL);
+
+	ws->nb_vert = nb_vert;
+	ws->mark = calloc(nb_vert, sizeof(unsigned));
+	ws->stamp = 1;
+	ws->num = malloc(2 * nb_vert * sizeof(unsigned));
+	ws->degree = malloc(nb_vert * sizeof(unsigned));
+	ws->distance = malloc(nb_vert * sizeof(graph_weight_t));
+	when_true_jmp(ws->mark == NULL || ws->num == NULL || ws->degree == NULL ||
+					  ws->distance == NULL,
+				  NULL, error);
+	ws->heap = create_heap(nb_vert, sizeof(graph_weight_t), ws->distance,
+						   compare_min_graph_weight_t);
+	when_null_jmp(ws->heap, NULL, error);
+#ifdef DIJKSTRA_DARY_HEAP_ARITY
+	ws->dary_heap = create_dary_heap(nb_vert, DIJKSTRA_DARY_HEAP_ARITY);
+	when_null_jmp(ws->dary_heap, NULL, error);
+#endif
+	ws->waiting_list = create_circular_buffer(sizeof(int), nb_vert);
+	when_null_jmp(ws->waiting_list, NULL, error);
+	return ws;
+error:
+	free_graph_sp_workspace(ws);
+	return ret;
+}
+
+void free_graph_sp_workspace(graph_sp_workspace_t* ws) {
+	if (ws == NULL)
+		return;
+	free(ws->mark);
+	free(ws->num);
+	free(ws->degree);
+	free(ws->distance);
+	free_heap(ws->heap);
+	free_dary_heap(ws->dary_heap);
+	if (ws->waiting_list)
+		free_circular_buffer(ws->waiting_list);
+	free(ws);
+}
+
+void graph_sp_workspace_reset(graph_sp_workspace_t* ws) {
+	// The marks of the previous algorithm are at most stamp + 1
+	if (ws->stamp >= UINT_MAX - 3) {
+		memset(ws->mark, 0, ws->nb_vert * sizeof(unsigned));
+		ws->stamp = 1;
+	} else
+		ws->stamp += 2;
+	// An algorithm always empties its waiting list, except on failure
+	while (circular_buffer_size(ws->waiting_list) != 0)
+		circular_buffer_pop_back(ws->waiting_list, NULL);
+}
+
+heap_view_t* graph_sp_workspace_heap(graph_sp_workspace_t* ws,
+									 unsigned n,
+									 unsigned r,
+									 void* distance) {
+	heap_view_t* heap = ws->heap;
+	heap->data = distance;
+	heap->size = n;
+	for (unsigned i = 0; i < n; i++) {
+		heap->idx_to_pos[i] = i;
+		heap->pos_to_idx[i] = i;
+	}
+	// We put r at the root of (index, distance) which makes it a heap
+	heap->idx_to_pos[r] = 0;
+	heap->idx_to_pos[0] = r;
+	heap->pos_to_idx[r] = 0;
+	heap->pos_to_idx[0] = r;
+	return heap;
+}
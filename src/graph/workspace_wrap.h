@@ -0,0 +1,35 @@
+#ifndef GRAPH_WORKSPACE_WRAP_H
+#define GRAPH_WORKSPACE_WRAP_H
+
+#include "errors.h"
+#include "graph/graph_workspace.h"
+#include "test_macros.h"
+
+/*
+ * Private helpers of the graph implementations providing both a _ws function
+ * and a wrapper allocating its workspace. Both expect the graph to be named g.
+ */
+
+/**
+ * Calls a _ws function with a workspace created for the call. An empty graph
+ * has no workspace (create_graph_sp_workspace() fails) so empty_error is
+ * returned instead, the error the function returned before taking a
+ * workspace.
+ */
+#define WITH_WORKSPACE(empty_error, call)                             \
+	when_null_ret(g, -ERROR_INVALID_PARAM1);                          \
+	when_true_ret(g->nb_vert == 0, empty_error);                      \
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(g->nb_vert); \
+	when_null_ret(ws, -ERROR_ALLOCATION_FAILED);                      \
+	const int ret = call;                                             \
+	free_graph_sp_workspace(ws);                                      \
+	return ret;
+
+/**
+ * Checks that the workspace ws, the param-th parameter, fits the graph
+ */
+#define WORKSPACE_CHECK(param)                      \
+	when_null_ret(ws, -ERROR_INVALID_PARAM##param); \
+	when_false_ret(g->nb_vert <= ws->nb_vert, -ERROR_INVALID_PARAM##param);
+
+#endif	// !GRAPH_WORKSPACE_WRAP_H
@@ -61,7 +61,7 @@ static void pullup_heap(heap_view_t* heap, unsigned n) {
 	/* heap->data[n] = key; */
 }
 
-static unsigned pulldown_heap(heap_view_t* heap, unsigned n) {
+static void pulldown_heap(heap_view_t* heap, unsigned n) {
 	BOOL found = FALSE;
 	unsigned int idx = heap->pos_to_idx[n];
 	void* key = heap_get_ptr(heap, n);
@@ -97,17 +97,8 @@ static unsigned pulldown_heap(heap_view_t* heap, unsigned n) {
 	}
 	// We overwrite the last moved son with the original vertex
 	write_heap(heap, idx, n);
-	return heap->pos_to_idx[heap->size];
 }
 
-/*
-static void heap_sort(unsigned* index, long long*  val, unsigned size) {
-		for(int p=size-1; p>0; p--) {
-				swap(index, 0, p);
-				pulldown_heap(index, val, p, 0);
-		}
-} */
-
 static heap_view_t* create_heap_no_data(unsigned capacity,
 										size_t size_bytes,
 										compare_fn_t compare) {
@@ -171,6 +162,28 @@ heap_view_t* create_heap_no_check(unsigned size,
 	return ret;
 }
 
+/**
+ * Floyd's bottom-up construction: the subtrees are made heaps from the last
+ * father up to the root
+ */
+static void heapify(heap_view_t* heap) {
+	for (unsigned n = heap->size / 2; n > 0; n--)
+		pulldown_heap(heap, n - 1);
+}
+
+heap_view_t* create_heap_heapify(unsigned capacity,
+								 unsigned size,
+								 size_t size_bytes,
+								 void* data,
+								 compare_fn_t compare) {
+	when_false_ret(size <= capacity, NULL);
+	heap_view_t* heap = create_heap(capacity, size_bytes, data, compare);
+	when_null_ret(heap, NULL);
+	heap->size = size;
+	heapify(heap);
+	return heap;
+}
+
 int heap_get_root(heap_view_t* heap) {
 	if (heap->size == 0)
 		return -ERROR_IS_EMPTY;
@@ -181,7 +194,8 @@ int heap_get_root(heap_view_t* heap) {
 
 	swap_heap(heap, 0, heap->size - 1);
 	heap->size--;
-	return pulldown_heap(heap, 0);
+	pulldown_heap(heap, 0);
+	return heap->pos_to_idx[heap->size];
 }
 
 static void copy_elem(heap_view_t* heap, unsigned int idx, void* elem) {
@@ -192,17 +206,73 @@ static void copy_elem(heap_view_t* heap, unsigned int idx, void* elem) {
 int insert_heap(heap_view_t* heap, void* elem) {
 	when_false_ret(heap->size < heap->capacity, -ERROR_CAPACITY_EXCEEDED);
 
-	copy_elem(heap, heap->size, elem);
+	// The first free index, which is heap->size if no element left the heap
+	copy_elem(heap, heap->pos_to_idx[heap->size], elem);
 	pullup_heap(heap, heap->size);
 
 	return ++heap->size;
 }
 
+int heap_insert_many(heap_view_t* heap, void* elems, unsigned count) {
+	when_false_ret(count <= heap->capacity - heap->size,
+				   -ERROR_CAPACITY_EXCEEDED);
+
+	for (unsigned i = 0; i < count; i++) {
+		copy_elem(heap, heap->pos_to_idx[heap->size + i],
+				  (char*)elems + i * heap->size_bytes);
+	}
+	if (count >= heap->size) {
+		// Rebuilding the heap in O(size + count) beats count insertions
+		heap->size += count;
+		heapify(heap);
+	} else {
+		for (unsigned i = 0; i < count; i++)
+			pullup_heap(heap, heap->size++);
+	}
+	return heap->size;
+}
+
 void heap_update_up(heap_view_t* heap, unsigned int idx, void* elem) {
 	copy_elem(heap, idx, elem);
 	pullup_heap(heap, heap->idx_to_pos[idx]);
 }
 
+void heap_update_down(heap_view_t* heap, unsigned int idx, void* elem) {
+	copy_elem(heap, idx, elem);
+	pulldown_heap(heap, heap->idx_to_pos[idx]);
+}
+
+void heap_update(heap_view_t* heap, unsigned int idx, void* elem) {
+	const BOOL up =
+		heap->compare(elem, (char*)heap->data + idx * heap->size_bytes) == 1;
+	copy_elem(heap, idx, elem);
+	if (up)
+		pullup_heap(heap, heap->idx_to_pos[idx]);
+	else
+		pulldown_heap(heap, heap->idx_to_pos[idx]);
+}
+
+int heap_remove(heap_view_t* heap, unsigned int idx) {
+	when_false_ret(heap_contains(heap, idx), -ERROR_INVALID_PARAM2);
+
+	const unsigned pos = heap->idx_to_pos[idx];
+	swap_heap(heap, pos, heap->size - 1);
+	heap->size--;
+	if (pos < heap->size) {
+		// The last element replaces idx and can go either way
+		const unsigned moved = heap->pos_to_idx[pos];
+		pullup_heap(heap, pos);
+		pulldown_heap(heap, heap->idx_to_pos[moved]);
+	}
+	return idx;
+}
+
+int heap_peek(const heap_view_t* heap) {
+	if (heap->size == 0)
+		return -ERROR_IS_EMPTY;
+	return heap->pos_to_idx[0];
+}
+
 void free_heap(heap_view_t* heap) {
 	if (heap == NULL)
 		return;
@@ -211,3 +281,82 @@ void free_heap(heap_view_t* heap) {
 	free(heap->pos_to_idx);
 	free(heap);
 }
+
+static void swap_elem(char* a, char* b, size_t size_bytes) {
+	char tmp[64];
+	while (size_bytes > 0) {
+		const size_t n = size_bytes < sizeof(tmp) ? size_bytes : sizeof(tmp);
+		memcpy(tmp, a, n);
+		memcpy(a, b, n);
+		memcpy(b, tmp, n);
+		a += n;
+		b += n;
+		size_bytes -= n;
+	}
+}
+
+/**
+ * Sifts down the element n of the first size elements of data, which are
+ * ordered as a heap whose root is the maximum
+ */
+static void sift_down_array(char* data,
+							unsigned size,
+							size_t size_bytes,
+							compare_fn_t compare,
+							unsigned n) {
+	unsigned child;
+	while ((child = 2 * n + 1) < size) {
+		if (child + 1 < size && compare(data + (child + 1) * size_bytes,
+										data + child * size_bytes) == 1)
+			child++;
+		if (compare(data + child * size_bytes, data + n * size_bytes) != 1)
+			return;
+		swap_elem(data + n * size_bytes, data + child * size_bytes,
+				  size_bytes);
+		n = child;
+	}
+}
+
+/**
+ * Moves the maximum of the heap of size elements at the end, size times
+ */
+static void sort_heap_array(char* data,
+							unsigned size,
+							size_t size_bytes,
+							compare_fn_t compare) {
+	for (unsigned last = size; last > 1; last--) {
+		swap_elem(data, data + (last - 1) * size_bytes, size_bytes);
+		sift_down_array(data, last - 1, size_bytes, compare, 0);
+	}
+}
+
+void heap_sort(void* data,
+			   unsigned size,
+			   size_t size_bytes,
+			   compare_fn_t compare) {
+	for (unsigned n = size / 2; n > 0; n--)
+		sift_down_array(data, size, size_bytes, compare, n - 1);
+	sort_heap_array(data, size, size_bytes, compare);
+}
+
+void partial_sort(void* data,
+				  unsigned size,
+				  unsigned k,
+				  size_t size_bytes,
+				  compare_fn_t compare) {
+	char* array = data;
+	if (k > size)
+		k = size;
+	if (k == 0)
+		return;
+	// The k lowest elements seen so far, the greatest of them at the root
+	for (unsigned n = k / 2; n > 0; n--)
+		sift_down_array(array, k, size_bytes, compare, n - 1);
+	for (unsigned i = k; i < size; i++) {
+		if (compare(array + i * size_bytes, array) == -1) {
+			swap_elem(array, array + i * size_bytes, size_bytes);
+			sift_down_array(array, k, size_bytes, compare, 0);
+		}
+	}
+	sort_heap_array(array, k, size_bytes, compare);
+}
@@ -0,0 +1,199 @@
+#include "minmax_heap.h"
+#include <stdlib.h>
+#include <string.h>
+#include "errors.h"
+#include "test_macros.h"
+
+minmax_heap_t* create_minmax_heap(unsigned capacity,
+								  size_t size_bytes,
+								  void* data,
+								  compare_fn_t compare) {
+	minmax_heap_t* ret;
+	when_null_ret(data, NULL);
+	when_null_ret(compare, NULL);
+	minmax_heap_t* heap = malloc(sizeof(minmax_heap_t));
+	when_null_ret(heap, NULL);
+	heap->idx_to_pos = malloc(capacity * sizeof(unsigned));
+	heap->pos_to_idx = malloc(capacity * sizeof(unsigned));
+	when_true_jmp(heap->idx_to_pos == NULL || heap->pos_to_idx == NULL, NULL,
+				  error);
+	for (unsigned i = 0; i < capacity; i++) {
+		heap->idx_to_pos[i] = i;
+		heap->pos_to_idx[i] = i;
+	}
+	heap->compare = compare;
+	heap->data = data;
+	heap->size = 0;
+	heap->size_bytes = size_bytes;
+	heap->capacity = capacity;
+	return heap;
+error:
+	free_minmax_heap(heap);
+	return ret;
+}
+
+void free_minmax_heap(minmax_heap_t* heap) {
+	if (heap == NULL)
+		return;
+	free(heap->idx_to_pos);
+	free(heap->pos_to_idx);
+	free(heap);
+}
+
+static BOOL is_min_level(unsigned pos) {
+	BOOL min = TRUE;
+	for (unsigned n = pos + 1; n > 1; n >>= 1)
+		min = !min;
+	return min;
+}
+
+static void* elem_at(const minmax_heap_t* heap, unsigned pos) {
+	return (char*)heap->data + heap->size_bytes * heap->pos_to_idx[pos];
+}
+
+/**
+ * TRUE if the element at a should be above the element at b on a level of the
+ * kind given by min
+ */
+static BOOL before(const minmax_heap_t* heap,
+				   unsigned a,
+				   unsigned b,
+				   BOOL min) {
+	return heap->compare(elem_at(heap, a), elem_at(heap, b)) == (min ? -1 : 1);
+}
+
+static void swap_pos(minmax_heap_t* heap, unsigned a, unsigned b) {
+	const unsigned idx_a = heap->pos_to_idx[a];
+	const unsigned idx_b = heap->pos_to_idx[b];
+	heap->pos_to_idx[a] = idx_b;
+	heap->pos_to_idx[b] = idx_a;
+	heap->idx_to_pos[idx_a] = b;
+	heap->idx_to_pos[idx_b] = a;
+}
+
+/**
+ * Moves the element at pos up the levels of its kind, returns its final
+ * position
+ */
+static unsigned push_up_levels(minmax_heap_t* heap, unsigned pos, BOOL min) {
+	while (pos > 2) {
+		const unsigned grandparent = ((pos - 1) / 2 - 1) / 2;
+		if (!before(heap, pos, grandparent, min))
+			break;
+		swap_pos(heap, pos, grandparent);
+		pos = grandparent;
+	}
+	return pos;
+}
+
+/**
+ * Moves the element at pos down until it is above its descendants on a level
+ * of the kind of pos and below them on the other kind
+ */
+static void push_down(minmax_heap_t* heap, unsigned pos) {
+	const BOOL min = is_min_level(pos);
+	for (;;) {
+		const unsigned first_child = 2 * pos + 1;
+		if (first_child >= heap->size)
+			return;
+		// Best of the children and grandchildren
+		unsigned best = first_child;
+		if (first_child + 1 < heap->size &&
+			before(heap, first_child + 1, best, min))
+			best = first_child + 1;
+		const unsigned first_grandchild = 2 * first_child + 1;
+		for (unsigned g = first_grandchild;
+			 g < first_grandchild + 4 && g < heap->size; g++) {
+			if (before(heap, g, best, min))
+				best = g;
+		}
+		if (!before(heap, best, pos, min))
+			return;
+		swap_pos(heap, best, pos);
+		if (best < first_grandchild)
+			return;
+		// The element moved to a grandchild can be beyond its new parent
+		const unsigned parent = (best - 1) / 2;
+		if (before(heap, parent, best, min))
+			swap_pos(heap, best, parent);
+		pos = best;
+	}
+}
+
+/**
+ * Restores the heap after the element at pos was replaced
+ */
+static void fix(minmax_heap_t* heap, unsigned pos) {
+	const BOOL min = is_min_level(pos);
+	if (pos > 0) {
+		const unsigned parent = (pos - 1) / 2;
+		if (before(heap, pos, parent, !min)) {
+			// The parent comes down, it is beyond every element below pos
+			swap_pos(heap, pos, parent);
+			push_down(heap, pos);
+			push_up_levels(heap, parent, !min);
+			return;
+		}
+	}
+	if (push_up_levels(heap, pos, min) == pos)
+		push_down(heap, pos);
+}
+
+int minmax_heap_insert(minmax_heap_t* heap, void* elem) {
+	when_false_ret(heap->size < heap->capacity, -ERROR_CAPACITY_EXCEEDED);
+	const unsigned idx = heap->pos_to_idx[heap->size];
+	memcpy((char*)heap->data + idx * heap->size_bytes, elem,
+		   heap->size_bytes);
+	fix(heap, heap->size++);
+	return idx;
+}
+
+int minmax_heap_peek_min(const minmax_heap_t* heap) {
+	if (heap->size == 0)
+		return -ERROR_IS_EMPTY;
+	return heap->pos_to_idx[0];
+}
+
+/**
+ * Position of the maximum element of a non empty heap
+ */
+static unsigned max_pos(const minmax_heap_t* heap) {
+	if (heap->size <= 2)
+		return heap->size - 1;
+	return before(heap, 2, 1, FALSE) ? 2 : 1;
+}
+
+int minmax_heap_peek_max(const minmax_heap_t* heap) {
+	if (heap->size == 0)
+		return -ERROR_IS_EMPTY;
+	return heap->pos_to_idx[max_pos(heap)];
+}
+
+/**
+ * Removes the element at pos, which is moved to the first position out of the
+ * heap
+ */
+static int remove_pos(minmax_heap_t* heap, unsigned pos) {
+	const unsigned idx = heap->pos_to_idx[pos];
+	swap_pos(heap, pos, --heap->size);
+	if (pos < heap->size)
+		fix(heap, pos);
+	return idx;
+}
+
+int minmax_heap_pop_min(minmax_heap_t* heap) {
+	if (heap->size == 0)
+		return -ERROR_IS_EMPTY;
+	return remove_pos(heap, 0);
+}
+
+int minmax_heap_pop_max(minmax_heap_t* heap) {
+	if (heap->size == 0)
+		return -ERROR_IS_EMPTY;
+	return remove_pos(heap, max_pos(heap));
+}
+
+int minmax_heap_remove(minmax_heap_t* heap, unsigned idx) {
+	when_false_ret(minmax_heap_contains(heap, idx), -ERROR_INVALID_PARAM2);
+	return remove_pos(heap, heap->idx_to_pos[idx]);
+}
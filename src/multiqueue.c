@@ -0,0 +1,159 @@
+#include "multiqueue.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "test_macros.h"
+
+#define CACHE_LINE 64
+#define MIN_CAPACITY 16
+
+multiqueue_t* create_multiqueue(unsigned nb_threads, unsigned c) {
+	multiqueue_t* ret;
+	when_true_ret(nb_threads == 0, NULL);
+	when_true_ret(c == 0, NULL);
+	multiqueue_t* mq = malloc(sizeof(multiqueue_t));
+	when_null_ret(mq, NULL);
+	mq->nb_heaps = nb_threads * c;
+	mq->memory =
+		malloc(mq->nb_heaps * sizeof(multiqueue_heap_t) + CACHE_LINE - 1);
+	when_null_jmp(mq->memory, NULL, error);
+	const uintptr_t aligned =
+		((uintptr_t)mq->memory + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+	mq->heaps = (multiqueue_heap_t*)aligned;
+	for (unsigned i = 0; i < mq->nb_heaps; i++) {
+		mq->heaps[i].h.entries = NULL;
+		mq->heaps[i].h.size = 0;
+		mq->heaps[i].h.capacity = 0;
+		mq->heaps[i].h.top = GRAPH_WEIGHT_INF;
+		mq->heaps[i].h.lock = 0;
+	}
+	return mq;
+error:
+	free(mq);
+	return ret;
+}
+
+void free_multiqueue(multiqueue_t* mq) {
+	if (mq == NULL)
+		return;
+	for (unsigned i = 0; i < mq->nb_heaps; i++)
+		free(mq->heaps[i].h.entries);
+	free(mq->memory);
+	free(mq);
+}
+
+static BOOL try_lock(multiqueue_heap_t* heap) {
+	// Reading first avoids taking the line in exclusive mode for nothing
+	return __atomic_load_n(&heap->h.lock, __ATOMIC_RELAXED) == 0 &&
+		   __atomic_exchange_n(&heap->h.lock, 1, __ATOMIC_ACQUIRE) == 0;
+}
+
+static void unlock(multiqueue_heap_t* heap) {
+	__atomic_store_n(&heap->h.top,
+					 heap->h.size > 0 ? heap->h.entries[0].key
+									  : GRAPH_WEIGHT_INF,
+					 __ATOMIC_RELAXED);
+	__atomic_store_n(&heap->h.lock, 0, __ATOMIC_RELEASE);
+}
+
+static graph_weight_t top(multiqueue_heap_t* heap) {
+	return __atomic_load_n(&heap->h.top, __ATOMIC_RELAXED);
+}
+
+static int heap_push(multiqueue_heap_t* heap, multiqueue_entry_t e) {
+	if (heap->h.size == heap->h.capacity) {
+		const unsigned capacity = heap->h.capacity < MIN_CAPACITY
+									  ? MIN_CAPACITY
+									  : 2 * heap->h.capacity;
+		multiqueue_entry_t* entries =
+			realloc(heap->h.entries, capacity * sizeof(multiqueue_entry_t));
+		if (entries == NULL)
+			return -ERROR_ALLOCATION_FAILED;
+		heap->h.entries = entries;
+		heap->h.capacity = capacity;
+	}
+	multiqueue_entry_t* entries = heap->h.entries;
+	unsigned n = heap->h.size++;
+	while (n > 0 && entries[(n - 1) / 2].key > e.key) {
+		entries[n] = entries[(n - 1) / 2];
+		n = (n - 1) / 2;
+	}
+	entries[n] = e;
+	return -ERROR_NO_ERROR;
+}
+
+static multiqueue_entry_t heap_pop(multiqueue_heap_t* heap) {
+	multiqueue_entry_t* entries = heap->h.entries;
+	const multiqueue_entry_t root = entries[0];
+	const multiqueue_entry_t last = entries[--heap->h.size];
+	const unsigned size = heap->h.size;
+	unsigned n = 0;
+	unsigned child;
+	while ((child = 2 * n + 1) < size) {
+		child +=
+			child + 1 < size && entries[child + 1].key < entries[child].key;
+		if (entries[child].key >= last.key)
+			break;
+		entries[n] = entries[child];
+		n = child;
+	}
+	if (size > 0)
+		entries[n] = last;
+	return root;
+}
+
+int multiqueue_push(multiqueue_t* mq,
+					prng_t* rng,
+					graph_weight_t key,
+					unsigned value) {
+	multiqueue_heap_t* heap;
+	do
+		heap = &mq->heaps[prng_bounded(rng, mq->nb_heaps)];
+	while (!try_lock(heap));
+	const int ret = heap_push(heap, (multiqueue_entry_t){key, value});
+	unlock(heap);
+	return ret;
+}
+
+/**
+ * Pops the root of heap if it is not empty, the lock being taken
+ */
+static int pop_locked(multiqueue_heap_t* heap, graph_weight_t* key) {
+	if (heap->h.size == 0) {
+		unlock(heap);
+		return -ERROR_IS_EMPTY;
+	}
+	const multiqueue_entry_t e = heap_pop(heap);
+	unlock(heap);
+	if (key != NULL)
+		*key = e.key;
+	return e.value;
+}
+
+int multiqueue_pop(multiqueue_t* mq, prng_t* rng, graph_weight_t* key) {
+	for (;;) {
+		multiqueue_heap_t* a = &mq->heaps[prng_bounded(rng, mq->nb_heaps)];
+		multiqueue_heap_t* b = &mq->heaps[prng_bounded(rng, mq->nb_heaps)];
+		if (top(b) < top(a))
+			a = b;
+		if (top(a) == GRAPH_WEIGHT_INF)
+			break;
+		if (!try_lock(a))
+			continue;
+		const int value = pop_locked(a, key);
+		if (value >= 0)
+			return value;
+	}
+	// Both heaps looked empty: every heap is tried before giving up
+	for (unsigned i = 0; i < mq->nb_heaps; i++) {
+		multiqueue_heap_t* heap = &mq->heaps[i];
+		while (top(heap) != GRAPH_WEIGHT_INF) {
+			if (!try_lock(heap))
+				continue;
+			const int value = pop_locked(heap, key);
+			if (value >= 0)
+				return value;
+		}
+	}
+	return -ERROR_IS_EMPTY;
+}
@@ -0,0 +1,183 @@
+#include "pairing_heap.h"
+#include <stdlib.h>
+#include "errors.h"
+#include "test_macros.h"
+
+typedef struct pool_chunk {
+	struct pool_chunk* next;
+	pairing_node_t nodes[];
+} pool_chunk_t;
+
+pairing_pool_t* create_pairing_pool(unsigned chunk_size) {
+	when_true_ret(chunk_size == 0, NULL);
+	pairing_pool_t* pool = malloc(sizeof(pairing_pool_t));
+	when_null_ret(pool, NULL);
+	pool->chunks = NULL;
+	pool->free = NULL;
+	pool->chunk_size = chunk_size;
+	return pool;
+}
+
+void free_pairing_pool(pairing_pool_t* pool) {
+	if (pool == NULL)
+		return;
+	pool_chunk_t* chunk = pool->chunks;
+	while (chunk != NULL) {
+		pool_chunk_t* next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	free(pool);
+}
+
+static pairing_node_t* pool_alloc(pairing_pool_t* pool) {
+	if (pool->free == NULL) {
+		pool_chunk_t* chunk = malloc(sizeof(pool_chunk_t) +
+									 pool->chunk_size * sizeof(pairing_node_t));
+		if (chunk == NULL)
+			return NULL;
+		chunk->next = pool->chunks;
+		pool->chunks = chunk;
+		// The nodes are given in the order of the memory
+		for (unsigned i = pool->chunk_size; i > 0; i--) {
+			chunk->nodes[i - 1].next = pool->free;
+			pool->free = &chunk->nodes[i - 1];
+		}
+	}
+	pairing_node_t* node = pool->free;
+	pool->free = node->next;
+	return node;
+}
+
+static void pool_release(pairing_pool_t* pool, pairing_node_t* node) {
+	node->next = pool->free;
+	pool->free = node;
+}
+
+void pairing_heap_init(pairing_heap_t* heap, pairing_pool_t* pool) {
+	heap->root = NULL;
+	heap->size = 0;
+	heap->pool = pool;
+}
+
+void pairing_heap_clear(pairing_heap_t* heap) {
+	// Stack of the nodes to release linked by next
+	pairing_node_t* stack = heap->root;
+	while (stack != NULL) {
+		pairing_node_t* node = stack;
+		stack = node->next;
+		pairing_node_t* child = node->child;
+		while (child != NULL) {
+			pairing_node_t* next = child->next;
+			child->next = stack;
+			stack = child;
+			child = next;
+		}
+		pool_release(heap->pool, node);
+	}
+	heap->root = NULL;
+	heap->size = 0;
+}
+
+/**
+ * Links two trees without siblings, the root with the greatest key becoming
+ * the first child of the other one
+ */
+static pairing_node_t* link(pairing_node_t* a, pairing_node_t* b) {
+	if (b->key < a->key) {
+		pairing_node_t* tmp = a;
+		a = b;
+		b = tmp;
+	}
+	b->prev = a;
+	b->next = a->child;
+	if (a->child != NULL)
+		a->child->prev = b;
+	a->child = b;
+	return a;
+}
+
+pairing_node_t* pairing_heap_insert(pairing_heap_t* heap,
+									graph_weight_t key,
+									unsigned value) {
+	pairing_node_t* node = pool_alloc(heap->pool);
+	if (node == NULL)
+		return NULL;
+	node->key = key;
+	node->value = value;
+	node->child = node->next = node->prev = NULL;
+	heap->root = heap->root == NULL ? node : link(heap->root, node);
+	heap->size++;
+	return node;
+}
+
+void pairing_heap_meld(pairing_heap_t* heap, pairing_heap_t* other) {
+	if (other->root != NULL) {
+		heap->root =
+			heap->root == NULL ? other->root : link(heap->root, other->root);
+		heap->size += other->size;
+	}
+	other->root = NULL;
+	other->size = 0;
+}
+
+void pairing_heap_decrease_key(pairing_heap_t* heap,
+							   pairing_node_t* node,
+							   graph_weight_t key) {
+	if (key >= node->key)
+		return;
+	node->key = key;
+	if (node == heap->root)
+		return;
+	// Cuts the subtree of node from its parent
+	if (node->prev->child == node)
+		node->prev->child = node->next;
+	else
+		node->prev->next = node->next;
+	if (node->next != NULL)
+		node->next->prev = node->prev;
+	node->next = node->prev = NULL;
+	heap->root = link(heap->root, node);
+}
+
+int pairing_heap_pop(pairing_heap_t* heap, graph_weight_t* key) {
+	pairing_node_t* root = heap->root;
+	if (root == NULL)
+		return -ERROR_IS_EMPTY;
+	if (key != NULL)
+		*key = root->key;
+	const int value = root->value;
+
+	// First pass: links the children by pairs from left to right, the pairs
+	// being stacked so that the last one is on top
+	pairing_node_t* pairs = NULL;
+	pairing_node_t* child = root->child;
+	while (child != NULL) {
+		pairing_node_t* a = child;
+		pairing_node_t* b = a->next;
+		child = b != NULL ? b->next : NULL;
+		a->next = a->prev = NULL;
+		if (b != NULL) {
+			b->next = b->prev = NULL;
+			a = link(a, b);
+		}
+		a->next = pairs;
+		pairs = a;
+	}
+	// Second pass: melds the pairs from right to left
+	pairing_node_t* new_root = pairs;
+	if (pairs != NULL) {
+		pairs = pairs->next;
+		new_root->next = NULL;
+		while (pairs != NULL) {
+			pairing_node_t* next = pairs->next;
+			pairs->next = NULL;
+			new_root = link(new_root, pairs);
+			pairs = next;
+		}
+	}
+	heap->root = new_root;
+	heap->size--;
+	pool_release(heap->pool, root);
+	return value;
+}
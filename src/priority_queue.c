@@ -0,0 +1,144 @@
+#include "priority_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include "errors.h"
+#include "test_macros.h"
+
+#define ELEM(pq, i) ((pq)->data + (size_t)(i) * (pq)->size_bytes)
+
+/**
+ * Copies an element, the usual sizes are copied with a constant size that the
+ * compiler turns into plain moves instead of a call to memcpy
+ */
+static inline void copy(const priority_queue_t* pq,
+						void* dst,
+						const void* src) {
+	switch (pq->size_bytes) {
+		case 4:
+			memcpy(dst, src, 4);
+			break;
+		case 8:
+			memcpy(dst, src, 8);
+			break;
+		case 16:
+			memcpy(dst, src, 16);
+			break;
+		default:
+			memcpy(dst, src, pq->size_bytes);
+	}
+}
+
+priority_queue_t* create_priority_queue(size_t size_bytes,
+										compare_fn_t compare) {
+	priority_queue_t* ret;
+	when_true_ret(size_bytes == 0, NULL);
+	when_null_ret(compare, NULL);
+	priority_queue_t* pq = calloc(1, sizeof(priority_queue_t));
+	when_null_ret(pq, NULL);
+	pq->size_bytes = size_bytes;
+	pq->compare = compare;
+	pq->tmp = malloc(size_bytes);
+	when_null_jmp(pq->tmp, NULL, error);
+	return pq;
+error:
+	free(pq);
+	return ret;
+}
+
+void free_priority_queue(priority_queue_t* pq) {
+	if (pq == NULL)
+		return;
+	free(pq->data);
+	free(pq->tmp);
+	free(pq);
+}
+
+static int resize(priority_queue_t* pq, unsigned capacity) {
+	char* data = realloc(pq->data, (size_t)capacity * pq->size_bytes);
+	if (data == NULL && capacity > 0)
+		return -ERROR_ALLOCATION_FAILED;
+	pq->data = data;
+	pq->capacity = capacity;
+	return -ERROR_NO_ERROR;
+}
+
+int priority_queue_reserve(priority_queue_t* pq, unsigned capacity) {
+	if (capacity <= pq->capacity)
+		return -ERROR_NO_ERROR;
+	return resize(pq, capacity);
+}
+
+int priority_queue_shrink(priority_queue_t* pq) {
+	if (pq->size == pq->capacity)
+		return -ERROR_NO_ERROR;
+	return resize(pq, pq->size);
+}
+
+/**
+ * Moves up the hole at position n until pq->tmp fits in it
+ */
+static void sift_up(priority_queue_t* pq, unsigned n) {
+	while (n > 0) {
+		const unsigned father = (n - 1) / 2;
+		if (pq->compare(pq->tmp, ELEM(pq, father)) != 1)
+			break;
+		copy(pq, ELEM(pq, n), ELEM(pq, father));
+		n = father;
+	}
+	copy(pq, ELEM(pq, n), pq->tmp);
+}
+
+/**
+ * Moves down the hole at the root until pq->tmp fits in it
+ */
+static void sift_down(priority_queue_t* pq) {
+	unsigned n = 0;
+	unsigned child;
+	while ((child = 2 * n + 1) < pq->size) {
+		if (child + 1 < pq->size &&
+			pq->compare(ELEM(pq, child + 1), ELEM(pq, child)) == 1)
+			child++;
+		if (pq->compare(ELEM(pq, child), pq->tmp) != 1)
+			break;
+		copy(pq, ELEM(pq, n), ELEM(pq, child));
+		n = child;
+	}
+	copy(pq, ELEM(pq, n), pq->tmp);
+}
+
+int priority_queue_push(priority_queue_t* pq, const void* elem) {
+	if (pq->size == pq->capacity) {
+		const unsigned capacity = pq->capacity < PRIORITY_QUEUE_MIN_CAPACITY
+									  ? PRIORITY_QUEUE_MIN_CAPACITY
+									  : 2 * pq->capacity;
+		if (resize(pq, capacity) < 0)
+			return -ERROR_ALLOCATION_FAILED;
+	}
+	copy(pq, pq->tmp, elem);
+	sift_up(pq, pq->size++);
+	return pq->size;
+}
+
+int priority_queue_pop(priority_queue_t* pq, void* elem) {
+	if (pq->size == 0)
+		return -ERROR_IS_EMPTY;
+	if (elem != NULL)
+		copy(pq, elem, pq->data);
+	if (--pq->size > 0) {
+		copy(pq, pq->tmp, ELEM(pq, pq->size));
+		sift_down(pq);
+	}
+	return -ERROR_NO_ERROR;
+}
+
+int priority_queue_replace_top(priority_queue_t* pq,
+							   const void* elem,
+							   void* top) {
+	if (pq->size == 0)
+		return -ERROR_IS_EMPTY;
+	if (top != NULL)
+		copy(pq, top, pq->data);
+	copy(pq, pq->tmp, elem);
+	sift_down(pq);
+	return -ERROR_NO_ERROR;
+}
@@ -0,0 +1,223 @@
+#include "timer_wheel.h"
+#include <stdlib.h>
+#include "errors.h"
+#include "test_macros.h"
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+#define INITIAL_SLOT_CAPACITY 4
+
+typedef struct slot_entry {
+	unsigned id;
+	unsigned generation;
+} slot_entry_t;
+
+timer_wheel_t* create_timer_wheel(unsigned capacity, uint64_t now) {
+	timer_wheel_t* ret;
+	when_true_ret(capacity == 0, NULL);
+	timer_wheel_t* wheel = calloc(1, sizeof(timer_wheel_t));
+	when_null_ret(wheel, NULL);
+	wheel->timers = malloc(capacity * sizeof(timer_wheel_timer_t));
+	when_null_jmp(wheel->timers, NULL, error);
+	for (unsigned i = 0; i < capacity; i++) {
+		wheel->timers[i].generation = 0;
+		wheel->timers[i].next_free = i + 1;
+		wheel->timers[i].pending = FALSE;
+	}
+	for (unsigned k = 0; k < TIMER_WHEEL_LEVELS; k++) {
+		for (unsigned s = 0; s < TIMER_WHEEL_SLOTS; s++) {
+			wheel->slots[k][s] = create_circular_buffer(sizeof(slot_entry_t),
+														INITIAL_SLOT_CAPACITY);
+			when_null_jmp(wheel->slots[k][s], NULL, error);
+		}
+	}
+	wheel->capacity = capacity;
+	wheel->now = now;
+	return wheel;
+error:
+	free_timer_wheel(wheel);
+	return ret;
+}
+
+void free_timer_wheel(timer_wheel_t* wheel) {
+	if (wheel == NULL)
+		return;
+	for (unsigned k = 0; k < TIMER_WHEEL_LEVELS; k++) {
+		for (unsigned s = 0; s < TIMER_WHEEL_SLOTS; s++) {
+			if (wheel->slots[k][s] != NULL)
+				free_circular_buffer(wheel->slots[k][s]);
+		}
+	}
+	free(wheel->timers);
+	free(wheel);
+}
+
+/**
+ * Appends an entry to a slot, the circular buffer of the slot being replaced
+ * by one twice bigger when it is full
+ */
+static int slot_push(circular_buffer_t** slot, slot_entry_t entry) {
+	if (circular_buffer_push_back(*slot, &entry) == -ERROR_NO_ERROR)
+		return -ERROR_NO_ERROR;
+	circular_buffer_t* bigger =
+		create_circular_buffer(sizeof(slot_entry_t), 2 * (*slot)->capacity);
+	if (bigger == NULL)
+		return -ERROR_ALLOCATION_FAILED;
+	slot_entry_t e;
+	while (circular_buffer_pop_front(*slot, &e) == -ERROR_NO_ERROR)
+		circular_buffer_push_back(bigger, &e);
+	free_circular_buffer(*slot);
+	*slot = bigger;
+	return circular_buffer_push_back(bigger, &entry);
+}
+
+/**
+ * Puts the timer id in the slot covering its delay from the current tick
+ */
+static int place(timer_wheel_t* wheel, unsigned id) {
+	const timer_wheel_timer_t* timer = &wheel->timers[id];
+	const uint64_t delay = timer->expiry - wheel->now;
+	unsigned level = 0;
+	while (level < TIMER_WHEEL_LEVELS - 1 &&
+		   delay >> (TIMER_WHEEL_SLOT_BITS * (level + 1)) != 0)
+		level++;
+	// A delay beyond the top level waits in its farthest slot
+	const uint64_t max_delay =
+		((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1;
+	const uint64_t at =
+		delay > max_delay ? wheel->now + max_delay : timer->expiry;
+	const unsigned s = (at >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK;
+	const slot_entry_t entry = {id, timer->generation};
+	if (slot_push(&wheel->slots[level][s], entry) < 0)
+		return -ERROR_ALLOCATION_FAILED;
+	wheel->level_size[level]++;
+	return -ERROR_NO_ERROR;
+}
+
+/**
+ * Gives back a timer which is not pending anymore
+ */
+static void release(timer_wheel_t* wheel, unsigned id) {
+	timer_wheel_timer_t* timer = &wheel->timers[id];
+	timer->generation++;
+	timer->pending = FALSE;
+	timer->next_free = wheel->free;
+	wheel->free = id;
+	wheel->nb_pending--;
+}
+
+int timer_wheel_schedule(timer_wheel_t* wheel, uint64_t expiry, void* data) {
+	if (wheel->free == wheel->capacity)
+		return -ERROR_CAPACITY_EXCEEDED;
+	const unsigned id = wheel->free;
+	timer_wheel_timer_t* timer = &wheel->timers[id];
+	timer->expiry = expiry > wheel->now ? expiry : wheel->now + 1;
+	timer->data = data;
+	if (place(wheel, id) < 0)
+		return -ERROR_ALLOCATION_FAILED;
+	wheel->free = timer->next_free;
+	timer->pending = TRUE;
+	wheel->nb_pending++;
+	return id;
+}
+
+int timer_wheel_cancel(timer_wheel_t* wheel, unsigned id) {
+	// Tested without when_true_ret() as an expired timer is not a programming
+	// error: it may have expired in the meantime
+	if (id >= wheel->capacity || !wheel->timers[id].pending)
+		return -ERROR_INVALID_PARAM2;
+	release(wheel, id);
+	return -ERROR_NO_ERROR;
+}
+
+static BOOL is_current(const timer_wheel_t* wheel, slot_entry_t e) {
+	return wheel->timers[e.id].generation == e.generation;
+}
+
+/**
+ * Moves the timers of a slot of a higher level to the lower levels. If a
+ * timer cannot be placed, it is put back in the slot with the timers not moved
+ * yet so that the cascade can be done again.
+ */
+static int cascade(timer_wheel_t* wheel, unsigned level, unsigned s) {
+	circular_buffer_t* slot = wheel->slots[level][s];
+	slot_entry_t e;
+	// The entries placed by this cascade go to lower levels
+	while (circular_buffer_pop_front(slot, &e) == -ERROR_NO_ERROR) {
+		wheel->level_size[level]--;
+		if (is_current(wheel, e) && place(wheel, e.id) < 0) {
+			// The entry was just popped, there is room for it
+			circular_buffer_push_front(slot, &e);
+			wheel->level_size[level]++;
+			return -ERROR_ALLOCATION_FAILED;
+		}
+	}
+	return -ERROR_NO_ERROR;
+}
+
+static void flush(timer_wheel_t* wheel,
+				  timer_wheel_expire_fn expire,
+				  void* ctx) {
+	if (wheel->batch_size > 0) {
+		const unsigned count = wheel->batch_size;
+		wheel->batch_size = 0;
+		expire(wheel->batch, count, ctx);
+	}
+}
+
+int timer_wheel_advance(timer_wheel_t* wheel,
+						uint64_t now,
+						timer_wheel_expire_fn expire,
+						void* ctx) {
+	int expired = 0;
+	while (wheel->now < now) {
+		if (wheel->nb_pending == 0) {
+			wheel->now = now;
+			break;
+		}
+		unsigned lowest = 0;
+		while (lowest < TIMER_WHEEL_LEVELS - 1 &&
+			   wheel->level_size[lowest] == 0)
+			lowest++;
+		if (lowest > 0) {
+			// Nothing happens before the next cascade of the lowest level
+			const uint64_t span = (uint64_t)1
+								  << (TIMER_WHEEL_SLOT_BITS * lowest);
+			const uint64_t next = (wheel->now | (span - 1)) + 1;
+			if (next > now) {
+				wheel->now = now;
+				break;
+			}
+			wheel->now = next - 1;
+		}
+		const uint64_t t = ++wheel->now;
+		// The higher levels first, so that their timers can reach the slots
+		// emptied next
+		for (unsigned k = TIMER_WHEEL_LEVELS - 1; k > 0; k--) {
+			if ((t & ((1ull << (TIMER_WHEEL_SLOT_BITS * k)) - 1)) != 0)
+				continue;
+			const unsigned s = (t >> (TIMER_WHEEL_SLOT_BITS * k)) & SLOT_MASK;
+			if (cascade(wheel, k, s) < 0) {
+				// Tick t is done again by the next call, the timers already
+				// moved being in the slots of their expiry
+				wheel->now = t - 1;
+				flush(wheel, expire, ctx);
+				return -ERROR_ALLOCATION_FAILED;
+			}
+		}
+		circular_buffer_t* slot = wheel->slots[0][t & SLOT_MASK];
+		slot_entry_t e;
+		while (circular_buffer_pop_front(slot, &e) == -ERROR_NO_ERROR) {
+			wheel->level_size[0]--;
+			if (!is_current(wheel, e))
+				continue;
+			wheel->batch[wheel->batch_size++] =
+				(timer_wheel_expired_t){e.id, wheel->timers[e.id].data};
+			release(wheel, e.id);
+			expired++;
+			if (wheel->batch_size == TIMER_WHEEL_BATCH)
+				flush(wheel, expire, ctx);
+		}
+	}
+	flush(wheel, expire, ctx);
+	return expired;
+}
@@ -0,0 +1,77 @@
+#include "topk.h"
+#include <stdlib.h>
+#include "test_macros.h"
+
+topk_t* create_topk(unsigned k) {
+	topk_t* ret;
+	when_true_ret(k == 0, NULL);
+	topk_t* topk = malloc(sizeof(topk_t));
+	when_null_ret(topk, NULL);
+	topk->entries = malloc(k * sizeof(topk_entry_t));
+	when_null_jmp(topk->entries, NULL, error);
+	topk->k = k;
+	topk_clear(topk);
+	return topk;
+error:
+	free(topk);
+	return ret;
+}
+
+void free_topk(topk_t* topk) {
+	if (topk == NULL)
+		return;
+	free(topk->entries);
+	free(topk);
+}
+
+void topk_clear(topk_t* topk) {
+	topk->size = 0;
+	topk->threshold = 0;
+}
+
+/**
+ * Puts the entry e at position n of the heap of topk->size entries and sifts
+ * it down
+ */
+static void sift_down(topk_t* topk, unsigned n, topk_entry_t e) {
+	topk_entry_t* entries = topk->entries;
+	const unsigned size = topk->size;
+	unsigned child;
+	while ((child = 2 * n + 1) < size) {
+		child +=
+			child + 1 < size && entries[child + 1].key < entries[child].key;
+		if (entries[child].key >= e.key)
+			break;
+		entries[n] = entries[child];
+		n = child;
+	}
+	entries[n] = e;
+}
+
+void topk_insert(topk_t* topk, double key, unsigned id) {
+	topk_entry_t* entries = topk->entries;
+	const topk_entry_t e = {key, id};
+	if (topk->size < topk->k) {
+		unsigned n = topk->size++;
+		while (n > 0 && entries[(n - 1) / 2].key > key) {
+			entries[n] = entries[(n - 1) / 2];
+			n = (n - 1) / 2;
+		}
+		entries[n] = e;
+	} else
+		sift_down(topk, 0, e);
+	topk->threshold = entries[0].key;
+}
+
+unsigned topk_extract(topk_t* topk, topk_entry_t* out) {
+	const unsigned count = topk->size;
+	// The lowest entry is popped first and written at the end
+	while (topk->size > 0) {
+		out[topk->size - 1] = topk->entries[0];
+		const topk_entry_t last = topk->entries[--topk->size];
+		if (topk->size > 0)
+			sift_down(topk, 0, last);
+	}
+	topk_clear(topk);
+	return count;
+}
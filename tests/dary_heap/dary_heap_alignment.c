@@ -0,0 +1,18 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "dary_heap.h"
+
+int main(void) {
+	const unsigned arities[] = {2, 4, 8, 16};
+	for (unsigned i = 0; i < 4; i++) {
+		dary_heap_t* heap = create_dary_heap(100, arities[i]);
+		assert(heap != NULL);
+		assert((1u << heap->log_arity) == arities[i]);
+		assert(heap->size == 0);
+		// The children of the root start a cache line
+		assert((uintptr_t)&heap->entries[1] % 64 == 0);
+		free_dary_heap(heap);
+	}
+	return 0;
+}
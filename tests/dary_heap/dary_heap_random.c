@@ -0,0 +1,60 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "dary_heap.h"
+#include "errors.h"
+
+#define CAPACITY 200
+#define OPERATION_COUNT 20000
+
+graph_weight_t key[CAPACITY];
+BOOL present[CAPACITY];
+
+// Compares the heap with an array of keys on random decrease-keys and pops
+static void check(unsigned arity) {
+	prng_t rng;
+	prng_seed(&rng, arity);
+	dary_heap_t* heap = create_dary_heap(CAPACITY, arity);
+	assert(heap != NULL);
+	for (unsigned i = 0; i < CAPACITY; i++)
+		present[i] = FALSE;
+
+	for (unsigned op = 0; op < OPERATION_COUNT; op++) {
+		if (prng_bounded(&rng, 3) != 0) {
+			const unsigned idx = prng_bounded(&rng, CAPACITY);
+			const graph_weight_t k = prng_bounded(&rng, 1000);
+			dary_heap_decrease_key(heap, idx, k);
+			if (!present[idx] || k < key[idx])
+				key[idx] = k;
+			present[idx] = TRUE;
+			continue;
+		}
+		graph_weight_t min = GRAPH_WEIGHT_INF;
+		for (unsigned i = 0; i < CAPACITY; i++) {
+			if (present[i] && key[i] < min)
+				min = key[i];
+		}
+		graph_weight_t k;
+		const int idx = dary_heap_pop(heap, &k);
+		if (min == GRAPH_WEIGHT_INF) {
+			assert(idx == -ERROR_IS_EMPTY);
+			continue;
+		}
+		assert(idx >= 0 && present[idx] && key[idx] == min && k == min);
+		assert(!dary_heap_contains(heap, idx));
+		present[idx] = FALSE;
+	}
+
+	dary_heap_clear(heap);
+	assert(heap->size == 0);
+	for (unsigned i = 0; i < CAPACITY; i++)
+		assert(!dary_heap_contains(heap, i));
+	free_dary_heap(heap);
+}
+
+int main(void) {
+	check(2);
+	check(4);
+	check(8);
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include <assert.h>
+#include <graph/graph_cast.h>
+#include <graph/graph_generators.h>
+
+#define NODE_COUNT 500
+
+int main(void) {
+	graph_edge_array_t* edges =
+		graph_generate_rmat(9, 8 * NODE_COUNT, 0.57, 0.19, 0.19, 50, 3);
+	graph_list_t* list = graph_edge_array_to_graph_list(edges);
+	graph_mat_t* mat = graph_edge_array_to_graph_mat(edges);
+	const unsigned n = list->nb_vert;
+
+	for (unsigned nb_threads = 1; nb_threads <= 4; nb_threads += 3) {
+		graph_csr_t* from_list = graph_list_to_graph_csr(list, nb_threads);
+		graph_csr_t* from_mat = graph_mat_to_graph_csr(mat, nb_threads);
+		assert(from_list->nb_edges == edges->nb_edges);
+		assert(from_mat->nb_edges == edges->nb_edges);
+		assert(from_list->offset[0] == 0);
+		assert(from_list->offset[n] == edges->nb_edges);
+
+		for (unsigned v = 0; v < n; v++) {
+			assert(graph_csr_outdegree(from_list, v) ==
+				   graph_list_outdegree(list, v));
+			assert(from_list->offset[v] == from_mat->offset[v]);
+			// The list keeps its order
+			size_t k = from_list->offset[v];
+			foreach_node(&list->neighbours[v], e, graph_list_edge_t) {
+				assert(from_list->to[k] == e->to);
+				assert(from_list->weights[k] == e->w);
+				k++;
+			}
+			// The matrix gives sorted successors
+			for (k = from_mat->offset[v]; k < from_mat->offset[v + 1]; k++) {
+				if (k > from_mat->offset[v])
+					assert(from_mat->to[k - 1] < from_mat->to[k]);
+				assert(graph_mat_get_weight(mat, v, from_mat->to[k]) ==
+					   from_mat->weights[k]);
+			}
+		}
+
+		graph_list_t* back_list =
+			graph_csr_to_graph_list(from_list, nb_threads);
+		graph_mat_t* back_mat = graph_csr_to_graph_mat(from_mat, nb_threads);
+		for (unsigned v = 0; v < n; v++) {
+			assert(graph_list_outdegree(back_list, v) ==
+				   graph_list_outdegree(list, v));
+			foreach_node(&list->neighbours[v], e, graph_list_edge_t) {
+				assert(graph_list_get_edge(back_list, v, e->to)->w == e->w);
+				assert(graph_mat_get_edge(back_mat, v, e->to));
+				assert(graph_mat_get_weight(back_mat, v, e->to) == e->w);
+			}
+			assert(graph_mat_outdegree(back_mat, v) ==
+				   graph_list_outdegree(list, v));
+		}
+		free_graph_mat(back_mat);
+		free_graph_list(back_list);
+		free_graph_csr(from_mat);
+		free_graph_csr(from_list);
+	}
+
+	// Graph without edge
+	graph_list_t* empty = create_graph_list(4, FALSE);
+	graph_csr_t* csr = graph_list_to_graph_csr(empty, 2);
+	assert(csr->nb_edges == 0 && csr->weights == NULL);
+	for (unsigned v = 0; v <= 4; v++)
+		assert(csr->offset[v] == 0);
+	free_graph_csr(csr);
+	free_graph_list(empty);
+
+	free_graph_mat(mat);
+	free_graph_list(list);
+	free_graph_edge_array(edges);
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <assert.h>
+#include <graph/graph_cast.h>
+#include <graph/graph_generators.h>
+
+#define NODE_COUNT 300
+
+static void check_same(graph_mat_t* mat, graph_list_t* list) {
+	assert(mat->nb_vert == list->nb_vert);
+	for (unsigned i = 0; i < NODE_COUNT; i++) {
+		assert(graph_mat_outdegree(mat, i) == graph_list_outdegree(list, i));
+		foreach_node(&list->neighbours[i], e, graph_list_edge_t) {
+			assert(graph_mat_get_edge(mat, i, e->to));
+			assert(graph_mat_get_weight(mat, i, e->to) == e->w);
+		}
+	}
+}
+
+int main(void) {
+	// A sparse and a dense graph so that both the skipped blocks and the
+	// cell by cell scan are used
+	const double densities[] = {0.01, 0.6};
+	for (unsigned d = 0; d < 2; d++) {
+		graph_edge_array_t* edges =
+			graph_generate_gnp(NODE_COUNT, densities[d], 1000, d);
+		graph_mat_t* mat = graph_edge_array_to_graph_mat(edges);
+
+		graph_list_t* list = NULL;
+		assert(graph_mat_to_graph_list(mat, &list) == list);
+		check_same(mat, list);
+
+		// The result does not depend on the number of threads
+		for (unsigned nb_threads = 0; nb_threads <= 5; nb_threads += 5) {
+			graph_list_t* parallel =
+				graph_mat_to_graph_list_parallel(mat, nb_threads);
+			check_same(mat, parallel);
+			graph_mat_t* back = graph_list_to_graph_mat(parallel, nb_threads);
+			for (unsigned i = 0; i < NODE_COUNT; i++) {
+				for (unsigned j = 0; j < NODE_COUNT; j++) {
+					assert(graph_mat_get_edge(back, i, j) ==
+						   graph_mat_get_edge(mat, i, j));
+					if (graph_mat_get_edge(mat, i, j))
+						assert(graph_mat_get_weight(back, i, j) ==
+							   graph_mat_get_weight(mat, i, j));
+				}
+			}
+			free_graph_mat(back);
+			free_graph_list(parallel);
+		}
+
+		free_graph_list(list);
+		free_graph_mat(mat);
+		free_graph_edge_array(edges);
+	}
+
+	// Unweighted graphs stay unweighted
+	graph_list_t* u = create_graph_list(3, FALSE);
+	graph_list_set_edge(u, 0, 2, TRUE, 0, FALSE);
+	graph_mat_t* m = graph_list_to_graph_mat(u, 2);
+	assert(m->weights == NULL);
+	assert(graph_mat_get_edge(m, 0, 2) && !graph_mat_get_edge(m, 2, 0));
+	graph_list_t* l = graph_mat_to_graph_list_parallel(m, 2);
+	assert(l->is_weighted == FALSE);
+	assert(graph_list_get_edge(l, 0, 2)->w == 1);
+	free_graph_list(l);
+	free_graph_mat(m);
+	free_graph_list(u);
+	return 0;
+}
@@ -0,0 +1,35 @@
+#include <assert.h>
+#include <graph/graph_centrality.h>
+
+#define NODE_COUNT 50
+
+double exact[NODE_COUNT], approx[NODE_COUNT], approx2[NODE_COUNT];
+
+int main(void) {
+	// Undirected cycle, every vertex has the same centrality
+	graph_list_t* g = create_graph_list(NODE_COUNT, FALSE);
+	for (unsigned i = 0; i < NODE_COUNT; i++)
+		graph_list_set_edge(g, i, (i + 1) % NODE_COUNT, TRUE, 0, TRUE);
+	assert(0 == graph_list_betweenness(g, exact, 2));
+
+	// Sampling every vertex gives the exact result
+	assert(0 ==
+		   graph_list_betweenness_sampled(g, approx, NODE_COUNT, 42, 3));
+	for (int i = 0; i < NODE_COUNT; i++)
+		assert(exact[i] == approx[i]);
+
+	// The sampling is deterministic
+	assert(0 == graph_list_betweenness_sampled(g, approx, 10, 7, 1));
+	assert(0 == graph_list_betweenness_sampled(g, approx2, 10, 7, 4));
+	double sum = 0, sum_exact = 0;
+	for (int i = 0; i < NODE_COUNT; i++) {
+		assert(approx[i] == approx2[i]);
+		sum += approx[i];
+		sum_exact += exact[i];
+	}
+	// On a vertex-transitive graph every source has the same total
+	// dependency so the scaled sum is exact
+	assert(sum - sum_exact < 1e-6 && sum_exact - sum < 1e-6);
+	free_graph_list(g);
+	return 0;
+}
@@ -0,0 +1,34 @@
+#include <assert.h>
+#include <graph/graph_centrality.h>
+
+#define EDGE_COUNT 5
+#define NODE_COUNT 5
+
+const unsigned int edges[EDGE_COUNT][2] = {
+	{0, 1},
+	{0, 2},
+	{1, 3},
+	{2, 3},
+	{3, 4},
+};
+
+const double expected[NODE_COUNT] = {0, 1, 1, 3, 0};
+
+double centrality[NODE_COUNT];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, FALSE);
+	for (int i = 0; i < EDGE_COUNT; i++)
+		graph_list_set_edge(g, edges[i][0], edges[i][1], TRUE, 0, FALSE);
+	for (unsigned threads = 0; threads < 4; threads++) {
+		assert(0 == graph_list_betweenness(g, centrality, threads));
+		for (int i = 0; i < NODE_COUNT; i++)
+			assert(expected[i] == centrality[i]);
+	}
+	free_graph_list(g);
+
+	// An empty graph has no source and nothing to compute
+	graph_list_t empty = {.nb_vert = 0};
+	assert(0 == graph_list_betweenness(&empty, centrality, 4));
+	return 0;
+}
@@ -0,0 +1,35 @@
+#include <assert.h>
+#include <graph/graph_centrality.h>
+
+#define EDGE_COUNT 6
+#define NODE_COUNT 5
+
+const unsigned int edges[EDGE_COUNT][2] = {
+	{0, 1},
+	{0, 2},
+	{1, 3},
+	{2, 3},
+	{3, 4},
+	{2, 4},
+};
+
+const graph_weight_t weights[EDGE_COUNT] = {1, 2, 1, 1, 1, 1};
+
+// 0 -> 4 has two shortest paths: 0-1-3-4 and 0-2-4
+const double expected[NODE_COUNT] = {0, 1.5, 0.5, 1.5, 0};
+
+double centrality[NODE_COUNT];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (int i = 0; i < EDGE_COUNT; i++)
+		graph_list_set_edge(g, edges[i][0], edges[i][1], TRUE, weights[i],
+							FALSE);
+	for (unsigned threads = 1; threads < 8; threads++) {
+		assert(0 == graph_list_betweenness(g, centrality, threads));
+		for (int i = 0; i < NODE_COUNT; i++)
+			assert(expected[i] == centrality[i]);
+	}
+	free_graph_list(g);
+	return 0;
+}
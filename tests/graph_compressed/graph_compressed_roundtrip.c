@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <graph/graph_compressed.h>
+#include <prng.h>
+
+#define NODE_COUNT 500
+#define EDGE_COUNT 5000
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 7);
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (unsigned i = 0; i < EDGE_COUNT; i++) {
+		const unsigned a = prng_bounded(&rng, NODE_COUNT);
+		// Mostly close successors with a few far ones
+		const unsigned b = prng_bounded(&rng, 4) == 0
+							   ? prng_bounded(&rng, NODE_COUNT)
+							   : (a + prng_bounded(&rng, 16)) % NODE_COUNT;
+		// Negative and large weights are encoded as well
+		graph_weight_t w = (graph_weight_t)prng_bounded(&rng, 200) - 100;
+		if (i % 97 == 0)
+			w = GRAPH_WEIGHT_INF;
+		graph_list_set_edge(g, a, b, TRUE, w, FALSE);
+	}
+
+	graph_compressed_t* c = graph_list_to_graph_compressed(g);
+	assert(c != NULL);
+	assert(c->nb_vert == NODE_COUNT);
+
+	size_t nb_edges = 0;
+	graph_compressed_iter_t it;
+	for (unsigned v = 0; v < NODE_COUNT; v++) {
+		const unsigned degree = graph_compressed_neighbours(c, v, &it);
+		assert(degree == graph_list_outdegree(g, v));
+		unsigned count = 0;
+		int previous = -1;
+		while (graph_compressed_next(&it)) {
+			// The successors are sorted
+			assert((int)it.to > previous);
+			previous = it.to;
+			graph_list_edge_t* e = graph_list_get_edge(g, v, it.to);
+			assert(e != NULL);
+			assert(e->w == it.w);
+			count++;
+		}
+		assert(count == degree);
+		nb_edges += count;
+	}
+	assert(nb_edges == c->nb_edges);
+
+	// Most gaps and weights fit in a single byte, whatever graph_weight_t is
+	assert(c->offset[NODE_COUNT] < 2 * nb_edges);
+	assert(c->weight_offset[NODE_COUNT] < 2 * nb_edges);
+	// Smaller than the same offsets with plain arrays of successors and weights
+	const size_t plain = sizeof(graph_compressed_t) +
+						 2 * (NODE_COUNT + 1) * sizeof(size_t) +
+						 nb_edges * (sizeof(unsigned) + sizeof(graph_weight_t));
+	assert(graph_compressed_memory(c) < plain);
+
+	free_graph_compressed(c);
+
+	// Unweighted graphs have no weight stream
+	graph_list_t* u = create_graph_list(3, FALSE);
+	graph_list_set_edge(u, 2, 0, TRUE, 0, FALSE);
+	graph_list_set_edge(u, 2, 1, TRUE, 0, FALSE);
+	c = graph_list_to_graph_compressed(u);
+	assert(c->weights == NULL);
+	assert(graph_compressed_neighbours(c, 0, &it) == 0);
+	assert(graph_compressed_next(&it) == FALSE);
+	assert(graph_compressed_neighbours(c, 2, &it) == 2);
+	assert(graph_compressed_next(&it) && it.to == 0 && it.w == 1);
+	assert(graph_compressed_next(&it) && it.to == 1 && it.w == 1);
+	assert(graph_compressed_next(&it) == FALSE);
+	free_graph_compressed(c);
+	free_graph_list(u);
+
+	free_graph_list(g);
+	return 0;
+}
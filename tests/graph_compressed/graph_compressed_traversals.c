@@ -0,0 +1,60 @@
+#include <assert.h>
+#include <graph/graph_compressed.h>
+#include <prng.h>
+
+#define NODE_COUNT 300
+
+int values[NODE_COUNT], values_c[NODE_COUNT];
+int father[NODE_COUNT], father_c[NODE_COUNT];
+graph_weight_t distance[NODE_COUNT], distance_c[NODE_COUNT];
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 11);
+	// The edges are inserted by increasing successor so that the traversals
+	// of the graph_list_t visit the successors in the same order
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (unsigned a = 0; a < NODE_COUNT; a++) {
+		for (unsigned b = 0; b < NODE_COUNT; b++) {
+			if (prng_bounded(&rng, 100) < 2)
+				graph_list_set_edge(g, a, b, TRUE,
+									1 + prng_bounded(&rng, 1000), FALSE);
+		}
+	}
+	graph_compressed_t* c = graph_list_to_graph_compressed(g);
+	assert(c != NULL);
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(NODE_COUNT);
+
+	for (unsigned r = 0; r < NODE_COUNT; r += 7) {
+		int n = graph_list_bfs(g, r, values, father);
+		assert(graph_compressed_bfs_ws(c, r, values_c, father_c, ws) == n);
+		for (int i = 0; i < n; i++) {
+			assert(values[i] == values_c[i]);
+			assert(father[values[i]] == father_c[values[i]]);
+		}
+
+		n = graph_list_preorder_dfs(g, r, values, father);
+		assert(graph_compressed_preorder_dfs(c, r, values_c, father_c) == n);
+		for (int i = 0; i < n; i++) {
+			assert(values[i] == values_c[i]);
+			assert(father[values[i]] == father_c[values[i]]);
+		}
+
+		n = graph_list_dijkstra(g, r, distance, NULL);
+		assert(graph_compressed_dijkstra_ws(c, r, distance_c, father_c, ws) ==
+			   n);
+		for (unsigned i = 0; i < NODE_COUNT; i++) {
+			assert(distance[i] == distance_c[i]);
+			if (father_c[i] != -1) {
+				graph_list_edge_t* e = graph_list_get_edge(g, father_c[i], i);
+				assert(distance[father_c[i]] + e->w == distance[i]);
+			}
+		}
+	}
+	assert(graph_compressed_dijkstra(c, 0, distance_c, NULL) > 0);
+
+	free_graph_sp_workspace(ws);
+	free_graph_compressed(c);
+	free_graph_list(g);
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <assert.h>
+#include <graph/graph_dynamic_sp.h>
+#include <weight_type.h>
+
+#define NODE_COUNT 5
+
+/*
+ * 0 -1-> 1 -1-> 2 -1-> 3 -1-> 4
+ *  \___________5_______/
+ */
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (unsigned i = 0; i + 1 < NODE_COUNT; i++)
+		graph_list_set_edge(g, i, i + 1, TRUE, 1, FALSE);
+	graph_list_set_edge(g, 0, 3, TRUE, 5, FALSE);
+
+	graph_dynamic_sp_t* dsp = create_graph_dynamic_sp(g, 0);
+	assert(dsp != NULL);
+	for (unsigned i = 0; i < NODE_COUNT; i++)
+		assert(dsp->distance[i] == (graph_weight_t)i);
+
+	// Not in the shortest path tree: nothing to repair
+	assert(graph_dynamic_sp_set_edge(dsp, 0, 3, TRUE, 6, FALSE) == 0);
+
+	// Increase of a tree edge: 2, 3 and 4 are repaired
+	assert(graph_dynamic_sp_set_edge(dsp, 1, 2, TRUE, 3, FALSE) == 3);
+	assert(dsp->distance[2] == 4);
+	assert(dsp->distance[3] == 5);
+	assert(dsp->distance[4] == 6);
+
+	// Removal: 3 is now reached from 0
+	graph_dynamic_sp_set_edge(dsp, 2, 3, FALSE, 0, FALSE);
+	assert(dsp->distance[2] == 4);
+	assert(dsp->distance[3] == 6);
+	assert(dsp->father[3] == 0);
+	assert(dsp->distance[4] == 7);
+
+	// Removal of the last path to 3 and 4
+	graph_dynamic_sp_set_edge(dsp, 0, 3, FALSE, 0, FALSE);
+	assert(dsp->distance[3] == GRAPH_WEIGHT_INF);
+	assert(dsp->distance[4] == GRAPH_WEIGHT_INF);
+	assert(dsp->father[3] == -1);
+	assert(dsp->father[4] == -1);
+
+	// Insertions: 4 then 3 are reached again
+	assert(graph_dynamic_sp_set_edge(dsp, 2, 4, TRUE, 1, FALSE) == 1);
+	assert(dsp->distance[4] == 5);
+	assert(dsp->father[4] == 2);
+	assert(graph_dynamic_sp_set_edge(dsp, 3, 4, TRUE, 2, TRUE) == 1);
+	assert(dsp->distance[3] == 7);
+	assert(dsp->father[3] == 4);
+	assert(dsp->distance[4] == 5);
+
+	free_graph_dynamic_sp(dsp);
+	free_graph_list(g);
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include <assert.h>
+#include <graph/graph_dynamic_sp.h>
+#include <prng.h>
+#include <weight_type.h>
+
+#define NODE_COUNT 60
+#define EDGE_COUNT 180
+#define UPDATE_COUNT 2000
+
+graph_weight_t distance[NODE_COUNT];
+
+static void check(graph_list_t* g, graph_dynamic_sp_t* dsp) {
+	graph_list_dijkstra(g, dsp->root, distance, NULL);
+	for (unsigned v = 0; v < NODE_COUNT; v++) {
+		assert(dsp->distance[v] == distance[v]);
+		if (v == dsp->root || distance[v] == GRAPH_WEIGHT_INF) {
+			assert(dsp->father[v] == -1);
+			continue;
+		}
+		// The father should be on a shortest path
+		graph_list_edge_t* e = graph_list_get_edge(g, dsp->father[v], v);
+		assert(e != NULL);
+		assert(dsp->distance[dsp->father[v]] + e->w == distance[v]);
+	}
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 31);
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (unsigned i = 0; i < EDGE_COUNT; i++) {
+		graph_list_set_edge(g, prng_bounded(&rng, NODE_COUNT),
+							prng_bounded(&rng, NODE_COUNT), TRUE,
+							1 + prng_bounded(&rng, 20), FALSE);
+	}
+
+	graph_dynamic_sp_t* dsp = create_graph_dynamic_sp(g, 0);
+	assert(dsp != NULL);
+	check(g, dsp);
+
+	for (unsigned i = 0; i < UPDATE_COUNT; i++) {
+		const unsigned a = prng_bounded(&rng, NODE_COUNT);
+		const unsigned b = prng_bounded(&rng, NODE_COUNT);
+		// Removes a third of the time to keep the density stable
+		const BOOL val = prng_bounded(&rng, 3) != 0;
+		const graph_weight_t w = prng_bounded(&rng, 20);
+		assert(graph_dynamic_sp_set_edge(dsp, a, b, val, w, FALSE) >= 0);
+		check(g, dsp);
+	}
+
+	free_graph_dynamic_sp(dsp);
+	free_graph_list(g);
+	return 0;
+}
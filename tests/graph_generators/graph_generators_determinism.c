@@ -0,0 +1,63 @@
+#include <assert.h>
+#include <graph/graph_generators.h>
+#include <string.h>
+
+static BOOL same_edges(graph_edge_array_t* a, graph_edge_array_t* b) {
+	return a->nb_vert == b->nb_vert && a->nb_edges == b->nb_edges &&
+		   memcmp(a->edges, b->edges, a->nb_edges * sizeof(graph_edge_t)) == 0;
+}
+
+// No self loop nor duplicated edge
+static void check_simple(graph_edge_array_t* a) {
+	graph_mat_t* g = graph_edge_array_to_graph_mat(a);
+	for (size_t i = 0; i < a->nb_edges; i++) {
+		assert(a->edges[i].from < a->nb_vert);
+		assert(a->edges[i].to < a->nb_vert);
+		assert(a->edges[i].from != a->edges[i].to);
+		assert(a->edges[i].w >= 1 && a->edges[i].w <= 10);
+		assert(graph_mat_get_edge(g, a->edges[i].from, a->edges[i].to));
+		// Removes it so that a duplicate would be found missing
+		graph_mat_set_edge(g, a->edges[i].from, a->edges[i].to, FALSE, 0,
+						   FALSE);
+	}
+	free_graph_mat(g);
+}
+
+static void check(graph_edge_array_t* (*generate)(uint64_t seed)) {
+	graph_edge_array_t* a = generate(1);
+	graph_edge_array_t* b = generate(1);
+	graph_edge_array_t* c = generate(2);
+	assert(a != NULL && b != NULL && c != NULL);
+	assert(a->nb_edges > 0);
+	assert(same_edges(a, b));
+	assert(!same_edges(a, c));
+	check_simple(a);
+	check_simple(c);
+	free_graph_edge_array(a);
+	free_graph_edge_array(b);
+	free_graph_edge_array(c);
+}
+
+static graph_edge_array_t* rmat(uint64_t seed) {
+	return graph_generate_rmat(8, 2000, 0.57, 0.19, 0.19, 10, seed);
+}
+
+static graph_edge_array_t* grid(uint64_t seed) {
+	return graph_generate_grid(10, 13, 10, seed);
+}
+
+static graph_edge_array_t* gnp(uint64_t seed) {
+	return graph_generate_gnp(200, 0.05, 10, seed);
+}
+
+static graph_edge_array_t* dag(uint64_t seed) {
+	return graph_generate_dag(200, 0.05, 10, seed);
+}
+
+int main(void) {
+	check(rmat);
+	check(grid);
+	check(gnp);
+	check(dag);
+	return 0;
+}
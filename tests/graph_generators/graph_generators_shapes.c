@@ -0,0 +1,70 @@
+#include <assert.h>
+#include <errors.h>
+#include <graph/graph_generators.h>
+#include <stdlib.h>
+
+#define ROWS 7
+#define COLS 9
+
+graph_weight_t distance[ROWS * COLS];
+
+int main(void) {
+	// Unweighted grid: the distances are the Manhattan distances
+	graph_edge_array_t* a = graph_generate_grid(ROWS, COLS, 0, 3);
+	assert(a->nb_vert == ROWS * COLS);
+	assert(a->nb_edges == 2 * ((ROWS - 1) * COLS + ROWS * (COLS - 1)));
+	assert(a->is_weighted == FALSE);
+	graph_list_t* g = graph_edge_array_to_graph_list(a);
+	assert(graph_list_outdegree(g, 0) == 2);
+	assert(graph_list_outdegree(g, COLS + 1) == 4);
+	assert(graph_list_dijkstra(g, 0, distance, NULL) == ROWS * COLS);
+	for (unsigned i = 0; i < ROWS; i++) {
+		for (unsigned j = 0; j < COLS; j++)
+			assert(distance[i * COLS + j] == (graph_weight_t)(i + j));
+	}
+	free_graph_list(g);
+	free_graph_edge_array(a);
+
+	// G(n, p) has about p * n * (n - 1) edges
+	a = graph_generate_gnp(1000, 0.01, 100, 5);
+	assert(a->nb_edges > 9000 && a->nb_edges < 11000);
+	free_graph_edge_array(a);
+	a = graph_generate_gnp(20, 1, 100, 5);
+	assert(a->nb_edges == 20 * 19);
+	free_graph_edge_array(a);
+	a = graph_generate_gnp(20, 0, 100, 5);
+	assert(a->nb_edges == 0);
+	free_graph_edge_array(a);
+
+	// Random DAG
+	a = graph_generate_dag(500, 0.02, 100, 9);
+	assert(a->nb_edges > 2000 && a->nb_edges < 3000);
+	g = graph_edge_array_to_graph_list(a);
+	unsigned* num = malloc(500 * sizeof(unsigned));
+	assert(graph_list_topological_ordering(g, num, NULL) == -ERROR_NO_ERROR);
+	for (size_t i = 0; i < a->nb_edges; i++)
+		assert(num[a->edges[i].from] < num[a->edges[i].to]);
+	free(num);
+	free_graph_list(g);
+	free_graph_edge_array(a);
+
+	// R-MAT: skewed degrees, the edges are sorted
+	a = graph_generate_rmat(10, 16 * 1024, 0.57, 0.19, 0.19, 100, 1);
+	assert(a->nb_vert == 1024);
+	assert(a->nb_edges > 8 * 1024 && a->nb_edges <= 16 * 1024);
+	unsigned max_degree = 0, degree = 0;
+	for (size_t i = 0; i < a->nb_edges; i++) {
+		if (i > 0) {
+			const graph_edge_t* p = &a->edges[i - 1];
+			const graph_edge_t* e = &a->edges[i];
+			assert(p->from < e->from || (p->from == e->from && p->to < e->to));
+			degree = p->from == e->from ? degree + 1 : 1;
+		} else
+			degree = 1;
+		if (degree > max_degree)
+			max_degree = degree;
+	}
+	assert(max_degree > 10 * a->nb_edges / a->nb_vert);
+	free_graph_edge_array(a);
+	return 0;
+}
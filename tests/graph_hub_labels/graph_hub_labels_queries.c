@@ -0,0 +1,51 @@
+#include <assert.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_hub_labels.h>
+#include <stdlib.h>
+
+// Compares every distance of the oracle with Dijkstra on the weighted graph
+static void check(graph_edge_array_t* a, BOOL is_weighted) {
+	graph_list_t* reference = graph_edge_array_to_graph_list(a);
+	a->is_weighted = is_weighted;
+	graph_list_t* g = graph_edge_array_to_graph_list(a);
+	assert(reference != NULL && g != NULL);
+	graph_hub_labels_t* labels = create_graph_hub_labels(g);
+	assert(labels != NULL);
+	// Far less than the n * n entries of a distance table
+	assert(graph_hub_labels_size(labels) < (size_t)a->nb_vert * a->nb_vert);
+
+	graph_weight_t* distance = malloc(a->nb_vert * sizeof(graph_weight_t));
+	for (unsigned s = 0; s < a->nb_vert; s++) {
+		graph_list_dijkstra(reference, s, distance, NULL);
+		for (unsigned t = 0; t < a->nb_vert; t++)
+			assert(graph_hub_labels_distance(labels, s, t) == distance[t]);
+	}
+	free(distance);
+	free_graph_hub_labels(labels);
+	free_graph_list(g);
+	free_graph_list(reference);
+}
+
+int main(void) {
+	graph_edge_array_t* a = graph_generate_gnp(150, 0.03, 20, 7);
+	assert(a != NULL);
+	check(a, TRUE);
+	free_graph_edge_array(a);
+
+	a = graph_generate_rmat(8, 1200, 0.57, 0.19, 0.19, 20, 3);
+	assert(a != NULL);
+	check(a, TRUE);
+	free_graph_edge_array(a);
+
+	// BFS construction, the reference graph has unit weights
+	a = graph_generate_grid(12, 9, 1, 5);
+	assert(a != NULL);
+	check(a, FALSE);
+	free_graph_edge_array(a);
+
+	a = graph_generate_gnp(150, 0.02, 1, 11);
+	assert(a != NULL);
+	check(a, FALSE);
+	free_graph_edge_array(a);
+	return 0;
+}
@@ -0,0 +1,40 @@
+#include <assert.h>
+#include <errors.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_hub_labels.h>
+#include <stdio.h>
+
+int main(void) {
+	graph_edge_array_t* a = graph_generate_rmat(7, 600, 0.57, 0.19, 0.19, 9, 1);
+	assert(a != NULL);
+	graph_list_t* g = graph_edge_array_to_graph_list(a);
+	graph_hub_labels_t* labels = create_graph_hub_labels(g);
+	assert(labels != NULL);
+
+	FILE* file = tmpfile();
+	assert(file != NULL);
+	assert(graph_hub_labels_save(labels, file) == -ERROR_NO_ERROR);
+	rewind(file);
+	graph_hub_labels_t* loaded = graph_hub_labels_load(file);
+	assert(loaded != NULL);
+	assert(loaded->nb_vert == labels->nb_vert);
+	assert(graph_hub_labels_size(loaded) == graph_hub_labels_size(labels));
+	for (unsigned s = 0; s < a->nb_vert; s++) {
+		for (unsigned t = 0; t < a->nb_vert; t++) {
+			assert(graph_hub_labels_distance(loaded, s, t) ==
+				   graph_hub_labels_distance(labels, s, t));
+		}
+	}
+
+	// Reading from the middle of the file fails on the magic number
+	fseek(file, 4, SEEK_SET);
+	graph_hub_labels_t* invalid = graph_hub_labels_load(file);
+	assert(invalid == NULL);
+
+	fclose(file);
+	free_graph_hub_labels(loaded);
+	free_graph_hub_labels(labels);
+	free_graph_list(g);
+	free_graph_edge_array(a);
+	return 0;
+}
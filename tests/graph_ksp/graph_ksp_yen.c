@@ -0,0 +1,65 @@
+#include <assert.h>
+#include <graph/graph_ksp.h>
+#include <string.h>
+
+#define EDGE_COUNT 9
+#define NODE_COUNT 6
+#define K 8
+
+enum { C, D, E, F, G, H };
+
+const unsigned int edges[EDGE_COUNT][2] = {
+	{C, D},
+	{C, E},
+	{D, F},
+	{E, D},
+	{E, F},
+	{E, G},
+	{F, G},
+	{F, H},
+	{G, H},
+};
+
+const graph_weight_t weights[EDGE_COUNT] = {3, 2, 4, 1, 2, 3, 2, 1, 2};
+
+// Every loopless path from C to H, the paths of same cost can be returned in
+// any order
+#define PATH_COUNT 7
+const graph_weight_t expected_costs[PATH_COUNT] = {5, 7, 8, 8, 8, 11, 11};
+const unsigned expected_lengths[PATH_COUNT] = {4, 4, 4, 5, 5, 5, 6};
+const unsigned expected_paths[PATH_COUNT][6] = {
+	{C, E, F, H},	 {C, E, G, H},	  {C, D, F, H},
+	{C, E, F, G, H}, {C, E, D, F, H}, {C, D, F, G, H},
+	{C, E, D, F, G, H},
+};
+
+unsigned paths[K * NODE_COUNT], lengths[K];
+graph_weight_t costs[K];
+
+static int find_expected(unsigned i) {
+	for (int j = 0; j < PATH_COUNT; j++) {
+		if (expected_lengths[j] == lengths[i] &&
+			0 == memcmp(expected_paths[j], paths + i * NODE_COUNT,
+						lengths[i] * sizeof(unsigned)))
+			return j;
+	}
+	return -1;
+}
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (int i = 0; i < EDGE_COUNT; i++)
+		graph_list_set_edge(g, edges[i][0], edges[i][1], TRUE, weights[i],
+							FALSE);
+	assert(PATH_COUNT == graph_list_yen(g, C, H, K, paths, lengths, costs));
+	BOOL found[PATH_COUNT] = {FALSE};
+	for (unsigned i = 0; i < PATH_COUNT; i++) {
+		const int j = find_expected(i);
+		assert(j >= 0 && found[j] == FALSE);
+		found[j] = TRUE;
+		assert(expected_costs[j] == costs[i]);
+		assert(expected_costs[i] == costs[i]);
+	}
+	free_graph_list(g);
+	return 0;
+}
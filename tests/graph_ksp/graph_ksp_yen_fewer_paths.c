@@ -0,0 +1,28 @@
+#include <assert.h>
+#include <graph/graph_ksp.h>
+
+#define NODE_COUNT 4
+#define K 3
+
+unsigned paths[K * NODE_COUNT], lengths[K];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, FALSE);
+	graph_list_set_edge(g, 0, 1, TRUE, 0, FALSE);
+	graph_list_set_edge(g, 1, 2, TRUE, 0, FALSE);
+	graph_list_set_edge(g, 2, 1, TRUE, 0, FALSE);
+
+	// Only one loopless path from 0 to 2
+	assert(1 == graph_list_yen(g, 0, 2, K, paths, lengths, NULL));
+	assert(3 == lengths[0]);
+	assert(0 == paths[0] && 1 == paths[1] && 2 == paths[2]);
+
+	// 3 can't be reached
+	assert(0 == graph_list_yen(g, 0, 3, K, paths, lengths, NULL));
+
+	// The only path from a vertex to itself is the vertex alone
+	assert(1 == graph_list_yen(g, 1, 1, K, paths, lengths, NULL));
+	assert(1 == lengths[0] && 1 == paths[0]);
+	free_graph_list(g);
+	return 0;
+}
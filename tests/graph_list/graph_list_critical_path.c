@@ -0,0 +1,41 @@
+#include <assert.h>
+#include <graph/graph_list.h>
+#include <weight_type.h>
+
+#define EDGE_COUNT 7
+#define NODE_COUNT 6
+
+const unsigned int edges[EDGE_COUNT][2] = {
+	{0, 1},
+	{0, 2},
+	{1, 3},
+	{2, 3},
+	{3, 4},
+	{1, 4},
+	{5, 4},
+};
+
+const graph_weight_t weights[EDGE_COUNT] = {3, 2, 4, 6, 1, 2, 10};
+
+const graph_weight_t expected_earliest[NODE_COUNT] = {0, 3, 2, 8, 10, 0};
+const graph_weight_t expected_latest[NODE_COUNT] = {1, 5, 3, 9, 10, 0};
+const graph_weight_t expected_slack[NODE_COUNT] = {1, 2, 1, 1, 0, 0};
+
+unsigned num[NODE_COUNT], denum[NODE_COUNT];
+graph_weight_t earliest[NODE_COUNT], latest[NODE_COUNT], slack[NODE_COUNT];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (int i = 0; i < EDGE_COUNT; i++)
+		graph_list_set_edge(g, edges[i][0], edges[i][1], TRUE, weights[i],
+							FALSE);
+	assert(0 == graph_list_topological_ordering(g, num, denum));
+	assert(0 == graph_list_critical_path(g, denum, earliest, latest, slack));
+	for (int i = 0; i < NODE_COUNT; i++) {
+		assert(expected_earliest[i] == earliest[i]);
+		assert(expected_latest[i] == latest[i]);
+		assert(expected_slack[i] == slack[i]);
+	}
+	free_graph_list(g);
+	return 0;
+}
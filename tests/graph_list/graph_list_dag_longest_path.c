@@ -0,0 +1,52 @@
+#include <assert.h>
+#include <graph/graph_list.h>
+#include <weight_type.h>
+
+#define EDGE_COUNT 7
+#define NODE_COUNT 6
+
+const unsigned int edges[EDGE_COUNT][2] = {
+	{0, 1},
+	{0, 2},
+	{1, 3},
+	{2, 3},
+	{3, 4},
+	{1, 4},
+	{5, 4},
+};
+
+const graph_weight_t weights[EDGE_COUNT] = {3, 2, 4, 6, 1, 2, 10};
+
+const graph_weight_t expected[NODE_COUNT] = {0, 3, 2, 8, 9, -GRAPH_WEIGHT_INF};
+const int expected_fathers[NODE_COUNT] = {-1, 0, 0, 2, 3, -1};
+
+const unsigned sources[2] = {0, 5};
+const graph_weight_t expected_multi[NODE_COUNT] = {0, 3, 2, 8, 10, 0};
+const int expected_fathers_multi[NODE_COUNT] = {-1, 0, 0, 2, 5, -1};
+
+unsigned num[NODE_COUNT], denum[NODE_COUNT];
+graph_weight_t distance[NODE_COUNT];
+int father[NODE_COUNT];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (int i = 0; i < EDGE_COUNT; i++)
+		graph_list_set_edge(g, edges[i][0], edges[i][1], TRUE, weights[i],
+							FALSE);
+	assert(0 == graph_list_topological_ordering(g, num, denum));
+
+	assert(5 == graph_list_dag_longest_path(g, denum, 0, distance, father));
+	for (int i = 0; i < NODE_COUNT; i++) {
+		assert(expected[i] == distance[i]);
+		assert(expected_fathers[i] == father[i]);
+	}
+
+	assert(6 == graph_list_dag_longest_path_multi(g, denum, sources, 2,
+												  distance, father));
+	for (int i = 0; i < NODE_COUNT; i++) {
+		assert(expected_multi[i] == distance[i]);
+		assert(expected_fathers_multi[i] == father[i]);
+	}
+	free_graph_list(g);
+	return 0;
+}
@@ -0,0 +1,27 @@
+#include <assert.h>
+#include <graph/graph_msbfs.h>
+#include <stdlib.h>
+
+// More sources than a batch so that several batches are run
+#define NODE_COUNT (GRAPH_MSBFS_BATCH + 45)
+
+unsigned sources[NODE_COUNT];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, FALSE);
+	for (unsigned i = 0; i < NODE_COUNT; i++) {
+		graph_list_set_edge(g, i, (i + 1) % NODE_COUNT, TRUE, 0, FALSE);
+		sources[i] = i;
+	}
+	int* distance = malloc(NODE_COUNT * NODE_COUNT * sizeof(int));
+	assert(0 == graph_list_msbfs(g, sources, NODE_COUNT, distance));
+	for (unsigned s = 0; s < NODE_COUNT; s++) {
+		for (unsigned v = 0; v < NODE_COUNT; v++) {
+			const int expected = (v + NODE_COUNT - s) % NODE_COUNT;
+			assert(expected == distance[s * NODE_COUNT + v]);
+		}
+	}
+	free(distance);
+	free_graph_list(g);
+	return 0;
+}
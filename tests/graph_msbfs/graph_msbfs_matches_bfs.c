@@ -0,0 +1,46 @@
+#include <assert.h>
+#include <graph/graph_msbfs.h>
+
+#define EDGE_COUNT 9
+#define NODE_COUNT 7
+#define SOURCE_COUNT 4
+
+const unsigned int edges[EDGE_COUNT][2] = {
+	{0, 1},
+	{0, 2},
+	{1, 2},
+	{2, 0},
+	{2, 3},
+	{3, 3},
+	{3, 4},
+	{4, 1},
+	{6, 5},
+};
+
+const unsigned sources[SOURCE_COUNT] = {1, 6, 5, 1};
+
+int tab[NODE_COUNT], father[NODE_COUNT];
+int distance[SOURCE_COUNT * NODE_COUNT];
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, FALSE);
+	for (int i = 0; i < EDGE_COUNT; i++)
+		graph_list_set_edge(g, edges[i][0], edges[i][1], TRUE, 0, FALSE);
+	assert(0 == graph_list_msbfs(g, sources, SOURCE_COUNT, distance));
+
+	for (unsigned s = 0; s < SOURCE_COUNT; s++) {
+		int expected[NODE_COUNT];
+		for (unsigned i = 0; i < NODE_COUNT; i++)
+			expected[i] = -1;
+		int count = graph_list_bfs(g, sources[s], tab, father);
+		// tab is ordered by level so the father's distance is already known
+		for (int i = 0; i < count; i++) {
+			const int f = father[tab[i]];
+			expected[tab[i]] = f == -1 ? 0 : expected[f] + 1;
+		}
+		for (unsigned i = 0; i < NODE_COUNT; i++)
+			assert(expected[i] == distance[s * NODE_COUNT + i]);
+	}
+	free_graph_list(g);
+	return 0;
+}
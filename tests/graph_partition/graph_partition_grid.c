@@ -0,0 +1,44 @@
+#include <assert.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_partition.h>
+#include <stdlib.h>
+
+#define SIDE 40
+#define NODE_COUNT (SIDE * SIDE)
+
+unsigned part[NODE_COUNT];
+
+static void check(graph_list_t* g, unsigned k, size_t max_cut) {
+	assert(graph_list_partition(g, k, 0.05, 1, part) == 0);
+	unsigned weight[8] = {0};
+	for (unsigned v = 0; v < g->nb_vert; v++) {
+		assert(part[v] < k);
+		weight[part[v]]++;
+	}
+	const unsigned max_weight = (unsigned)(1.05 * g->nb_vert / k) + 1;
+	for (unsigned q = 0; q < k; q++)
+		assert(weight[q] > 0 && weight[q] <= max_weight);
+	assert(graph_list_edge_cut(g, part) <= max_cut);
+}
+
+int main(void) {
+	graph_edge_array_t* a = graph_generate_grid(SIDE, SIDE, 1, 1);
+	assert(a != NULL);
+	graph_list_t* g = graph_edge_array_to_graph_list(a);
+	assert(g != NULL);
+	// Cutting the grid in strips or blocks cuts 2 * SIDE edges per border
+	check(g, 2, 2 * (2 * SIDE));
+	check(g, 4, 2 * (6 * SIDE));
+	check(g, 8, 2 * (14 * SIDE));
+	free_graph_list(g);
+	free_graph_edge_array(a);
+
+	// A random graph has no small cut but the balance is still met
+	a = graph_generate_rmat(10, 8000, 0.57, 0.19, 0.19, 1, 2);
+	assert(a != NULL);
+	g = graph_edge_array_to_graph_list(a);
+	check(g, 8, a->nb_edges);
+	free_graph_list(g);
+	free_graph_edge_array(a);
+	return 0;
+}
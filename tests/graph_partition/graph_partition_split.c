@@ -0,0 +1,47 @@
+#include <assert.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_partition.h>
+#include <stdlib.h>
+
+#define K 3
+
+int main(void) {
+	graph_edge_array_t* a = graph_generate_gnp(300, 0.02, 10, 4);
+	assert(a != NULL);
+	graph_list_t* g = graph_edge_array_to_graph_list(a);
+	unsigned* part = malloc(g->nb_vert * sizeof(unsigned));
+	assert(graph_list_partition(g, K, 0.03, 9, part) == 0);
+	graph_subgraph_t* s = graph_list_split(g, part, K);
+	assert(s != NULL);
+
+	unsigned owned = 0;
+	size_t edges = 0, ghost_edges = 0;
+	for (unsigned q = 0; q < K; q++) {
+		assert(s[q].g != NULL);
+		owned += s[q].nb_owned;
+		for (unsigned v = 0; v < s[q].g->nb_vert; v++) {
+			const unsigned global = s[q].global[v];
+			// Owned vertices first, ghosts after
+			assert((part[global] == q) == (v < s[q].nb_owned));
+			if (v > 0 && v < s[q].nb_owned)
+				assert(s[q].global[v - 1] < global);
+			foreach_node(&s[q].g->neighbours[v], e, graph_list_edge_t) {
+				assert(v < s[q].nb_owned);
+				graph_list_edge_t* original =
+					graph_list_get_edge(g, global, s[q].global[e->to]);
+				assert(original != NULL && original->w == e->w);
+				edges++;
+				ghost_edges += e->to >= s[q].nb_owned;
+			}
+		}
+	}
+	assert(owned == g->nb_vert);
+	assert(edges == a->nb_edges);
+	assert(ghost_edges == graph_list_edge_cut(g, part));
+
+	free_graph_subgraphs(s, K);
+	free(part);
+	free_graph_list(g);
+	free_graph_edge_array(a);
+	return 0;
+}
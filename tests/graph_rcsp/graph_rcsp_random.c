@@ -0,0 +1,99 @@
+#include <assert.h>
+#include <graph/graph_cast.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_rcsp.h>
+#include <prng.h>
+#include <stdlib.h>
+
+#define NODE_COUNT 10
+#define GRAPH_COUNT 40
+
+graph_weight_t resource[NODE_COUNT * NODE_COUNT];
+unsigned path[NODE_COUNT];
+BOOL on_path[NODE_COUNT];
+
+// Cheapest simple path within the budget by exhaustive search
+static graph_weight_t brute_force(graph_csr_t* g,
+								  unsigned v,
+								  unsigned dst,
+								  graph_weight_t cost,
+								  graph_weight_t used,
+								  graph_weight_t budget) {
+	if (used > budget)
+		return GRAPH_WEIGHT_INF;
+	if (v == dst)
+		return cost;
+	graph_weight_t best = GRAPH_WEIGHT_INF;
+	on_path[v] = TRUE;
+	for (size_t i = g->offset[v]; i < g->offset[v + 1]; i++) {
+		if (on_path[g->to[i]])
+			continue;
+		const graph_weight_t c =
+			brute_force(g, g->to[i], dst, cost + g->weights[i],
+						used + resource[i], budget);
+		best = MIN(best, c);
+	}
+	on_path[v] = FALSE;
+	return best;
+}
+
+// The path should follow edges of g and match its cost and resource
+static void check_path(graph_csr_t* g,
+					   int length,
+					   unsigned src,
+					   unsigned dst,
+					   graph_weight_t cost,
+					   graph_weight_t used) {
+	assert(path[0] == src && path[length - 1] == dst);
+	graph_weight_t c = 0, r = 0;
+	for (int k = 0; k + 1 < length; k++) {
+		size_t i = g->offset[path[k]];
+		while (i < g->offset[path[k] + 1] && g->to[i] != path[k + 1])
+			i++;
+		assert(i < g->offset[path[k] + 1]);
+		c += g->weights[i];
+		r += resource[i];
+	}
+	assert(c == cost && r == used);
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 17);
+	for (unsigned seed = 0; seed < GRAPH_COUNT; seed++) {
+		graph_edge_array_t* a = graph_generate_gnp(NODE_COUNT, 0.35, 20, seed);
+		graph_list_t* l = graph_edge_array_to_graph_list(a);
+		graph_csr_t* g = graph_list_to_graph_csr(l, 1);
+		assert(g != NULL);
+		for (size_t i = 0; i < g->nb_edges; i++)
+			resource[i] = prng_bounded(&rng, 20);
+		const unsigned src = prng_bounded(&rng, NODE_COUNT);
+		const unsigned dst = prng_bounded(&rng, NODE_COUNT);
+		for (graph_weight_t budget = 0; budget < 60; budget += 6) {
+			const graph_weight_t expected =
+				brute_force(g, src, dst, 0, 0, budget);
+			graph_weight_t cost, used;
+			int length = graph_csr_rcsp(g, resource, src, dst, budget, 0, path,
+										&cost, &used);
+			assert(length >= 0);
+			assert((length == 0) == (expected == GRAPH_WEIGHT_INF));
+			if (length > 0) {
+				assert(cost == expected && used <= budget);
+				check_path(g, length, src, dst, cost, used);
+			}
+
+			// With two labels per vertex the path is feasible but may cost more
+			length = graph_csr_rcsp(g, resource, src, dst, budget, 2, path,
+									&cost, &used);
+			assert(length >= 0);
+			if (length > 0) {
+				assert(cost >= expected && used <= budget);
+				check_path(g, length, src, dst, cost, used);
+			}
+		}
+		free_graph_csr(g);
+		free_graph_list(l);
+		free_graph_edge_array(a);
+	}
+	return 0;
+}
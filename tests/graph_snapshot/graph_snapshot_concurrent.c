@@ -0,0 +1,68 @@
+#include <assert.h>
+#include <graph/graph_snapshot.h>
+#include <pthread.h>
+
+#define NODE_COUNT 300
+#define READER_COUNT 3
+#define VERSION_COUNT 400
+
+graph_versioned_t* gv;
+int done = 0;
+
+/**
+ * Every version v is a ring whose edges all weigh v: a reader seeing edges of
+ * different versions would find an inconsistent distance
+ */
+static void* reader(void* arg) {
+	const unsigned slot = *(unsigned*)arg;
+	graph_weight_t distance[NODE_COUNT];
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(NODE_COUNT);
+	assert(ws != NULL);
+	unsigned last = 0;
+	while (!__atomic_load_n(&done, __ATOMIC_ACQUIRE)) {
+		const graph_snapshot_t* s = graph_versioned_acquire(gv, slot);
+		assert(s->version >= last);
+		last = s->version;
+		for (unsigned v = 0; v < NODE_COUNT; v++)
+			assert(graph_snapshot_edges(s, v)->edges[0].w ==
+				   (graph_weight_t)s->version);
+		graph_snapshot_dijkstra_ws(s, 0, distance, NULL, ws);
+		assert(distance[NODE_COUNT - 1] ==
+			   (graph_weight_t)s->version * (NODE_COUNT - 1));
+		graph_versioned_release(gv, slot);
+	}
+	free_graph_sp_workspace(ws);
+	return NULL;
+}
+
+int main(void) {
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	for (unsigned v = 0; v < NODE_COUNT; v++)
+		graph_list_set_edge(g, v, (v + 1) % NODE_COUNT, TRUE, 0, FALSE);
+	gv = create_graph_versioned(g, READER_COUNT);
+	assert(gv != NULL);
+
+	pthread_t threads[READER_COUNT];
+	unsigned slots[READER_COUNT];
+	for (unsigned i = 0; i < READER_COUNT; i++) {
+		slots[i] = i;
+		assert(pthread_create(&threads[i], NULL, reader, &slots[i]) == 0);
+	}
+	for (unsigned version = 1; version <= VERSION_COUNT; version++) {
+		for (unsigned v = 0; v < NODE_COUNT; v++) {
+			graph_versioned_set_edge(gv, v, (v + 1) % NODE_COUNT, TRUE,
+									 version, FALSE);
+		}
+		assert(graph_versioned_publish(gv) == (int)version);
+	}
+	__atomic_store_n(&done, 1, __ATOMIC_RELEASE);
+	for (unsigned i = 0; i < READER_COUNT; i++)
+		pthread_join(threads[i], NULL);
+
+	// Every replaced version is freed once the readers are gone
+	graph_versioned_publish(gv);
+	assert(graph_versioned_nb_retired(gv) == 0);
+	free_graph_versioned(gv);
+	free_graph_list(g);
+	return 0;
+}
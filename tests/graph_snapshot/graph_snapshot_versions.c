@@ -0,0 +1,73 @@
+#include <assert.h>
+#include <graph/graph_snapshot.h>
+#include <prng.h>
+
+#define NODE_COUNT 150
+#define UPDATE_COUNT 300
+
+graph_weight_t expected[NODE_COUNT];
+graph_weight_t distance[NODE_COUNT];
+
+// The version should be the same graph as g
+static void check(graph_list_t* g,
+				  const graph_snapshot_t* s,
+				  graph_sp_workspace_t* ws) {
+	for (unsigned v = 0; v < NODE_COUNT; v++) {
+		graph_list_dijkstra(g, v, expected, NULL);
+		graph_snapshot_dijkstra_ws(s, v, distance, NULL, ws);
+		for (unsigned t = 0; t < NODE_COUNT; t++)
+			assert(distance[t] == expected[t]);
+	}
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 5);
+	graph_list_t* g = create_graph_list(NODE_COUNT, TRUE);
+	graph_list_set_edge(g, 0, 1, TRUE, 4, FALSE);
+	graph_versioned_t* gv = create_graph_versioned(g, 2);
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(NODE_COUNT);
+	assert(gv != NULL && ws != NULL);
+
+	const graph_snapshot_t* first = graph_versioned_acquire(gv, 0);
+	assert(first->version == 0);
+	assert(graph_snapshot_get_edge(first, 0, 1)->w == 4);
+
+	// The modifications are only visible after the publication
+	assert(graph_versioned_set_edge(gv, 0, 1, TRUE, 7, TRUE) == 0);
+	assert(graph_versioned_acquire(gv, 1) == first);
+	graph_versioned_release(gv, 1);
+	assert(graph_versioned_publish(gv) == 1);
+	const graph_snapshot_t* second = graph_versioned_acquire(gv, 1);
+	assert(graph_snapshot_get_edge(second, 0, 1)->w == 7);
+	assert(graph_snapshot_get_edge(second, 1, 0)->w == 7);
+	// The first version is unchanged while the reader holds it
+	assert(graph_snapshot_get_edge(first, 0, 1)->w == 4);
+	assert(graph_snapshot_get_edge(first, 1, 0) == NULL);
+	assert(graph_versioned_nb_retired(gv) == 1);
+	graph_versioned_release(gv, 0);
+	graph_versioned_release(gv, 1);
+	assert(graph_versioned_publish(gv) == 1);
+	assert(graph_versioned_nb_retired(gv) == 0);
+
+	graph_list_set_edge(g, 0, 1, TRUE, 7, TRUE);
+	for (unsigned i = 0; i < UPDATE_COUNT; i++) {
+		const unsigned a = prng_bounded(&rng, NODE_COUNT);
+		const unsigned b = prng_bounded(&rng, NODE_COUNT);
+		const BOOL val = prng_bounded(&rng, 4) != 0;
+		const graph_weight_t w = 1 + prng_bounded(&rng, 30);
+		graph_list_set_edge(g, a, b, val, w, FALSE);
+		assert(graph_versioned_set_edge(gv, a, b, val, w, FALSE) == 0);
+		if (i % 50 == 49) {
+			graph_versioned_publish(gv);
+			const graph_snapshot_t* s = graph_versioned_acquire(gv, 0);
+			check(g, s, ws);
+			graph_versioned_release(gv, 0);
+		}
+	}
+
+	free_graph_sp_workspace(ws);
+	free_graph_versioned(gv);
+	free_graph_list(g);
+	return 0;
+}
@@ -0,0 +1,32 @@
+#include <assert.h>
+#include <graph/graph_typed.h>
+
+int main(void) {
+	assert(weight_add_saturate_i32(2, 3) == 5);
+	assert(weight_add_saturate_i32(-2, 3) == 1);
+	assert(weight_add_saturate_i32(INT32_MAX, 1) == INT32_MAX);
+	assert(weight_add_saturate_i32(INT32_MAX, INT32_MAX) == INT32_MAX);
+	assert(weight_add_saturate_i32(INT32_MAX, -1) == INT32_MAX);
+	// An overflowing sum of finite weights is not the infinity
+	assert(weight_add_saturate_i32(INT32_MAX - 5, 10) == INT32_MAX - 1);
+	assert(weight_add_saturate_i32(INT32_MAX - 1, 1) == INT32_MAX - 1);
+	assert(weight_add_saturate_i32(INT32_MAX - 2, 1) == INT32_MAX - 1);
+	assert(weight_add_saturate_i32(INT32_MIN, -1) == -(INT32_MAX - 1));
+	assert(weight_add_saturate_i32(INT32_MIN + 5, -10) == -(INT32_MAX - 1));
+
+	assert(weight_add_saturate_i64(2, 3) == 5);
+	assert(weight_add_saturate_i64(INT64_MAX, 1) == INT64_MAX);
+	assert(weight_add_saturate_i64(INT64_MAX / 2 + 1, INT64_MAX / 2 + 1) ==
+		   INT64_MAX - 1);
+	assert(weight_add_saturate_i64(INT64_MIN, INT64_MIN) == -(INT64_MAX - 1));
+	assert(weight_add_saturate_i64(INT64_MIN, INT64_MAX) == INT64_MAX);
+	assert(weight_add_saturate_i64(-5, INT64_MAX - 1) == INT64_MAX - 6);
+
+	assert(weight_add_saturate_f32(0.5f, 0.25f) == 0.75f);
+	assert(weight_add_saturate_f32(GRAPH_WEIGHT_INF_f32, 1.0f) ==
+		   GRAPH_WEIGHT_INF_f32);
+	assert(weight_add_saturate_f64(GRAPH_WEIGHT_INF_f64, -1e300) ==
+		   GRAPH_WEIGHT_INF_f64);
+	assert(weight_add_saturate_f64(1e308, 1e308) == GRAPH_WEIGHT_INF_f64);
+	return 0;
+}
@@ -0,0 +1,183 @@
+#include <assert.h>
+#include <errors.h>
+#include <graph/graph_generators.h>
+#include <graph/graph_list.h>
+#include <graph/graph_typed.h>
+#include <graph/graph_workspace.h>
+#include <stdlib.h>
+
+#define NODE_COUNT 200
+
+/*
+ * Builds the same graph for a weight type and checks that its shortest paths
+ * are the ones of the graph_weight_t graph
+ */
+#define CHECK_TYPED(sfx, type)                                          \
+	do {                                                                \
+		graph_list_##sfx##_t* l = create_graph_list_##sfx(n, TRUE);     \
+		graph_mat_##sfx##_t* m = create_graph_mat_##sfx(n, TRUE);       \
+		for (size_t i = 0; i < edges->nb_edges; i++) {                  \
+			const graph_edge_t* e = &edges->edges[i];                   \
+			graph_list_##sfx##_set_edge(l, e->from, e->to, TRUE,        \
+										(type)e->w, FALSE);             \
+			graph_mat_##sfx##_set_edge(m, e->from, e->to, TRUE,         \
+									   (type)e->w, FALSE);              \
+		}                                                               \
+		type* d = malloc(n * sizeof(type));                             \
+		assert(graph_list_dijkstra_##sfx(l, 0, d, father) == reached);  \
+		for (unsigned v = 0; v < n; v++)                                \
+			assert(expected[v] == GRAPH_WEIGHT_INF                      \
+					   ? d[v] == GRAPH_WEIGHT_INF_##sfx                 \
+					   : d[v] == (type)expected[v]);                    \
+		assert(graph_mat_dijkstra_##sfx(m, 0, d, father) == reached);   \
+		for (unsigned v = 0; v < n; v++)                                \
+			assert(expected[v] == GRAPH_WEIGHT_INF                      \
+					   ? d[v] == GRAPH_WEIGHT_INF_##sfx                 \
+					   : d[v] == (type)expected[v]);                    \
+		assert(graph_list_ford_##sfx(l, 0, d, father) == 0);            \
+		for (unsigned v = 0; v < n; v++)                                \
+			assert(expected[v] == GRAPH_WEIGHT_INF                      \
+					   ? d[v] == GRAPH_WEIGHT_INF_##sfx                 \
+					   : d[v] == (type)expected[v]);                    \
+		assert(graph_mat_ford_##sfx(m, 0, d, father) == 0);             \
+		for (unsigned v = 0; v < n; v++)                                \
+			assert(expected[v] == GRAPH_WEIGHT_INF                      \
+					   ? d[v] == GRAPH_WEIGHT_INF_##sfx                 \
+					   : d[v] == (type)expected[v]);                    \
+		assert(graph_list_dijkstra_ws_##sfx(l, 0, d, father, ws) ==     \
+			   reached);                                                \
+		for (unsigned v = 0; v < n; v++)                                \
+			assert(expected[v] == GRAPH_WEIGHT_INF                      \
+					   ? d[v] == GRAPH_WEIGHT_INF_##sfx                 \
+					   : d[v] == (type)expected[v]);                    \
+		assert(graph_mat_ford_dantzig_ws_##sfx(m, 0, d, father, &cycle, \
+											  ws) == reached);          \
+		for (unsigned v = 0; v < n; v++)                                \
+			assert(expected[v] == GRAPH_WEIGHT_INF                      \
+					   ? d[v] == GRAPH_WEIGHT_INF_##sfx                 \
+					   : d[v] == (type)expected[v]);                    \
+		free(d);                                                        \
+		free_graph_mat_##sfx(m);                                        \
+		free_graph_list_##sfx(l);                                       \
+	} while (0)
+
+/*
+ * Checks Bellman and Ford-Dantzig on a DAG with negative weights whose vertex
+ * 5 is not reachable from 0, then on the same graph with an absorbing circuit
+ * 2 -> 1 -> 3 -> 4 -> 2
+ */
+#define CHECK_NEGATIVE(rep, sfx, type)                                      \
+	do {                                                                    \
+		graph_##rep##_##sfx##_t* g = create_graph_##rep##_##sfx(6, TRUE);   \
+		for (unsigned i = 0; i < sizeof(dag) / sizeof(dag[0]); i++)         \
+			graph_##rep##_##sfx##_set_edge(g, dag[i][0], dag[i][1], TRUE,   \
+										   (type)dag[i][2], FALSE);         \
+		type d[6];                                                          \
+		int father[6];                                                      \
+		int cycle = -1;                                                     \
+		assert(graph_##rep##_bellman_##sfx(g, 0, d, father) == 0);          \
+		for (unsigned v = 0; v < 5; v++)                                    \
+			assert(d[v] == (type)dag_distance[v] &&                         \
+				   father[v] == dag_father[v]);                             \
+		assert(d[5] == GRAPH_WEIGHT_INF_##sfx && father[5] == -1);          \
+		assert(graph_##rep##_bellman_ws_##sfx(g, 0, d, father, ws) == 0);   \
+		for (unsigned v = 0; v < 5; v++)                                    \
+			assert(d[v] == (type)dag_distance[v]);                          \
+		assert(graph_##rep##_ford_dantzig_##sfx(g, 0, d, father, &cycle) == \
+			   5);                                                          \
+		for (unsigned v = 0; v < 5; v++)                                    \
+			assert(d[v] == (type)dag_distance[v] &&                         \
+				   father[v] == dag_father[v]);                             \
+		assert(d[5] == GRAPH_WEIGHT_INF_##sfx && father[5] == -1);          \
+		graph_##rep##_##sfx##_set_edge(g, 4, 2, TRUE, 1, FALSE);            \
+		assert(graph_##rep##_bellman_ws_##sfx(g, 0, d, father, ws) ==       \
+			   -ERROR_GRAPH_SHOULDBE_DAG);                                  \
+		assert(graph_##rep##_ford_##sfx(g, 0, d, father) ==                 \
+			   -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT);                         \
+		assert(graph_##rep##_ford_dantzig_ws_##sfx(g, 0, d, father, &cycle, \
+												   ws) ==                   \
+			   -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT);                         \
+		assert(cycle >= 1 && cycle <= 4);                                   \
+		free_graph_##rep##_##sfx(g);                                        \
+	} while (0)
+
+/*
+ * The distance of 2 and 3 overflows: they stay reached, at the largest finite
+ * distance, instead of being taken for unreached vertices
+ */
+#define CHECK_OVERFLOW(rep, sfx, type, max)                               \
+	do {                                                                  \
+		graph_##rep##_##sfx##_t* g = create_graph_##rep##_##sfx(4, TRUE); \
+		graph_##rep##_##sfx##_set_edge(g, 0, 1, TRUE, max - 1, FALSE);    \
+		graph_##rep##_##sfx##_set_edge(g, 1, 2, TRUE, 5, FALSE);          \
+		graph_##rep##_##sfx##_set_edge(g, 2, 3, TRUE, 1, FALSE);          \
+		type d[4];                                                        \
+		int father[4];                                                    \
+		assert(graph_##rep##_dijkstra_##sfx(g, 0, d, father) == 4);       \
+		assert(d[2] == max - 1 && father[2] == 1);                        \
+		assert(d[3] == max - 1 && father[3] == 2);                        \
+		assert(graph_##rep##_ford_##sfx(g, 0, d, father) == 0);           \
+		assert(d[2] == max - 1 && father[2] == 1);                        \
+		assert(d[3] == max - 1 && father[3] == 2);                        \
+		free_graph_##rep##_##sfx(g);                                      \
+	} while (0)
+
+static const int dag[][3] = {{0, 1, 4}, {0, 2, 1},  {2, 1, -2}, {1, 3, 1},
+							 {2, 3, 5}, {3, 4, -3}, {5, 0, 2}};
+static const int dag_distance[] = {0, -1, 1, 0, -3};
+static const int dag_father[] = {-1, 2, 0, 1, 3};
+
+int main(void) {
+	graph_edge_array_t* edges = graph_generate_gnp(NODE_COUNT, 0.02, 50, 11);
+	graph_list_t* g = graph_edge_array_to_graph_list(edges);
+	const unsigned n = NODE_COUNT;
+	graph_weight_t* expected = malloc(n * sizeof(graph_weight_t));
+	int* father = malloc(n * sizeof(int));
+	const int reached = graph_list_dijkstra(g, 0, expected, father);
+	assert(reached > 1);
+	// The same workspace is used by every weight type and representation
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(n);
+	int cycle;
+
+	CHECK_TYPED(i32, int32_t);
+	CHECK_TYPED(i64, int64_t);
+	CHECK_TYPED(f32, float);
+	CHECK_TYPED(f64, double);
+
+	CHECK_NEGATIVE(list, i32, int32_t);
+	CHECK_NEGATIVE(mat, i64, int64_t);
+	CHECK_NEGATIVE(list, f32, float);
+	CHECK_NEGATIVE(mat, f64, double);
+
+	CHECK_OVERFLOW(list, i32, int32_t, INT32_MAX);
+	CHECK_OVERFLOW(mat, i32, int32_t, INT32_MAX);
+	CHECK_OVERFLOW(list, i64, int64_t, INT64_MAX);
+	CHECK_OVERFLOW(mat, i64, int64_t, INT64_MAX);
+
+	// Fractional and negative weights in the same program
+	graph_list_f64_t* l = create_graph_list_f64(3, TRUE);
+	graph_list_f64_set_edge(l, 0, 1, TRUE, 0.5, FALSE);
+	graph_list_f64_set_edge(l, 1, 2, TRUE, 0.25, FALSE);
+	graph_list_f64_set_edge(l, 0, 2, TRUE, 1.0, FALSE);
+	double d[3];
+	assert(graph_list_dijkstra_f64(l, 0, d, father) == 3);
+	assert(d[2] == 0.75 && father[2] == 1);
+	graph_list_f64_set_edge(l, 0, 2, TRUE, -1.0, FALSE);
+	assert(graph_list_ford_f64(l, 0, d, father) == 0);
+	assert(d[2] == -1.0 && father[2] == 0);
+	free_graph_list_f64(l);
+
+	graph_mat_i32_t* m = create_graph_mat_i32(2, TRUE);
+	graph_mat_i32_set_edge(m, 0, 1, TRUE, -3, TRUE);
+	int32_t di[2];
+	assert(graph_mat_ford_i32(m, 0, di, father) ==
+		   -ERROR_GRAPH_HAS_ABSORBING_CIRCUIT);
+	free_graph_mat_i32(m);
+
+	free_graph_sp_workspace(ws);
+	free(father);
+	free(expected);
+	free_graph_list(g);
+	free_graph_edge_array(edges);
+	return 0;
+}
@@ -0,0 +1,8 @@
+#include <graph/graph_list.h>
+
+#define GRAPH_T graph_list_t
+#define GRAPH(name) graph_list_##name
+#define CREATE_GRAPH create_graph_list
+#define FREE_GRAPH free_graph_list
+
+#include "workspace_reuse.h"
@@ -0,0 +1,8 @@
+#include <graph/graph_mat.h>
+
+#define GRAPH_T graph_mat_t
+#define GRAPH(name) graph_mat_##name
+#define CREATE_GRAPH create_graph_mat
+#define FREE_GRAPH free_graph_mat
+
+#include "workspace_reuse.h"
@@ -0,0 +1,186 @@
+/*
+ * Template of the workspace tests of graph_list_t and graph_mat_t, the test
+ * including it defines:
+ * - GRAPH_T the graph type
+ * - GRAPH(name) the function name of the graph type
+ * - CREATE_GRAPH and FREE_GRAPH its constructor and destructor
+ */
+#include <assert.h>
+#include <errors.h>
+#include <graph/graph_workspace.h>
+#include <limits.h>
+#include <weight_type.h>
+
+#define NODE_COUNT 6
+#define EDGE_COUNT 8
+#define X GRAPH_WEIGHT_INF
+
+// A DAG, the edge (4, 5) added afterwards creates cycles
+const unsigned edges[EDGE_COUNT + 1][3] = {
+	{0, 1, 4}, {0, 2, 1}, {2, 1, 2}, {1, 3, 1}, {2, 3, 5},
+	{3, 4, 3}, {2, 4, 7}, {5, 0, 2}, {4, 5, 1},
+};
+
+// Distance from each root to each vertex without and with the edge (4, 5)
+const graph_weight_t expected_dag[NODE_COUNT][NODE_COUNT] = {
+	{0, 3, 1, 4, 7, X}, {X, 0, X, 1, 4, X}, {X, 2, 0, 3, 6, X},
+	{X, X, X, 0, 3, X}, {X, X, X, X, 0, X}, {2, 5, 3, 6, 9, 0},
+};
+const graph_weight_t expected_cyclic[NODE_COUNT][NODE_COUNT] = {
+	{0, 3, 1, 4, 7, 8}, {7, 0, 8, 1, 4, 5}, {9, 2, 0, 3, 6, 7},
+	{6, 9, 7, 0, 3, 4}, {3, 6, 4, 7, 0, 1}, {2, 5, 3, 6, 9, 0},
+};
+
+graph_weight_t weight[NODE_COUNT][NODE_COUNT];
+graph_weight_t distance[NODE_COUNT];
+int father[NODE_COUNT], values[NODE_COUNT];
+unsigned num[NODE_COUNT];
+int cycle;
+
+static unsigned reached(const graph_weight_t* expected) {
+	unsigned count = 0;
+	for (unsigned v = 0; v < NODE_COUNT; v++)
+		count += expected[v] != X;
+	return count;
+}
+
+// Every vertex reached but r comes from an edge of the graph
+static void check_father(unsigned r, const graph_weight_t* expected) {
+	assert(father[r] == -1);
+	for (unsigned v = 0; v < NODE_COUNT; v++) {
+		if (v == r || expected[v] == X)
+			continue;
+		assert(father[v] >= 0 && weight[father[v]][v] != 0);
+	}
+}
+
+// The shortest path tree is made of edges of the shortest paths
+static void check_distance(int ret,
+						   unsigned r,
+						   const graph_weight_t* expected) {
+	assert(ret >= 0);
+	check_father(r, expected);
+	for (unsigned v = 0; v < NODE_COUNT; v++) {
+		assert(distance[v] == expected[v]);
+		if (v != r && expected[v] != X)
+			assert(expected[father[v]] + weight[father[v]][v] == expected[v]);
+	}
+}
+
+// The traversal visits every vertex reached once, a vertex after its father
+// unless post is TRUE
+static void check_traversal(int ret,
+							unsigned r,
+							const graph_weight_t* expected,
+							BOOL post) {
+	assert(ret == (int)reached(expected));
+	check_father(r, expected);
+	int position[NODE_COUNT];
+	for (unsigned v = 0; v < NODE_COUNT; v++)
+		position[v] = -1;
+	for (int i = 0; i < ret; i++) {
+		assert(expected[values[i]] != X && position[values[i]] == -1);
+		position[values[i]] = i;
+	}
+	for (unsigned v = 0; v < NODE_COUNT; v++) {
+		if (v != r && expected[v] != X)
+			assert((position[father[v]] < position[v]) != post);
+	}
+}
+
+static void check_all_roots(GRAPH_T* g,
+							graph_sp_workspace_t* ws,
+							const graph_weight_t (*expected)[NODE_COUNT],
+							BOOL is_dag) {
+	for (unsigned r = 0; r < NODE_COUNT; r++) {
+		const graph_weight_t* e = expected[r];
+		check_traversal(GRAPH(bfs_ws)(g, r, values, father, ws), r, e, FALSE);
+		check_traversal(GRAPH(preorder_dfs_ws)(g, r, values, father, ws), r, e,
+						FALSE);
+		check_traversal(GRAPH(postorder_dfs_ws)(g, r, values, father, ws), r,
+						e, TRUE);
+		check_distance(GRAPH(dijkstra_ws)(g, r, distance, father, ws), r, e);
+		check_distance(GRAPH(ford_ws)(g, r, distance, father, ws), r, e);
+		check_distance(
+			GRAPH(ford_dantzig_ws)(g, r, distance, father, &cycle, ws), r, e);
+		if (is_dag)
+			check_distance(GRAPH(bellman_ws)(g, r, distance, father, ws), r,
+						   e);
+	}
+	if (is_dag) {
+		assert(GRAPH(topological_ordering_ws)(g, num, NULL, ws) ==
+			   -ERROR_NO_ERROR);
+		for (unsigned i = 0; i < EDGE_COUNT; i++)
+			assert(num[edges[i][0]] < num[edges[i][1]]);
+	}
+}
+
+// The wrappers allocating their workspace give the same results
+static void check_wrappers(GRAPH_T* g) {
+	const graph_weight_t* e = expected_dag[5];
+	check_traversal(GRAPH(bfs)(g, 5, values, father), 5, e, FALSE);
+	check_traversal(GRAPH(preorder_dfs)(g, 5, values, father), 5, e, FALSE);
+	check_traversal(GRAPH(postorder_dfs)(g, 5, values, father), 5, e, TRUE);
+	check_distance(GRAPH(dijkstra)(g, 5, distance, father), 5, e);
+	check_distance(GRAPH(ford)(g, 5, distance, father), 5, e);
+	check_distance(GRAPH(bellman)(g, 5, distance, father), 5, e);
+	check_distance(GRAPH(ford_dantzig)(g, 5, distance, father, &cycle), 5, e);
+	assert(GRAPH(topological_ordering)(g, num, NULL) == -ERROR_NO_ERROR);
+}
+
+/*
+ * Ford-Dantzig corrects the distances given by Dijkstra with the waiting list
+ * of the workspace: the edge (2, 1) shortens the paths to 1 and 3. The list
+ * should be empty afterwards for the next algorithm using the workspace.
+ */
+static void check_ford_dantzig(graph_sp_workspace_t* ws) {
+	static const int negative[4][3] = {
+		{0, 1, 4}, {0, 2, 5}, {1, 3, 1}, {2, 1, -3},
+	};
+	static const graph_weight_t expected[4] = {0, 2, 5, 3};
+	static const int expected_father[4] = {-1, 2, 0, 1};
+	GRAPH_T* g = CREATE_GRAPH(4, TRUE);
+	assert(g != NULL);
+	for (unsigned i = 0; i < 4; i++)
+		GRAPH(set_edge)(g, negative[i][0], negative[i][1], TRUE,
+						(graph_weight_t)negative[i][2], FALSE);
+	for (unsigned k = 0; k < 3; k++) {
+		assert(GRAPH(ford_dantzig_ws)(g, 0, distance, father, &cycle, ws) ==
+			   4);
+		for (unsigned v = 0; v < 4; v++) {
+			assert(distance[v] == expected[v]);
+			assert(father[v] == expected_father[v]);
+		}
+		assert(GRAPH(bfs_ws)(g, 0, values, father, ws) == 4);
+	}
+	FREE_GRAPH(g);
+}
+
+int main(void) {
+	GRAPH_T* g = CREATE_GRAPH(NODE_COUNT, TRUE);
+	graph_sp_workspace_t* ws = create_graph_sp_workspace(NODE_COUNT);
+	assert(g != NULL && ws != NULL);
+	for (unsigned i = 0; i < EDGE_COUNT; i++) {
+		GRAPH(set_edge)(g, edges[i][0], edges[i][1], TRUE, edges[i][2], FALSE);
+		weight[edges[i][0]][edges[i][1]] = edges[i][2];
+	}
+	check_wrappers(g);
+	check_all_roots(g, ws, expected_dag, TRUE);
+	check_ford_dantzig(ws);
+
+	// The marks should be cleared when the stamp wraps around
+	ws->stamp = UINT_MAX - 6;
+	check_all_roots(g, ws, expected_dag, TRUE);
+	check_all_roots(g, ws, expected_dag, TRUE);
+	ws->stamp = UINT_MAX - 6;
+	check_ford_dantzig(ws);
+
+	const unsigned* cycle = edges[EDGE_COUNT];
+	GRAPH(set_edge)(g, cycle[0], cycle[1], TRUE, cycle[2], FALSE);
+	weight[cycle[0]][cycle[1]] = cycle[2];
+	check_all_roots(g, ws, expected_cyclic, FALSE);
+
+	free_graph_sp_workspace(ws);
+	FREE_GRAPH(g);
+	return 0;
+}
@@ -0,0 +1,53 @@
+#include <assert.h>
+#include <prng.h>
+#include "errors.h"
+#include "heap_view.h"
+
+#define HEAP_SIZE 1000
+#define CAPACITY (2 * HEAP_SIZE + 10)
+
+DEFINE_COMPARE_SCALAR(int)
+
+int data[CAPACITY];
+int batch[HEAP_SIZE];
+
+static void check_heap(heap_view_t* heap) {
+	for (unsigned pos = 1; pos < heap->size; pos++) {
+		assert(data[heap->pos_to_idx[(pos - 1) / 2]] >=
+			   data[heap->pos_to_idx[pos]]);
+	}
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 11);
+	for (unsigned i = 0; i < HEAP_SIZE; i++) {
+		data[i] = prng_bounded(&rng, 500);
+		batch[i] = prng_bounded(&rng, 500);
+	}
+	heap_view_t* heap = create_heap_heapify(CAPACITY, HEAP_SIZE, sizeof(int),
+											data, compare_int);
+	assert(heap != NULL);
+	assert(heap->size == HEAP_SIZE);
+	check_heap(heap);
+
+	// As many elements as the heap: rebuilt bottom-up
+	assert(heap_insert_many(heap, batch, HEAP_SIZE) == 2 * HEAP_SIZE);
+	check_heap(heap);
+	// Fewer elements: inserted one by one
+	assert(heap_insert_many(heap, batch, 10) == CAPACITY);
+	check_heap(heap);
+	for (unsigned i = 0; i < 10; i++)
+		assert(data[2 * HEAP_SIZE + i] == batch[i]);
+
+	int root, previous = -1;
+	unsigned count = 0;
+	while ((root = heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		assert(previous < 0 || data[root] <= data[previous]);
+		previous = root;
+		count++;
+	}
+	assert(count == CAPACITY);
+	free_heap(heap);
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <assert.h>
+#include <prng.h>
+#include "heap_view.h"
+
+#define ARRAY_SIZE 1000
+#define K 50
+
+DEFINE_COMPARE_SCALAR(int)
+
+typedef struct {
+	int key;
+	char padding[100];
+} big_t;
+
+static int compare_big(void* a, void* b) {
+	return compare_int(&((big_t*)a)->key, &((big_t*)b)->key);
+}
+
+int data[ARRAY_SIZE];
+int copy[ARRAY_SIZE];
+big_t big[ARRAY_SIZE];
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 9);
+	for (unsigned i = 0; i < ARRAY_SIZE; i++) {
+		data[i] = copy[i] = prng_bounded(&rng, 300);
+		big[i].key = data[i];
+		big[i].padding[99] = (char)data[i];
+	}
+
+	heap_sort(data, ARRAY_SIZE, sizeof(int), compare_int);
+	for (unsigned i = 1; i < ARRAY_SIZE; i++)
+		assert(data[i - 1] <= data[i]);
+
+	// Elements bigger than the swap buffer
+	heap_sort(big, ARRAY_SIZE, sizeof(big_t), compare_big);
+	for (unsigned i = 0; i < ARRAY_SIZE; i++) {
+		assert(big[i].key == data[i]);
+		assert(big[i].padding[99] == (char)data[i]);
+	}
+
+	partial_sort(copy, ARRAY_SIZE, K, sizeof(int), compare_int);
+	for (unsigned i = 0; i < K; i++)
+		assert(copy[i] == data[i]);
+	unsigned sum = 0, expected_sum = 0;
+	for (unsigned i = 0; i < ARRAY_SIZE; i++) {
+		sum += copy[i];
+		expected_sum += data[i];
+	}
+	assert(sum == expected_sum);
+
+	heap_sort(data, 0, sizeof(int), compare_int);
+	partial_sort(data, 1, 0, sizeof(int), compare_int);
+	return 0;
+}
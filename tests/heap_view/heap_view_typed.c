@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <prng.h>
+#include "errors.h"
+#include "heap_view.h"
+
+#define HEAP_SIZE 500
+#define OPERATION_COUNT 20000
+
+DEFINE_COMPARE_SCALAR(int)
+DEFINE_HEAP_VIEW(int_heap, int, a > b)
+
+int data[HEAP_SIZE];
+int typed_data[HEAP_SIZE];
+
+/*
+ * Both heaps break the ties the same way, so their indexes stay identical
+ */
+static void check_same(const heap_view_t* heap, const heap_view_t* typed) {
+	assert(heap->size == typed->size);
+	for (unsigned pos = 0; pos < heap->size; pos++)
+		assert(heap->pos_to_idx[pos] == typed->pos_to_idx[pos]);
+	assert(heap_peek(heap) == int_heap_peek(typed));
+}
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 7);
+	// Few distinct values to have ties
+	for (unsigned i = 0; i < HEAP_SIZE; i++)
+		data[i] = typed_data[i] = prng_bounded(&rng, 20);
+	heap_view_t* heap = create_heap_heapify(HEAP_SIZE, HEAP_SIZE / 2,
+											sizeof(int), data, compare_int);
+	heap_view_t* typed = create_heap(HEAP_SIZE, sizeof(int), typed_data, NULL);
+	assert(heap != NULL && typed != NULL);
+	typed->size = HEAP_SIZE / 2;
+	int_heap_heapify(typed);
+	check_same(heap, typed);
+
+	for (unsigned i = 0; i < OPERATION_COUNT; i++) {
+		const unsigned idx = prng_bounded(&rng, HEAP_SIZE);
+		int value = prng_bounded(&rng, 20);
+		switch (prng_bounded(&rng, 7)) {
+			case 0:
+				assert(int_heap_get_root(typed) == heap_get_root(heap));
+				break;
+			case 1:
+				if (heap->size == HEAP_SIZE)
+					break;
+				assert(int_heap_insert(typed, value) ==
+					   insert_heap(heap, &value));
+				break;
+			case 2: {
+				int values[3] = {value, value + 1, value - 1};
+				const unsigned count = heap->size < HEAP_SIZE - 3 ? 3 : 0;
+				assert(int_heap_insert_many(typed, values, count) ==
+					   heap_insert_many(heap, values, count));
+				break;
+			}
+			case 3:
+				if (!heap_contains(heap, idx))
+					break;
+				value = data[idx] + (int)prng_bounded(&rng, 3);
+				heap_update_up(heap, idx, &value);
+				int_heap_update_up(typed, idx, value);
+				break;
+			case 4:
+				if (!heap_contains(heap, idx))
+					break;
+				value = data[idx] - (int)prng_bounded(&rng, 3);
+				heap_update_down(heap, idx, &value);
+				int_heap_update_down(typed, idx, value);
+				break;
+			case 5:
+				if (!heap_contains(heap, idx))
+					break;
+				heap_update(heap, idx, &value);
+				int_heap_update(typed, idx, value);
+				break;
+			default:
+				if (!heap_contains(heap, idx))
+					break;
+				assert(int_heap_remove(typed, idx) == heap_remove(heap, idx));
+				break;
+		}
+		check_same(heap, typed);
+	}
+	int root;
+	while ((root = heap_get_root(heap)) != -ERROR_IS_EMPTY)
+		assert(int_heap_get_root(typed) == root);
+	assert(int_heap_get_root(typed) == -ERROR_IS_EMPTY);
+	assert(int_heap_peek(typed) == -ERROR_IS_EMPTY);
+	assert(int_heap_remove(typed, 0) == -ERROR_INVALID_PARAM2);
+	free_heap(heap);
+	free_heap(typed);
+	return 0;
+}
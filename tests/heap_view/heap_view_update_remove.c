@@ -0,0 +1,74 @@
+#include <assert.h>
+#include <prng.h>
+#include "errors.h"
+#include "heap_view.h"
+
+#define HEAP_SIZE 100
+#define OPERATION_COUNT 20000
+
+DEFINE_COMPARE_SCALAR(int)
+
+int data[HEAP_SIZE];
+
+static int brute_force_max(heap_view_t* heap) {
+	int max = -1;
+	for (unsigned i = 0; i < HEAP_SIZE; i++) {
+		if (heap_contains(heap, i) && (max < 0 || data[i] > data[max]))
+			max = i;
+	}
+	return max;
+}
+
+int main(void) {
+	heap_view_t* heap = create_heap(HEAP_SIZE, sizeof(int), data, compare_int);
+	assert(heap != NULL);
+	assert(heap_peek(heap) == -ERROR_IS_EMPTY);
+	assert(!heap_contains(heap, HEAP_SIZE));
+	prng_t rng;
+	prng_seed(&rng, 3);
+	for (unsigned i = 0; i < OPERATION_COUNT; i++) {
+		const unsigned idx = prng_bounded(&rng, HEAP_SIZE);
+		int value = prng_bounded(&rng, 1000);
+		switch (prng_bounded(&rng, 5)) {
+			case 0:
+				if (heap->size < HEAP_SIZE) {
+					const unsigned free_idx = heap->pos_to_idx[heap->size];
+					assert(insert_heap(heap, &value) == (int)heap->size);
+					assert(heap_contains(heap, free_idx));
+					assert(data[free_idx] == value);
+				}
+				break;
+			case 1:
+				if (heap_contains(heap, idx)) {
+					assert(heap_remove(heap, idx) == (int)idx);
+					assert(!heap_contains(heap, idx));
+				}
+				break;
+			case 2:
+				if (heap_contains(heap, idx) && value > data[idx])
+					heap_update_up(heap, idx, &value);
+				break;
+			case 3:
+				if (heap_contains(heap, idx) && value < data[idx])
+					heap_update_down(heap, idx, &value);
+				break;
+			default:
+				if (heap_contains(heap, idx))
+					heap_update(heap, idx, &value);
+				break;
+		}
+		const int max = brute_force_max(heap);
+		const int peek = heap_peek(heap);
+		if (max < 0)
+			assert(peek == -ERROR_IS_EMPTY);
+		else
+			assert(data[peek] == data[max]);
+	}
+	int root, previous = -1;
+	while ((root = heap_get_root(heap)) != -ERROR_IS_EMPTY) {
+		assert(previous < 0 || data[root] <= data[previous]);
+		previous = root;
+	}
+	free_heap(heap);
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "minmax_heap.h"
+
+#define HEAP_SIZE 300
+#define OPERATION_COUNT 30000
+
+DEFINE_COMPARE_SCALAR(int)
+
+int data[HEAP_SIZE];
+
+// Checks the extremes of the heap against a scan of the indexes in the heap
+static void check(minmax_heap_t* heap) {
+	int min = -1, max = -1;
+	for (unsigned i = 0; i < HEAP_SIZE; i++) {
+		if (!minmax_heap_contains(heap, i))
+			continue;
+		if (min < 0 || data[i] < data[min])
+			min = i;
+		if (max < 0 || data[i] > data[max])
+			max = i;
+	}
+	if (min < 0) {
+		assert(minmax_heap_peek_min(heap) == -ERROR_IS_EMPTY);
+		assert(minmax_heap_peek_max(heap) == -ERROR_IS_EMPTY);
+		return;
+	}
+	assert(data[minmax_heap_peek_min(heap)] == data[min]);
+	assert(data[minmax_heap_peek_max(heap)] == data[max]);
+}
+
+int main(void) {
+	minmax_heap_t* heap =
+		create_minmax_heap(HEAP_SIZE, sizeof(int), data, compare_int);
+	assert(heap != NULL);
+	prng_t rng;
+	prng_seed(&rng, 6);
+	for (unsigned op = 0; op < OPERATION_COUNT; op++) {
+		int value = prng_bounded(&rng, 1000);
+		const unsigned idx = prng_bounded(&rng, HEAP_SIZE);
+		int removed;
+		switch (prng_bounded(&rng, 5)) {
+			case 0:
+			case 1:
+				if (heap->size < HEAP_SIZE) {
+					const int i = minmax_heap_insert(heap, &value);
+					assert(i >= 0 && data[i] == value);
+					assert(minmax_heap_contains(heap, i));
+				}
+				break;
+			case 2:
+				removed = minmax_heap_pop_min(heap);
+				assert(removed == -ERROR_IS_EMPTY ||
+					   !minmax_heap_contains(heap, removed));
+				break;
+			case 3:
+				removed = minmax_heap_pop_max(heap);
+				assert(removed == -ERROR_IS_EMPTY ||
+					   !minmax_heap_contains(heap, removed));
+				break;
+			default:
+				if (minmax_heap_contains(heap, idx)) {
+					assert(minmax_heap_remove(heap, idx) == (int)idx);
+					assert(!minmax_heap_contains(heap, idx));
+				}
+				break;
+		}
+		check(heap);
+	}
+
+	// Alternates the two ends until the heap is empty
+	int low = -1, high = 1000;
+	for (BOOL min = TRUE; heap->size > 0; min = !min) {
+		const int i =
+			min ? minmax_heap_pop_min(heap) : minmax_heap_pop_max(heap);
+		if (min) {
+			assert(data[i] >= low);
+			low = data[i];
+		} else {
+			assert(data[i] <= high);
+			high = data[i];
+		}
+		assert(low <= high);
+	}
+	free_minmax_heap(heap);
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <assert.h>
+#include <multiqueue.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "errors.h"
+
+#define THREAD_COUNT 4
+#define VALUE_COUNT 20000
+
+multiqueue_t* mq;
+int popped[THREAD_COUNT * VALUE_COUNT];
+
+/**
+ * Each thread pushes its own values and pops as many values, which may come
+ * from the other threads
+ */
+static void* worker(void* arg) {
+	const unsigned id = *(unsigned*)arg;
+	prng_t rng;
+	prng_seed(&rng, id + 1);
+	for (unsigned i = 0; i < VALUE_COUNT; i++) {
+		const unsigned value = id * VALUE_COUNT + i;
+		assert(multiqueue_push(mq, &rng, prng_bounded(&rng, 100000), value) ==
+			   -ERROR_NO_ERROR);
+		if (i % 2 == 1) {
+			for (unsigned j = 0; j < 2; j++) {
+				int v;
+				// A value pushed by this thread is left at least
+				while ((v = multiqueue_pop(mq, &rng, NULL)) < 0)
+					;
+				__atomic_add_fetch(&popped[v], 1, __ATOMIC_RELAXED);
+			}
+		}
+	}
+	return NULL;
+}
+
+int main(void) {
+	mq = create_multiqueue(THREAD_COUNT, 2);
+	assert(mq != NULL);
+	pthread_t threads[THREAD_COUNT];
+	unsigned ids[THREAD_COUNT];
+	for (unsigned t = 0; t < THREAD_COUNT; t++) {
+		ids[t] = t;
+		assert(pthread_create(&threads[t], NULL, worker, &ids[t]) == 0);
+	}
+	for (unsigned t = 0; t < THREAD_COUNT; t++)
+		pthread_join(threads[t], NULL);
+
+	prng_t rng;
+	prng_seed(&rng, 0);
+	assert(multiqueue_pop(mq, &rng, NULL) == -ERROR_IS_EMPTY);
+	for (unsigned v = 0; v < THREAD_COUNT * VALUE_COUNT; v++)
+		assert(popped[v] == 1);
+	free_multiqueue(mq);
+	return 0;
+}
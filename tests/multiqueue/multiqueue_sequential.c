@@ -0,0 +1,29 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "multiqueue.h"
+
+#define VALUE_COUNT 5000
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 8);
+	// A single heap is an exact priority queue
+	multiqueue_t* mq = create_multiqueue(1, 1);
+	assert(mq != NULL);
+	assert(multiqueue_pop(mq, &rng, NULL) == -ERROR_IS_EMPTY);
+	for (unsigned i = 0; i < VALUE_COUNT; i++) {
+		assert(multiqueue_push(mq, &rng, prng_bounded(&rng, 1000), i) ==
+			   -ERROR_NO_ERROR);
+	}
+	graph_weight_t key, previous = 0;
+	for (unsigned i = 0; i < VALUE_COUNT; i++) {
+		assert(multiqueue_pop(mq, &rng, &key) >= 0);
+		assert(key >= previous);
+		previous = key;
+	}
+	assert(multiqueue_pop(mq, &rng, NULL) == -ERROR_IS_EMPTY);
+	free_multiqueue(mq);
+	return 0;
+}
@@ -0,0 +1,44 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "pairing_heap.h"
+
+#define SHARD_COUNT 8
+#define SHARD_SIZE 300
+
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 4);
+	pairing_pool_t* pool = create_pairing_pool(64);
+	assert(pool != NULL);
+	pairing_heap_t shards[SHARD_COUNT];
+	for (unsigned s = 0; s < SHARD_COUNT; s++) {
+		pairing_heap_init(&shards[s], pool);
+		for (unsigned i = 0; i < SHARD_SIZE; i++) {
+			const graph_weight_t k = prng_bounded(&rng, 10000);
+			assert(pairing_heap_insert(&shards[s], k, s) != NULL);
+		}
+		// Decreases a key of the shard below all the others
+		pairing_node_t* node = pairing_heap_insert(&shards[s], 20000, s);
+		pairing_heap_decrease_key(&shards[s], node, 0);
+	}
+	for (unsigned s = 1; s < SHARD_COUNT; s++) {
+		pairing_heap_meld(&shards[0], &shards[s]);
+		assert(pairing_heap_empty(&shards[s]) && shards[s].size == 0);
+	}
+	pairing_heap_meld(&shards[0], &shards[1]);
+	assert(shards[0].size == SHARD_COUNT * (SHARD_SIZE + 1));
+
+	graph_weight_t k, previous = 0;
+	unsigned count = 0;
+	while (pairing_heap_pop(&shards[0], &k) != -ERROR_IS_EMPTY) {
+		assert(k >= previous);
+		assert(count >= SHARD_COUNT || k == 0);
+		previous = k;
+		count++;
+	}
+	assert(count == SHARD_COUNT * (SHARD_SIZE + 1));
+	free_pairing_pool(pool);
+	return 0;
+}
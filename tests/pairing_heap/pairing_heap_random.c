@@ -0,0 +1,61 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "pairing_heap.h"
+
+#define CAPACITY 200
+#define OPERATION_COUNT 20000
+
+graph_weight_t key[CAPACITY];
+pairing_node_t* node[CAPACITY];
+
+// Compares the heap with an array of keys on random inserts, decrease-keys
+// and pops
+int main(void) {
+	prng_t rng;
+	prng_seed(&rng, 21);
+	// Small chunks to allocate several of them
+	pairing_pool_t* pool = create_pairing_pool(16);
+	assert(pool != NULL);
+	pairing_heap_t heap;
+	pairing_heap_init(&heap, pool);
+	unsigned size = 0;
+
+	for (unsigned op = 0; op < OPERATION_COUNT; op++) {
+		if (prng_bounded(&rng, 3) != 0) {
+			const unsigned v = prng_bounded(&rng, CAPACITY);
+			const graph_weight_t k = prng_bounded(&rng, 1000);
+			if (node[v] == NULL) {
+				node[v] = pairing_heap_insert(&heap, k, v);
+				assert(node[v] != NULL);
+				key[v] = k;
+				size++;
+			} else if (k < key[v]) {
+				pairing_heap_decrease_key(&heap, node[v], k);
+				key[v] = k;
+			}
+			assert(heap.size == size);
+			continue;
+		}
+		graph_weight_t min = GRAPH_WEIGHT_INF;
+		for (unsigned v = 0; v < CAPACITY; v++) {
+			if (node[v] != NULL && key[v] < min)
+				min = key[v];
+		}
+		graph_weight_t k;
+		const int v = pairing_heap_pop(&heap, &k);
+		if (min == GRAPH_WEIGHT_INF) {
+			assert(v == -ERROR_IS_EMPTY && pairing_heap_empty(&heap));
+			continue;
+		}
+		assert(v >= 0 && node[v] != NULL && key[v] == min && k == min);
+		node[v] = NULL;
+		size--;
+	}
+
+	pairing_heap_clear(&heap);
+	assert(pairing_heap_empty(&heap) && heap.size == 0);
+	free_pairing_pool(pool);
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "priority_queue.h"
+
+#define OPERATION_COUNT 20000
+#define MAX_SIZE 5000
+
+DEFINE_COMPARE_MIN_SCALAR(int)
+
+int expected[MAX_SIZE];
+unsigned expected_size = 0;
+
+static int pop_expected(void) {
+	unsigned min = 0;
+	for (unsigned i = 1; i < expected_size; i++) {
+		if (expected[i] < expected[min])
+			min = i;
+	}
+	const int value = expected[min];
+	expected[min] = expected[--expected_size];
+	return value;
+}
+
+int main(void) {
+	priority_queue_t* pq = create_priority_queue(sizeof(int), compare_min_int);
+	assert(pq != NULL);
+	assert(priority_queue_peek(pq) == NULL);
+	assert(priority_queue_pop(pq, NULL) == -ERROR_IS_EMPTY);
+	prng_t rng;
+	prng_seed(&rng, 5);
+	int value, top;
+	for (unsigned i = 0; i < OPERATION_COUNT; i++) {
+		value = prng_bounded(&rng, 1000);
+		switch (prng_bounded(&rng, 4)) {
+			case 0:
+			case 1:
+				if (expected_size == MAX_SIZE)
+					break;
+				assert(priority_queue_push(pq, &value) == (int)++expected_size);
+				expected[expected_size - 1] = value;
+				break;
+			case 2:
+				if (expected_size == 0) {
+					assert(priority_queue_pop(pq, &top) == -ERROR_IS_EMPTY);
+					break;
+				}
+				assert(priority_queue_pop(pq, &top) == -ERROR_NO_ERROR);
+				assert(top == pop_expected());
+				break;
+			default:
+				if (expected_size == 0)
+					break;
+				assert(priority_queue_replace_top(pq, &value, &top) ==
+					   -ERROR_NO_ERROR);
+				assert(top == pop_expected());
+				expected[expected_size++] = value;
+				break;
+		}
+		assert(pq->size == expected_size);
+		assert(pq->capacity >= pq->size);
+		if (expected_size > 0) {
+			const int* peek = priority_queue_peek(pq);
+			unsigned min = 0;
+			for (unsigned j = 1; j < expected_size; j++) {
+				if (expected[j] < expected[min])
+					min = j;
+			}
+			assert(*peek == expected[min]);
+		}
+	}
+
+	assert(priority_queue_shrink(pq) == -ERROR_NO_ERROR);
+	assert(pq->capacity == pq->size);
+	assert(priority_queue_reserve(pq, 2 * MAX_SIZE) == -ERROR_NO_ERROR);
+	assert(pq->capacity == 2 * MAX_SIZE);
+	while (!priority_queue_empty(pq)) {
+		assert(priority_queue_pop(pq, &top) == -ERROR_NO_ERROR);
+		assert(top == pop_expected());
+	}
+	assert(expected_size == 0);
+	free_priority_queue(pq);
+	return 0;
+}
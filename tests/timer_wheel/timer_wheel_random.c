@@ -0,0 +1,95 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "errors.h"
+#include "timer_wheel.h"
+
+#define TIMER_COUNT 500
+#define STEP_COUNT 20000
+#define START ((uint64_t)1 << 32)
+
+typedef struct timer {
+	uint64_t expiry;
+	int id;
+	BOOL pending;
+} timer_t_;
+
+timer_t_ timers[TIMER_COUNT];
+
+typedef struct context {
+	timer_wheel_t* wheel;
+	uint64_t last;
+	unsigned count;
+} context_t;
+
+// Each expired timer is due, pending and not earlier than the previous one
+static void expire(const timer_wheel_expired_t* expired,
+				   unsigned count,
+				   void* ctx) {
+	context_t* c = ctx;
+	assert(count > 0 && count <= TIMER_WHEEL_BATCH);
+	for (unsigned i = 0; i < count; i++) {
+		timer_t_* t = expired[i].data;
+		assert(t->pending && t->id == (int)expired[i].id);
+		assert(t->expiry <= c->wheel->now && t->expiry >= c->last);
+		c->last = t->expiry;
+		t->pending = FALSE;
+	}
+	c->count += count;
+}
+
+// Random delays of every level of the wheel and beyond
+static uint64_t random_delay(prng_t* rng) {
+	switch (prng_bounded(rng, 5)) {
+	case 0:
+		return prng_bounded(rng, 4);
+	case 1:
+		return prng_bounded(rng, 300);
+	case 2:
+		return prng_bounded(rng, 100000);
+	case 3:
+		return prng_bounded(rng, 1u << 26);
+	default:
+		return ((uint64_t)1 << 32) + prng_bounded(rng, 1u << 20);
+	}
+}
+
+int main(void) {
+	timer_wheel_t* wheel = create_timer_wheel(TIMER_COUNT, START);
+	assert(wheel != NULL);
+	prng_t rng;
+	prng_seed(&rng, 8);
+	context_t ctx = {wheel, 0, 0};
+	for (unsigned step = 0; step < STEP_COUNT; step++) {
+		timer_t_* t = &timers[prng_bounded(&rng, TIMER_COUNT)];
+		if (t->pending && prng_bounded(&rng, 3) == 0) {
+			assert(timer_wheel_cancel(wheel, t->id) == -ERROR_NO_ERROR);
+			t->pending = FALSE;
+			assert(timer_wheel_cancel(wheel, t->id) == -ERROR_INVALID_PARAM2);
+		} else if (!t->pending) {
+			const uint64_t expiry = wheel->now + random_delay(&rng);
+			t->id = timer_wheel_schedule(wheel, expiry, t);
+			assert(t->id >= 0);
+			t->expiry = expiry > wheel->now ? expiry : wheel->now + 1;
+			t->pending = TRUE;
+		}
+		// Jumps far ahead from time to time to go through the higher levels
+		const uint64_t target = wheel->now + (prng_bounded(&rng, 50) == 0
+												  ? prng_bounded(&rng, 1u << 27)
+												  : prng_bounded(&rng, 200));
+		unsigned due = 0;
+		for (unsigned i = 0; i < TIMER_COUNT; i++)
+			due += timers[i].pending && timers[i].expiry <= target;
+		ctx.last = 0;
+		ctx.count = 0;
+		assert(timer_wheel_advance(wheel, target, expire, &ctx) == (int)due);
+		assert(ctx.count == due && wheel->now == target);
+		unsigned pending = 0;
+		for (unsigned i = 0; i < TIMER_COUNT; i++)
+			pending += timers[i].pending;
+		assert(wheel->nb_pending == pending);
+	}
+	free_timer_wheel(wheel);
+	return 0;
+}
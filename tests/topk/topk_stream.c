@@ -0,0 +1,42 @@
+#include <assert.h>
+#include <prng.h>
+#include <stdlib.h>
+#include "compare.h"
+#include "heap_view.h"
+#include "topk.h"
+
+#define K 20
+#define ITEM_COUNT 10000
+
+DEFINE_COMPARE_MIN_SCALAR(double)
+
+double keys[ITEM_COUNT];
+
+int main(void) {
+	topk_t* topk = create_topk(K);
+	assert(topk != NULL);
+	prng_t rng;
+	prng_seed(&rng, 13);
+	for (unsigned window = 0; window < 3; window++) {
+		// Few items in the first window, less than k
+		const unsigned count = window == 0 ? K / 2 : ITEM_COUNT;
+		for (unsigned i = 0; i < count; i++) {
+			keys[i] = prng_double(&rng) * 100.0;
+			const BOOL kept = topk_push(topk, keys[i], i);
+			assert(i >= K || kept);
+		}
+		topk_entry_t out[K];
+		const unsigned kept = topk_extract(topk, out);
+		assert(kept == (count < K ? count : K));
+		assert(topk->size == 0);
+
+		// The k greatest keys in decreasing order
+		partial_sort(keys, count, K, sizeof(double), compare_min_double);
+		for (unsigned i = 0; i < kept; i++) {
+			assert(out[i].key == keys[i]);
+			assert(i == 0 || out[i].key <= out[i - 1].key);
+		}
+	}
+	free_topk(topk);
+	return 0;
+}